@@ -0,0 +1,446 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "alloc_counter.hpp"
+#include "simulation.hpp"
+
+/**
+ * =============================
+ * snake_microbench Overview
+ * =============================
+ * Microbenchmarks for the individual game-logic hot paths, complementing the
+ * whole-game throughput numbers of snake_bench. Every case runs on several board
+ * sizes and reports nanoseconds per operation, so a change to SnakeBody,
+ * OccupancyGrid or the collision code can be judged case by case.
+ *
+ * Usage:
+ *   snake_microbench [--boards 10,25,50,100] [--min-time MS] [--repeat N]
+ *                    [--filter TEXT] [--csv FILE]
+ *
+ * Each case is calibrated until one run takes at least --min-time milliseconds,
+ * then timed --repeat times; the table shows the fastest and the median run.
+ * --filter keeps only cases whose name contains TEXT. --csv writes one row per
+ * case: benchmark,board,case,ns_min,ns_median,iterations,allocs_per_op.
+ *
+ * Cases:
+ *   - element_in_deque     : ElementInDeque over a half-board body (SnakeBody and std::deque)
+ *   - generate_random_pos  : Food::GenerateRandomPos at 10% .. 99% of the board covered
+ *   - snake_update         : Snake::Update at length 3 (no growth) and growing every tick
+ *   - tail_collision       : the occupancy lookup the game uses and the ElementInDeque scan
+ *                            it replaced, at lengths 3 .. board²-1
+ *   - simulation_step      : one full tick (Simulation::Step, what Game::Update runs),
+ *                            including round restarts, under a simple safe-move bot
+ *
+ * The snake is moved along a Hamiltonian cycle of the largest even-sized square
+ * that fits the board, so it can run forever without leaving the board or biting
+ * itself, at any length.
+ */
+
+struct BenchResult
+{
+    std::string benchmark;
+    int board;
+    std::string label;
+    double minNs;
+    double medianNs;
+    long long iterations;
+    double allocsPerOp;
+};
+
+static volatile long long sink = 0; // keeps results observable so loops are not optimised out
+
+/*
+ * Cycle
+ * Objective: visit every cell of an m x m square (m even) once and return to the start.
+ * Return value: std::vector<Cell> - cells in walking order; the last is adjacent to the first
+ *
+ * Approach: row 0 left to right, then a row serpentine over columns 1..m-1 of the
+ * remaining rows, ending next to column 0, which leads straight back up to (0,0).
+ */
+static std::vector<Cell> Cycle(int boardSize)
+{
+    int m = boardSize & ~1; // odd boards have no Hamiltonian cycle; use the even square inside
+    std::vector<Cell> cells;
+    cells.reserve(m * m);
+    for (int x = 0; x < m; x++)
+        cells.push_back(Cell{(int16_t)x, 0});
+    for (int y = 1; y < m; y++)
+    {
+        for (int i = 1; i < m; i++)
+        {
+            int x = (y % 2 == 1) ? m - i : i;
+            cells.push_back(Cell{(int16_t)x, (int16_t)y});
+        }
+    }
+    for (int y = m - 1; y >= 1; y--)
+        cells.push_back(Cell{0, (int16_t)y});
+    return cells;
+}
+
+/*
+ * PlaceOnCycle
+ * Objective: lay a snake of `length` segments along the cycle, head at cycle[head].
+ * Side effects: rebuilds body and occupancy; points direction at the next cycle cell
+ */
+static void PlaceOnCycle(Snake &snake, const std::vector<Cell> &cycle, int length, int head)
+{
+    const int n = (int)cycle.size();
+    snake.body.clear();
+    snake.occupancy.Clear();
+    for (int i = length - 1; i >= 0; i--)
+    {
+        Cell cell = cycle[((head - i) % n + n) % n];
+        snake.body.push_front(cell);
+        snake.occupancy.Set(cell, true);
+    }
+    Cell next = cycle[(head + 1) % n];
+    snake.direction = Cell{(int16_t)(next.x - cycle[head].x), (int16_t)(next.y - cycle[head].y)};
+    snake.addSegment = false;
+    snake.hitTail = false;
+}
+
+/*
+ * RandomCells
+ * Objective: fixed pseudo-random query cells on the board, so lookups do not all hit one line.
+ */
+static std::vector<Cell> RandomCells(int boardSize, int count)
+{
+    SimRandom rng(12345);
+    std::vector<Cell> cells(count);
+    for (Cell &cell : cells)
+        cell = Cell{(int16_t)RandomInt(rng, 0, boardSize - 1), (int16_t)RandomInt(rng, 0, boardSize - 1)};
+    return cells;
+}
+
+/*
+ * Measure
+ * Objective: time `run(iterations)` and turn it into nanoseconds per iteration.
+ * Input: run - callable performing the given number of operations and returning a checksum
+ * Return value: BenchResult - min and median over `repeat` timed runs
+ *
+ * Approach: double the iteration count until one run lasts minTimeMs (calibration
+ * also warms caches and the branch predictor), then time `repeat` runs of that size.
+ */
+template <typename Run>
+static BenchResult Measure(const char *benchmark, int board, const std::string &label, double minTimeMs, int repeat,
+                           Run run)
+{
+    using Clock = std::chrono::steady_clock;
+    long long iterations = 1;
+    for (;;)
+    {
+        Clock::time_point start = Clock::now();
+        sink = sink + run(iterations);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (ms >= minTimeMs || iterations >= (1LL << 40))
+            break;
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    size_t allocations = 0;
+    for (int r = 0; r < repeat; r++)
+    {
+        size_t allocationsBefore = AllocationCount();
+        Clock::time_point start = Clock::now();
+        sink = sink + run(iterations);
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        allocations += AllocationCount() - allocationsBefore;
+        samples.push_back(ns / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+    return BenchResult{benchmark, board, label, samples.front(), samples[samples.size() / 2], iterations,
+                       (double)allocations / ((double)iterations * repeat)};
+}
+
+/*
+ * BenchElementInDeque
+ * Objective: cost of the linear membership scan on both container types it supports.
+ */
+static void BenchElementInDeque(std::vector<BenchResult> &results, int boardSize, double minTimeMs, int repeat)
+{
+    const std::vector<Cell> cycle = Cycle(boardSize);
+    const std::vector<Cell> queries = RandomCells(boardSize, 1024);
+    const int length = std::max(3, (int)cycle.size() / 2);
+
+    Snake snake(boardSize);
+    PlaceOnCycle(snake, cycle, length, length - 1);
+    std::deque<Cell> deque;
+    for (unsigned int i = 0; i < snake.body.size(); i++)
+        deque.push_back(snake.body[i]);
+
+    std::string label = "len=" + std::to_string(length);
+    results.push_back(Measure("element_in_deque", boardSize, "snake_body " + label, minTimeMs, repeat,
+                              [&](long long iterations)
+    {
+        long long hits = 0;
+        for (long long i = 0; i < iterations; i++)
+            hits += ElementInDeque(queries[i & 1023], snake.body);
+        return hits;
+    }));
+    results.push_back(Measure("element_in_deque", boardSize, "std::deque " + label, minTimeMs, repeat,
+                              [&](long long iterations)
+    {
+        long long hits = 0;
+        for (long long i = 0; i < iterations; i++)
+            hits += ElementInDeque(queries[i & 1023], deque);
+        return hits;
+    }));
+}
+
+/*
+ * BenchGenerateRandomPos
+ * Objective: free-cell picking cost as the board fills up.
+ */
+static void BenchGenerateRandomPos(std::vector<BenchResult> &results, int boardSize, double minTimeMs, int repeat)
+{
+    const std::vector<Cell> cycle = Cycle(boardSize);
+    const int fills[] = {10, 25, 50, 75, 90, 99};
+    for (int fill : fills)
+    {
+        int length = std::max(3, boardSize * boardSize * fill / 100);
+        length = std::min(length, (int)cycle.size() - 1);
+        Snake snake(boardSize);
+        PlaceOnCycle(snake, cycle, length, length - 1);
+        SimRandom rng(7);
+        Food food(snake, rng);
+
+        results.push_back(Measure("generate_random_pos", boardSize, "fill=" + std::to_string(fill) + "%",
+                                  minTimeMs, repeat, [&](long long iterations)
+        {
+            long long sum = 0;
+            Cell pos = {0, 0};
+            for (long long i = 0; i < iterations; i++)
+            {
+                food.GenerateRandomPos(snake, rng, pos);
+                sum += pos.x + pos.y;
+            }
+            return sum;
+        }));
+    }
+}
+
+/*
+ * BenchSnakeUpdate
+ * Objective: one movement step, keeping the length and growing on every step.
+ *
+ * Approach: the head walks the cycle; the growing snake is laid back down at length
+ * 3 once it covers the cycle, which costs one O(board²) rebuild per board² steps.
+ */
+static void BenchSnakeUpdate(std::vector<BenchResult> &results, int boardSize, double minTimeMs, int repeat)
+{
+    const std::vector<Cell> cycle = Cycle(boardSize);
+    const int n = (int)cycle.size();
+
+    for (int grow = 0; grow < 2; grow++)
+    {
+        Snake snake(boardSize);
+        int head = 2;
+        PlaceOnCycle(snake, cycle, 3, head);
+        results.push_back(Measure("snake_update", boardSize, grow ? "growing" : "len=3", minTimeMs, repeat,
+                                  [&](long long iterations)
+        {
+            long long sum = 0;
+            for (long long i = 0; i < iterations; i++)
+            {
+                if (grow && (int)snake.body.size() >= n - 1)
+                {
+                    head = 2;
+                    PlaceOnCycle(snake, cycle, 3, head);
+                }
+                Cell next = cycle[(head + 1) % n];
+                snake.direction = Cell{(int16_t)(next.x - cycle[head].x), (int16_t)(next.y - cycle[head].y)};
+                snake.addSegment = grow != 0;
+                snake.Update();
+                head = (head + 1) % n;
+                sum += snake.hitTail;
+            }
+            return sum + snake.body[0].x;
+        }));
+    }
+}
+
+/*
+ * BenchTailCollision
+ * Objective: "is this cell on the body?" at growing lengths, through the occupancy
+ *            grid (what Snake::Update does) and with the ElementInDeque scan it replaced.
+ */
+static void BenchTailCollision(std::vector<BenchResult> &results, int boardSize, double minTimeMs, int repeat)
+{
+    const std::vector<Cell> cycle = Cycle(boardSize);
+    const std::vector<Cell> queries = RandomCells(boardSize, 1024);
+    const int cells = boardSize * boardSize;
+    const int lengths[] = {3, cells / 10, cells / 2, cells - 1};
+    for (int wanted : lengths)
+    {
+        int length = std::min(std::max(3, wanted), (int)cycle.size());
+        Snake snake(boardSize);
+        PlaceOnCycle(snake, cycle, length, length - 1);
+        std::string label = "len=" + std::to_string(length);
+
+        results.push_back(Measure("tail_collision", boardSize, "grid " + label, minTimeMs, repeat,
+                                  [&](long long iterations)
+        {
+            long long hits = 0;
+            for (long long i = 0; i < iterations; i++)
+                hits += snake.IsOccupied(queries[i & 1023]);
+            return hits;
+        }));
+        results.push_back(Measure("tail_collision", boardSize, "scan " + label, minTimeMs, repeat,
+                                  [&](long long iterations)
+        {
+            long long hits = 0;
+            for (long long i = 0; i < iterations; i++)
+                hits += ElementInDeque(queries[i & 1023], snake.body, true);
+            return hits;
+        }));
+    }
+}
+
+/*
+ * SafeDirection
+ * Objective: keep the heading unless it dies next tick, else take the first safe turn.
+ */
+static Cell SafeDirection(const Simulation &sim)
+{
+    static const Cell directions[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+    const Snake &snake = sim.snake;
+    Cell options[5] = {snake.direction, directions[0], directions[1], directions[2], directions[3]};
+    for (Cell option : options)
+    {
+        Cell next = snake.body[0] + option;
+        if (option.x == -snake.direction.x && option.y == -snake.direction.y)
+            continue; // reversal
+        if (snake.occupancy.InBounds(next) && (!snake.IsOccupied(next) || (next == snake.body.back() && !snake.addSegment)))
+            return option;
+    }
+    return snake.direction; // boxed in: the round ends
+}
+
+/*
+ * BenchSimulationStep
+ * Objective: a complete tick (move, eat, respawn, collisions, round reset) as the game runs it.
+ */
+static void BenchSimulationStep(std::vector<BenchResult> &results, int boardSize, double minTimeMs, int repeat)
+{
+    Simulation sim(boardSize, 42);
+    results.push_back(Measure("simulation_step", boardSize, "safe bot", minTimeMs, repeat, [&](long long iterations)
+    {
+        long long rounds = 0;
+        for (long long i = 0; i < iterations; i++)
+            rounds += sim.Step(SafeDirection(sim)).RoundOver();
+        return rounds + sim.score;
+    }));
+}
+
+/*
+ * ParseBoards
+ * Objective: turn "10,25,50" into board sizes, ignoring entries below 4.
+ */
+static std::vector<int> ParseBoards(const char *list)
+{
+    std::vector<int> boards;
+    for (const char *p = list; *p;)
+    {
+        int size = atoi(p);
+        if (size >= 4)
+            boards.push_back(size);
+        const char *comma = strchr(p, ',');
+        if (!comma)
+            break;
+        p = comma + 1;
+    }
+    return boards;
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<int> boards = {10, 25, 50, 100};
+    double minTimeMs = 20;
+    int repeat = 5;
+    const char *filter = nullptr;
+    const char *csvPath = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--boards") && i + 1 < argc)
+            boards = ParseBoards(argv[++i]);
+        else if (!strcmp(argv[i], "--min-time") && i + 1 < argc)
+            minTimeMs = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--repeat") && i + 1 < argc)
+            repeat = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+            filter = argv[++i];
+        else if (!strcmp(argv[i], "--csv") && i + 1 < argc)
+            csvPath = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--boards 10,25,50,100] [--min-time MS] [--repeat N] [--filter TEXT] [--csv FILE]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (boards.empty() || repeat < 1)
+    {
+        fprintf(stderr, "snake_microbench: need at least one board of size >= 4 and --repeat >= 1\n");
+        return 1;
+    }
+
+    typedef void (*BenchFunction)(std::vector<BenchResult> &, int, double, int);
+    struct Case
+    {
+        const char *name;
+        BenchFunction run;
+    };
+    const Case cases[] = {
+        {"element_in_deque", BenchElementInDeque},
+        {"generate_random_pos", BenchGenerateRandomPos},
+        {"snake_update", BenchSnakeUpdate},
+        {"tail_collision", BenchTailCollision},
+        {"simulation_step", BenchSimulationStep},
+    };
+
+    std::vector<BenchResult> results;
+    printf("%-20s %6s  %-24s %12s %12s %10s\n", "benchmark", "board", "case", "ns/op min", "ns/op med", "allocs/op");
+    for (const Case &c : cases)
+    {
+        if (filter && !strstr(c.name, filter))
+            continue;
+        for (int board : boards)
+        {
+            size_t first = results.size();
+            c.run(results, board, minTimeMs, repeat);
+            for (size_t i = first; i < results.size(); i++)
+            {
+                const BenchResult &r = results[i];
+                printf("%-20s %6d  %-24s %12.2f %12.2f %10.3f\n", r.benchmark.c_str(), r.board, r.label.c_str(),
+                       r.minNs, r.medianNs, r.allocsPerOp);
+            }
+        }
+    }
+    if (!AllocationCountingEnabled())
+        printf("(allocation counting not compiled in; allocs/op reads 0)\n");
+
+    if (csvPath)
+    {
+        FILE *file = fopen(csvPath, "w");
+        if (!file)
+        {
+            fprintf(stderr, "snake_microbench: cannot write %s\n", csvPath);
+            return 1;
+        }
+        fprintf(file, "benchmark,board,case,ns_min,ns_median,iterations,allocs_per_op\n");
+        for (const BenchResult &r : results)
+            fprintf(file, "%s,%d,%s,%.3f,%.3f,%lld,%.4f\n", r.benchmark.c_str(), r.board, r.label.c_str(), r.minNs,
+                    r.medianNs, r.iterations, r.allocsPerOp);
+        fclose(file);
+    }
+    return 0;
+}
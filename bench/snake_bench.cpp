@@ -0,0 +1,718 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "alloc_counter.hpp"
+#include "arena.hpp"
+#include "autopilot.hpp"
+#include "hamilton.hpp"
+#include "batch_simulation.hpp"
+#include "broadcast.hpp"
+#include "game_arena.hpp"
+#include "replay.hpp"
+#include "simulation.hpp"
+
+/**
+ * =============================
+ * snake_bench Overview
+ * =============================
+ * Headless throughput benchmark for the simulation core. It runs a Simulation
+ * for a fixed number of ticks under a bot policy, restarting rounds as they end,
+ * and reports ticks per second and heap allocations per tick. No window, audio
+ * or GPU is involved, so the numbers measure only the game-logic hot path.
+ *
+ * Usage:
+ *   snake_bench [--ticks N] [--board N] [--policy random|greedy|autopilot|hamilton] [--seed N] [--record FILE]
+ *               [--broadcast FILE]
+ *   snake_bench --games N [--heap] [--board N] [--policy random|greedy|autopilot|hamilton] [--seed N]
+ *   snake_bench --batch GAMES [--threads N] [--max-ticks N] [--scaling] [--kernel NAME]
+ *               [--results FILE] [--board N] [--policy random|greedy] [--seed N]
+ *   snake_bench --replay FILE [--repeat N] [--record FILE]
+ *   snake_bench --watch FILE [--repeat N] [--seed N]
+ *   snake_bench --arena SNAKES [--fruits N] [--ticks N] [--board N] [--seed N]
+ *
+ * Batch mode plays GAMES independent games on a BatchSimulation until each ends
+ * (or reaches --max-ticks), spread over a work-stealing pool of --threads workers
+ * (default: one per hardware thread). --scaling repeats the run at 1, 2, 4, ...
+ * threads and prints the speedup over one thread; --results writes one CSV row
+ * per game (game,score,ticks,won). --kernel auto|scalar|avx2|neon picks the
+ * collision kernel (default auto: the best this CPU supports); results are the
+ * same for every kernel, so only the timings may differ.
+ *
+ * Games mode plays N short games, each on a freshly built Simulation that is
+ * destroyed when its round ends, the pattern of a bot trainer starting thousands
+ * of games per second. The Simulations come from the thread's GameArena, which is
+ * reset after each game; --heap builds them on the heap instead for comparison.
+ *
+ * Replay mode re-runs a recorded session (see replay.hpp) --repeat times at full
+ * speed and checks every run ends identically, which makes a recorded game both
+ * a regression benchmark and a determinism check. --record FILE, in single mode,
+ * writes the bot's run as a replay instead; --broadcast FILE writes it as a
+ * broadcast (see broadcast.hpp), keyframes and all.
+ *
+ * Watch mode plays a broadcast from start to end, as the spectator's fast-forward
+ * does, and reports ticks per second. It then seeks to --repeat random ticks
+ * (default 1000) and checks each state against the one sequential playback
+ * reached, reporting the average seek time.
+ *
+ * Arena mode runs SNAKES bots (Arena::BotDirection) on one shared board for
+ * --ticks ticks and reports the cost per snake move, which should stay flat as
+ * SNAKES grows; --fruits defaults to one per snake.
+ *
+ * Policies:
+ *   - random : keep going straight most of the time, turn at random otherwise,
+ *              preferring moves that stay on the board and off the body.
+ *   - greedy : scripted bot that steers toward the first active fruit and only
+ *              deviates to avoid an immediate collision.
+ *   - autopilot : the game's Autopilot (breadth-first path to the nearest fruit with
+ *              a tail-reachability check); single and games modes only. Single mode
+ *              also reports how many searches it ran per tick.
+ *   - hamilton : the game's HamiltonSolver (cycle through every cell, with shortcuts);
+ *              single and games modes only. This is the full-board stress test: both
+ *              modes report how many rounds ended with the board filled, which on
+ *              even board sizes is every round and on odd ones (the default 25) almost none.
+ */
+
+static const Cell directions[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}; // right, down, left, up
+
+/*
+ * IsSafe
+ * Objective: whether moving the head one step in `direction` survives the next tick.
+ * Return value: bool - true when the target cell is on the board and not on the body
+ *               (the tail cell counts as free because it moves away this tick)
+ */
+static bool IsSafe(const Simulation &sim, Cell direction)
+{
+    const Snake &snake = sim.snake;
+    Cell next = snake.body[0] + direction;
+    if (!snake.occupancy.InBounds(next))
+        return false;
+    if (next == snake.body.back() && !snake.addSegment)
+        return true;
+    return !snake.IsOccupied(next);
+}
+
+/*
+ * IsReversal
+ * Return value: bool - true when `direction` points straight back into the neck
+ */
+static bool IsReversal(const Simulation &sim, Cell direction)
+{
+    Cell current = sim.snake.direction;
+    return direction.x == -current.x && direction.y == -current.y;
+}
+
+/*
+ * RandomPolicy
+ * Objective: mostly straight, sometimes random, never a reversal; safe moves first.
+ */
+static Cell RandomPolicy(const Simulation &sim, std::mt19937 &rng)
+{
+    Cell preferred = sim.snake.direction;
+    if (rng() % 8 == 0)
+        preferred = directions[rng() % 4]; // occasional random turn
+    if (!IsReversal(sim, preferred) && IsSafe(sim, preferred))
+        return preferred;
+
+    int start = rng() % 4;
+    for (int i = 0; i < 4; i++)
+    {
+        Cell candidate = directions[(start + i) % 4];
+        if (!IsReversal(sim, candidate) && IsSafe(sim, candidate))
+            return candidate;
+    }
+    return sim.snake.direction; // boxed in: keep going and lose the round
+}
+
+/*
+ * GreedyPolicy
+ * Objective: steer toward the first active fruit, falling back to any safe move.
+ */
+static Cell GreedyPolicy(const Simulation &sim, std::mt19937 &rng)
+{
+    Cell head = sim.snake.body[0];
+    for (const Food &f : sim.fruits)
+    {
+        if (!f.active)
+            continue;
+        Cell wanted[2] = {
+            Cell{(int16_t)(f.position.x > head.x ? 1 : -1), 0},
+            Cell{0, (int16_t)(f.position.y > head.y ? 1 : -1)},
+        };
+        bool needX = f.position.x != head.x;
+        bool needY = f.position.y != head.y;
+        if (needX && !IsReversal(sim, wanted[0]) && IsSafe(sim, wanted[0]))
+            return wanted[0];
+        if (needY && !IsReversal(sim, wanted[1]) && IsSafe(sim, wanted[1]))
+            return wanted[1];
+        break;
+    }
+    return RandomPolicy(sim, rng);
+}
+
+static Autopilot benchAutopilot; // single-threaded modes only; buffers reused across games
+
+/*
+ * AutopilotPolicy
+ * Objective: the game's --autopilot bot; ignores the generator.
+ */
+static Cell AutopilotPolicy(const Simulation &sim, std::mt19937 &)
+{
+    return benchAutopilot.Decide(sim);
+}
+
+static HamiltonSolver benchHamilton; // cycle built for the board before the timed loop
+
+/*
+ * HamiltonPolicy
+ * Objective: the game's --hamilton bot; ignores the generator.
+ */
+static Cell HamiltonPolicy(const Simulation &sim, std::mt19937 &)
+{
+    return benchHamilton.Decide(sim);
+}
+
+/*
+ * RunSingle
+ * Objective: tick one Simulation tickCount times and print throughput figures.
+ */
+static int RunSingle(const char *policyName, int boardSize, long long tickCount, unsigned int seed,
+                     const char *recordPath, const char *broadcastPath)
+{
+    Cell (*policy)(const Simulation &, std::mt19937 &) = nullptr;
+    if (!strcmp(policyName, "random"))
+        policy = RandomPolicy;
+    else if (!strcmp(policyName, "greedy"))
+        policy = GreedyPolicy;
+    else if (!strcmp(policyName, "autopilot"))
+        policy = AutopilotPolicy;
+    else if (!strcmp(policyName, "hamilton"))
+        policy = HamiltonPolicy;
+    if (!policy)
+    {
+        fprintf(stderr, "snake_bench: unknown policy '%s'\n", policyName);
+        return 1;
+    }
+
+    Simulation sim(boardSize, seed);
+    std::mt19937 policyRng(seed ^ 0x9e3779b9u); // bot decisions, separate from food placement
+    benchAutopilot.Reserve(boardSize); // outside the timed, allocation-counted loop
+    if (policy == HamiltonPolicy)
+        benchHamilton.cycle.Build(boardSize);
+    Replay replay;
+    if (recordPath)
+    {
+        if (tickCount > UINT32_MAX)
+        {
+            fprintf(stderr, "snake_bench: too many ticks to record\n");
+            return 1;
+        }
+        replay.Begin(boardSize, seed);
+        replay.turns.reserve(1 << 20); // keep recording out of the allocation count
+    }
+    BroadcastRecorder broadcast;
+    std::vector<uint8_t> broadcastBytes;
+    if (broadcastPath)
+    {
+        if (tickCount > UINT32_MAX)
+        {
+            fprintf(stderr, "snake_bench: too many ticks to record\n");
+            return 1;
+        }
+        broadcast.Begin(sim);
+        broadcastBytes.reserve(1 << 24); // keep recording out of the allocation count
+    }
+
+    long long rounds = 0;
+    long long totalScore = 0;
+    int bestScore = 0;
+    long long filled = 0; // rounds that ended with the board full
+
+    size_t allocationsBefore = AllocationCount();
+    auto start = std::chrono::steady_clock::now();
+    for (long long t = 0; t < tickCount; t++)
+    {
+        Cell direction = policy(sim, policyRng);
+        if (recordPath)
+            replay.Record(sim, direction);
+        TickEvents events = sim.Step(direction);
+        if (broadcastPath)
+        {
+            broadcast.Record(sim, events);
+            if (broadcast.HasPending())
+                broadcast.TakePending(broadcastBytes); // as the game hands chunks to its writer
+        }
+        if (events.RoundOver())
+        {
+            rounds++;
+            filled += events.boardFull ? 1 : 0;
+            totalScore += sim.lastScore;
+            if (sim.lastScore > bestScore)
+                bestScore = sim.lastScore;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    size_t allocations = AllocationCount() - allocationsBefore;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    printf("policy=%s board=%d ticks=%lld rounds=%lld mean_score=%.2f best_score=%d\n",
+           policyName, boardSize, tickCount, rounds,
+           rounds ? (double)totalScore / rounds : 0.0, bestScore);
+    printf("ticks_per_sec=%.0f ns_per_tick=%.1f\n", tickCount / seconds, seconds * 1e9 / tickCount);
+    if (policy == AutopilotPolicy)
+        printf("searches_per_tick=%.3f\n", (double)benchAutopilot.Searches() / tickCount);
+    if (policy == HamiltonPolicy)
+        printf("boards_filled=%lld of %lld rounds\n", filled, rounds);
+    if (AllocationCountingEnabled())
+        printf("allocs_per_tick=%.6f (%zu total)\n", (double)allocations / tickCount, allocations);
+    else
+        printf("allocs_per_tick=n/a (built without SNAKE_COUNT_ALLOCATIONS)\n");
+
+    if (recordPath)
+    {
+        if (!replay.Save(recordPath))
+        {
+            fprintf(stderr, "snake_bench: cannot write %s\n", recordPath);
+            return 1;
+        }
+        printf("recorded %zu turns to %s\n", replay.turns.size(), recordPath);
+    }
+    if (broadcastPath)
+    {
+        broadcast.Finish();
+        broadcast.TakePending(broadcastBytes);
+        FILE *out = fopen(broadcastPath, "wb");
+        bool ok = out && fwrite(broadcastBytes.data(), 1, broadcastBytes.size(), out) == broadcastBytes.size();
+        if (out)
+            ok = fclose(out) == 0 && ok;
+        if (!ok)
+        {
+            fprintf(stderr, "snake_bench: cannot write %s\n", broadcastPath);
+            return 1;
+        }
+        printf("broadcast %zu bytes (%.3f per tick) to %s\n", broadcastBytes.size(),
+               (double)broadcastBytes.size() / tickCount, broadcastPath);
+    }
+    return 0;
+}
+
+/*
+ * RunGames
+ * Objective: play `games` single-round games, each on a new Simulation, and print
+ *            games per second and heap allocations per game.
+ */
+static int RunGames(const char *policyName, int boardSize, int games, unsigned int seed, bool useHeap)
+{
+    Cell (*policy)(const Simulation &, std::mt19937 &) = nullptr;
+    if (!strcmp(policyName, "random"))
+        policy = RandomPolicy;
+    else if (!strcmp(policyName, "greedy"))
+        policy = GreedyPolicy;
+    else if (!strcmp(policyName, "autopilot"))
+        policy = AutopilotPolicy;
+    else if (!strcmp(policyName, "hamilton"))
+        policy = HamiltonPolicy;
+    if (!policy)
+    {
+        fprintf(stderr, "snake_bench: unknown policy '%s'\n", policyName);
+        return 1;
+    }
+
+    GameArena &arena = ThreadGameArena();
+    std::pmr::memory_resource *memory = useHeap ? std::pmr::get_default_resource() : arena.Resource();
+    std::mt19937 policyRng(seed ^ 0x9e3779b9u);
+    benchAutopilot.Reserve(boardSize);
+    if (policy == HamiltonPolicy)
+        benchHamilton.cycle.Build(boardSize);
+    {
+        Simulation warmup(boardSize, seed, memory); // lets the arena settle at its final size
+    }
+    arena.Reset();
+
+    long long ticks = 0;
+    long long totalScore = 0;
+    int filled = 0;
+    size_t allocationsBefore = AllocationCount();
+    auto start = std::chrono::steady_clock::now();
+    for (int g = 0; g < games; g++)
+    {
+        {
+            Simulation sim(boardSize, seed + g, memory);
+            TickEvents events;
+            do
+            {
+                events = sim.Step(policy(sim, policyRng));
+                ticks++;
+            } while (!events.RoundOver());
+            totalScore += sim.lastScore;
+            filled += events.boardFull ? 1 : 0;
+        }
+        if (!useHeap)
+            arena.Reset(); // the game's grid and body are gone in O(1)
+    }
+    auto end = std::chrono::steady_clock::now();
+    size_t allocations = AllocationCount() - allocationsBefore;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    printf("policy=%s board=%d games=%d memory=%s ticks=%lld mean_score=%.2f\n",
+           policyName, boardSize, games, useHeap ? "heap" : "arena", ticks, (double)totalScore / games);
+    printf("games_per_sec=%.0f ns_per_game=%.1f arena_bytes=%zu\n",
+           games / seconds, seconds * 1e9 / games, arena.Capacity());
+    if (policy == HamiltonPolicy)
+        printf("boards_filled=%d of %d games\n", filled, games);
+    if (AllocationCountingEnabled())
+        printf("allocs_per_game=%.3f (%zu total)\n", (double)allocations / games, allocations);
+    else
+        printf("allocs_per_game=n/a (built without SNAKE_COUNT_ALLOCATIONS)\n");
+    return 0;
+}
+
+/*
+ * RunReplay
+ * Objective: play a replay file `repeat` times headless, print throughput and the
+ *            outcome, and fail if any run differs from the first.
+ */
+static int RunReplay(const char *path, int repeat)
+{
+    Replay replay;
+    if (!replay.Load(path))
+    {
+        fprintf(stderr, "snake_bench: %s is not a valid replay\n", path);
+        return 1;
+    }
+
+    ReplayResult first = {};
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++)
+    {
+        ReplayResult result = replay.Play();
+        if (i == 0)
+            first = result;
+        else if (result.rounds != first.rounds || result.totalScore != first.totalScore ||
+                 result.finalScore != first.finalScore)
+        {
+            fprintf(stderr, "snake_bench: run %d diverged from run 0\n", i);
+            return 1;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double ticks = (double)first.ticks * repeat;
+    printf("replay=%s board=%d seed=%llu ticks=%u turns=%zu rounds=%d best_score=%d final_score=%d\n",
+           path, replay.boardSize, (unsigned long long)replay.seed, first.ticks, replay.turns.size(),
+           first.rounds, first.bestScore, first.finalScore);
+    printf("repeat=%d ticks_per_sec=%.0f seconds=%.3f\n", repeat, ticks / seconds, seconds);
+    return 0;
+}
+
+/*
+ * StateHash
+ * Objective: FNV-1a over everything a broadcast restores: body, fruits, score, speed.
+ */
+static uint64_t StateHash(const Simulation &sim)
+{
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](uint64_t value) { hash = (hash ^ value) * 1099511628211ull; };
+    for (unsigned int i = 0; i < sim.snake.body.size(); i++)
+        mix(((uint64_t)(uint16_t)sim.snake.body[i].x << 16) | (uint16_t)sim.snake.body[i].y);
+    for (const Food &fruit : sim.fruits)
+        mix(fruit.active ? ((uint64_t)fruit.position.x << 24) | ((uint64_t)fruit.position.y << 8) | fruit.textureIndex : 1);
+    mix((uint64_t)sim.score);
+    mix((uint64_t)(sim.speed * 1e9));
+    mix((uint64_t)sim.snake.occupancy.FreeCount());
+    return hash;
+}
+
+/*
+ * RunWatch
+ * Objective: play a broadcast through at full speed, then check random seeks
+ *            against the sequential states and time them.
+ */
+static int RunWatch(const char *path, int seeks, unsigned int seed)
+{
+    BroadcastPlayer player;
+    if (!player.Load(path))
+    {
+        fprintf(stderr, "snake_bench: %s is not a valid broadcast\n", path);
+        return 1;
+    }
+    Simulation sim(player.boardSize, 0);
+    uint32_t ticks = player.TickCount();
+    std::vector<uint64_t> hashes;
+    hashes.reserve((size_t)ticks + 1);
+
+    player.Seek(sim, 0);
+    hashes.push_back(StateHash(sim));
+    int rounds = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (player.Tick() < ticks)
+    {
+        rounds += player.Step(sim).RoundOver() ? 1 : 0;
+        hashes.push_back(StateHash(sim));
+    }
+    double playSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> pick(0, ticks);
+    int mismatches = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < seeks; i++)
+    {
+        uint32_t target = pick(rng);
+        player.Seek(sim, target);
+        if (player.Tick() != target || StateHash(sim) != hashes[target])
+            mismatches++;
+    }
+    double seekSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("broadcast=%s board=%d ticks=%u rounds=%d keyframes=%zu interval=%u\n", path, player.boardSize,
+           ticks, rounds, player.Keyframes(), player.keyframeInterval);
+    printf("playback_ticks_per_sec=%.0f (hashing included) seeks=%d us_per_seek=%.2f mismatches=%d\n",
+           ticks / playSeconds, seeks, seeks ? seekSeconds * 1e6 / seeks : 0.0, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+/*
+ * RunArena
+ * Objective: tick an Arena of `snakeCount` bots and print per-tick and per-move costs.
+ */
+static int RunArena(int snakeCount, int fruitCount, int boardSize, long long tickCount, unsigned int seed)
+{
+    Arena arena(boardSize, snakeCount, fruitCount, seed);
+    SimRandom botRng(seed ^ 0x9e3779b9u); // bot decisions, separate from spawns
+    std::vector<Cell> moves(arena.snakes.size());
+
+    long long fruitsEaten = 0;
+    long long deaths = 0;
+    long long headOnDeaths = 0;
+    long long snakeMoves = 0;
+    size_t longest = 0;
+
+    size_t allocationsBefore = AllocationCount();
+    auto start = std::chrono::steady_clock::now();
+    for (long long t = 0; t < tickCount; t++)
+    {
+        for (size_t i = 0; i < moves.size(); i++)
+        {
+            moves[i] = arena.BotDirection((int)i, botRng);
+            snakeMoves += arena.snakes[i].alive;
+        }
+        ArenaEvents events = arena.Step(moves.data());
+        fruitsEaten += events.fruitsEaten;
+        deaths += events.deaths;
+        headOnDeaths += events.headOnDeaths;
+    }
+    auto end = std::chrono::steady_clock::now();
+    size_t allocations = AllocationCount() - allocationsBefore;
+    for (const ArenaSnake &snake : arena.snakes)
+        longest = snake.body.size() > longest ? snake.body.size() : longest;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    printf("arena snakes=%zu fruits=%zu board=%d ticks=%lld eaten=%lld deaths=%lld head_on=%lld longest=%zu\n",
+           arena.snakes.size(), arena.fruits.size(), boardSize, tickCount, fruitsEaten, deaths, headOnDeaths, longest);
+    printf("ticks_per_sec=%.0f ns_per_tick=%.1f ns_per_snake_move=%.2f\n",
+           tickCount / seconds, seconds * 1e9 / tickCount, snakeMoves ? seconds * 1e9 / snakeMoves : 0.0);
+    if (AllocationCountingEnabled())
+        printf("allocs_per_tick=%.6f (%zu total, body rings growing)\n", (double)allocations / tickCount, allocations);
+    return 0;
+}
+
+/*
+ * RunBatch
+ * Objective: play `games` games on a BatchSimulation with `threads` workers and
+ *            print throughput; returns the elapsed seconds.
+ */
+static double RunBatch(BatchSimulation &batch, unsigned int threads, int maxTicks, BatchPolicy policy,
+                       uint64_t seed, bool quiet)
+{
+    ThreadPool pool(threads);
+    batch.Run(pool, 0, policy); // sizes the pool's chunk queues, so the count below only sees the run
+    batch.Reset(seed);
+
+    size_t allocationsBefore = AllocationCount();
+    auto start = std::chrono::steady_clock::now();
+    batch.Run(pool, maxTicks, policy);
+    auto end = std::chrono::steady_clock::now();
+    size_t allocations = AllocationCount() - allocationsBefore;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    long long totalTicks = batch.TotalTicks();
+    if (!quiet)
+    {
+        long long totalScore = 0;
+        int wins = 0;
+        for (int g = 0; g < batch.GameCount(); g++)
+        {
+            BatchResult result = batch.Result(g);
+            totalScore += result.score;
+            wins += result.won;
+        }
+        printf("games=%d threads=%u board=%d kernel=%s ticks=%lld mean_score=%.2f wins=%d\n",
+               batch.GameCount(), pool.Size(), batch.BoardSize(), LaneKernelName(batch.Kernel()), totalTicks,
+               (double)totalScore / batch.GameCount(), wins);
+        printf("ticks_per_sec=%.0f games_per_sec=%.0f seconds=%.3f allocs_during_run=%zu\n",
+               totalTicks / seconds, batch.GameCount() / seconds, seconds, allocations);
+    }
+    return seconds;
+}
+
+int main(int argc, char **argv)
+{
+    long long tickCount = 5000000;
+    int boardSize = 25;
+    unsigned int seed = 1;
+    const char *policyName = "random";
+    int batchGames = 0;
+    unsigned int threads = 0;
+    int maxTicks = 100000;
+    bool scaling = false;
+    const char *resultsPath = nullptr;
+    const char *replayPath = nullptr;
+    const char *recordPath = nullptr;
+    const char *broadcastPath = nullptr;
+    const char *watchPath = nullptr;
+    int repeat = 0; // mode default: 1 replay run, 1000 broadcast seeks
+    int arenaSnakes = 0;
+    int arenaFruits = -1; // one per snake
+    const char *kernelName = "auto";
+    int games = 0;
+    bool useHeap = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--ticks") && i + 1 < argc)
+            tickCount = atoll(argv[++i]);
+        else if (!strcmp(argv[i], "--board") && i + 1 < argc)
+            boardSize = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--policy") && i + 1 < argc)
+            policyName = argv[++i];
+        else if (!strcmp(argv[i], "--batch") && i + 1 < argc)
+            batchGames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+            threads = (unsigned int)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--max-ticks") && i + 1 < argc)
+            maxTicks = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--results") && i + 1 < argc)
+            resultsPath = argv[++i];
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc)
+            replayPath = argv[++i];
+        else if (!strcmp(argv[i], "--record") && i + 1 < argc)
+            recordPath = argv[++i];
+        else if (!strcmp(argv[i], "--broadcast") && i + 1 < argc)
+            broadcastPath = argv[++i];
+        else if (!strcmp(argv[i], "--watch") && i + 1 < argc)
+            watchPath = argv[++i];
+        else if (!strcmp(argv[i], "--repeat") && i + 1 < argc)
+            repeat = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--arena") && i + 1 < argc)
+            arenaSnakes = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--fruits") && i + 1 < argc)
+            arenaFruits = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--kernel") && i + 1 < argc)
+            kernelName = argv[++i];
+        else if (!strcmp(argv[i], "--games") && i + 1 < argc)
+            games = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--heap"))
+            useHeap = true;
+        else if (!strcmp(argv[i], "--scaling"))
+            scaling = true;
+        else
+        {
+            fprintf(stderr, "usage: %s [--ticks N] [--board N] [--policy random|greedy|autopilot|hamilton] [--seed N] [--record FILE]\n"
+                            "          [--broadcast FILE]\n"
+                            "       %s --games N [--heap]\n"
+                            "       %s --batch GAMES [--threads N] [--max-ticks N] [--scaling] [--kernel NAME] [--results FILE]\n"
+                            "       %s --replay FILE [--repeat N]\n"
+                            "       %s --watch FILE [--repeat N]\n"
+                            "       %s --arena SNAKES [--fruits N] [--ticks N] [--board N]\n",
+                    argv[0], argv[0], argv[0], argv[0], argv[0], argv[0]);
+            return 1;
+        }
+    }
+
+    if (boardSize < 5 || boardSize > 4096 || tickCount <= 0 || maxTicks <= 0 || batchGames < 0 || games < 0)
+    {
+        fprintf(stderr, "snake_bench: invalid board size or tick count\n");
+        return 1;
+    }
+    if (arenaSnakes > 0)
+        return RunArena(arenaSnakes, arenaFruits >= 0 ? arenaFruits : arenaSnakes, boardSize, tickCount, seed);
+    if (games > 0)
+        return RunGames(policyName, boardSize, games, seed, useHeap);
+    if (replayPath)
+        return RunReplay(replayPath, repeat > 0 ? repeat : 1);
+    if (watchPath)
+        return RunWatch(watchPath, repeat > 0 ? repeat : 1000, seed);
+    if (batchGames == 0)
+        return RunSingle(policyName, boardSize, tickCount, seed, recordPath, broadcastPath);
+
+    BatchPolicy policy;
+    if (!strcmp(policyName, "random"))
+        policy = BatchPolicy::Random;
+    else if (!strcmp(policyName, "greedy"))
+        policy = BatchPolicy::Greedy;
+    else
+    {
+        fprintf(stderr, "snake_bench: unknown policy '%s'\n", policyName);
+        return 1;
+    }
+
+    BatchSimulation batch(batchGames, boardSize, seed);
+    if (strcmp(kernelName, "auto"))
+    {
+        LaneKernel kernel = LaneKernel::Scalar;
+        if (!strcmp(kernelName, "avx2"))
+            kernel = LaneKernel::Avx2;
+        else if (!strcmp(kernelName, "neon"))
+            kernel = LaneKernel::Neon;
+        else if (strcmp(kernelName, "scalar"))
+        {
+            fprintf(stderr, "snake_bench: unknown kernel '%s'\n", kernelName);
+            return 1;
+        }
+        if (!LaneKernelSupported(kernel))
+        {
+            fprintf(stderr, "snake_bench: kernel %s is not supported on this CPU\n", kernelName);
+            return 1;
+        }
+        batch.SetKernel(kernel);
+    }
+    if (scaling)
+    {
+        unsigned int maxThreads = threads ? threads : std::thread::hardware_concurrency();
+        double baseline = 0;
+        for (unsigned int t = 1; t <= maxThreads; t *= 2)
+        {
+            double seconds = RunBatch(batch, t, maxTicks, policy, seed, true);
+            if (t == 1)
+                baseline = seconds;
+            printf("threads=%u seconds=%.3f ticks_per_sec=%.0f speedup=%.2f\n",
+                   t, seconds, batch.TotalTicks() / seconds, baseline / seconds);
+        }
+    }
+    RunBatch(batch, threads, maxTicks, policy, seed, false);
+
+    if (resultsPath)
+    {
+        FILE *out = fopen(resultsPath, "w");
+        if (!out)
+        {
+            fprintf(stderr, "snake_bench: cannot write %s\n", resultsPath);
+            return 1;
+        }
+        fprintf(out, "game,score,ticks,won\n");
+        for (int g = 0; g < batch.GameCount(); g++)
+        {
+            BatchResult result = batch.Result(g);
+            fprintf(out, "%d,%d,%d,%d\n", g, result.score, result.ticks, result.won ? 1 : 0);
+        }
+        fclose(out);
+    }
+    return 0;
+}
@@ -28,6 +28,46 @@ newoption
     default = "glfw"
 }
 
+newoption
+{
+    trigger = "profile",
+    description = "compile the in-game profiler into Release builds (always on in Debug)"
+}
+
+newoption
+{
+    trigger = "march",
+    value = "ARCH",
+    description = "instruction set the Perf build targets (-march= for gcc/clang, /arch: for Visual Studio)",
+    allowed = {
+        { "native", "the machine doing the build"},
+        { "x86-64-v2", "SSE4.2, POPCNT"},
+        { "x86-64-v3", "AVX2, BMI2, FMA"},
+        { "x86-64-v4", "AVX-512"},
+        { "armv8-a", "baseline 64-bit ARM"},
+        { "armv8.2-a", "64-bit ARM with dot product and fp16"}
+    }
+}
+
+newoption
+{
+    trigger = "pgo",
+    value = "STAGE",
+    description = "profile guided optimisation of the Perf build (see pgo.sh)",
+    allowed = {
+        { "generate", "instrument the binaries to write profiles into build/pgo"},
+        { "use", "optimise with the profiles in build/pgo"}
+    }
+}
+
+newoption
+{
+    trigger = "fixed-board",
+    value = "N",
+    description = "board size the simulation tick is compiled for (src/board.hpp); 0 for run-time sizes only",
+    default = "25"
+}
+
 newoption
 {
     trigger = "wayland",
@@ -139,13 +179,13 @@ end
 
 workspace (workspaceName)
     location "../"
-    configurations { "Debug", "Release"}
+    configurations { "Debug", "Release", "Perf"}
     platforms { "x64", "x86", "ARM64"}
 
     defaultplatform ("x64")
 
     filter "configurations:Debug"
-        defines { "DEBUG" }
+        defines { "DEBUG", "SNAKE_COUNT_ALLOCATIONS" }
         symbols "On"
 
     filter "configurations:Release"
@@ -155,6 +195,44 @@ workspace (workspaceName)
     filter {"configurations:Release", "action:vs*"}
        linktimeoptimization "On"
 
+    -- Perf: Release plus whole-program optimisation with every toolset, and optionally a
+    -- target instruction set and a training profile (--march, --pgo); for measuring and shipping
+    filter "configurations:Perf"
+        defines { "NDEBUG" }
+        optimize "Speed"
+        linktimeoptimization "On"
+
+    filter {}
+    defines { "SNAKE_FIXED_BOARD=" .. _OPTIONS["fixed-board"] }
+
+    if _OPTIONS["march"] then
+        filter {"configurations:Perf", "action:gmake*"}
+            buildoptions { "-march=" .. _OPTIONS["march"] }
+        filter {"configurations:Perf", "action:vs*", "options:march=x86-64-v3"}
+            buildoptions { "/arch:AVX2" }
+        filter {"configurations:Perf", "action:vs*", "options:march=x86-64-v4"}
+            buildoptions { "/arch:AVX512" }
+    end
+
+    -- clang keys profiles by function, so one merged snake.profdata serves every project;
+    -- gcc writes one .gcda per object file, so only the binaries that were trained
+    -- (snake_bench) get a profile and the rest build as plain Perf
+    pgo_dir = path.getabsolute("pgo")
+    filter {"configurations:Perf", "options:pgo=generate", "action:gmake*", "toolset:clang"}
+        buildoptions { "-fprofile-generate=\"" .. pgo_dir .. "/raw\"" }
+        linkoptions { "-fprofile-generate=\"" .. pgo_dir .. "/raw\"" }
+    filter {"configurations:Perf", "options:pgo=use", "action:gmake*", "toolset:clang"}
+        buildoptions { "-fprofile-use=\"" .. pgo_dir .. "/snake.profdata\"", "-Wno-profile-instr-unprofiled" }
+    filter {"configurations:Perf", "options:pgo=generate", "action:gmake*", "toolset:gcc"}
+        buildoptions { "-fprofile-generate=\"" .. pgo_dir .. "/gcda\"", "-fprofile-update=atomic" }
+        linkoptions { "-fprofile-generate=\"" .. pgo_dir .. "/gcda\"" }
+    filter {"configurations:Perf", "options:pgo=use", "action:gmake*", "toolset:gcc"}
+        buildoptions { "-fprofile-use=\"" .. pgo_dir .. "/gcda\"", "-fprofile-partial-training", "-Wno-missing-profile" }
+    filter {"configurations:Perf", "options:pgo=generate", "action:vs*"}
+        linkoptions { "/GENPROFILE" }
+    filter {"configurations:Perf", "options:pgo=use", "action:vs*"}
+        linkoptions { "/USEPROFILE" }
+
     filter { "platforms:x64" }
         architecture "x86_64"
 
@@ -210,6 +288,19 @@ if (downloadRaylib) then
 
         links {"raylib"}
 
+        -- scoped timers, F3 overlay and F4 Chrome trace (src/profiler.hpp); compiled out otherwise
+        filter {"configurations:Debug"}
+            defines {"SNAKE_PROFILE"}
+        filter {"options:profile"}
+            defines {"SNAKE_PROFILE"}
+        filter{}
+
+        -- assets.pak: pre-scaled, pre-decoded startup assets (see tools/asset_packer.cpp);
+        -- the packer skips the write when the pack is newer than its sources
+        dependson {"asset_packer"}
+        prebuildmessage "Packing assets into assets.pak"
+        prebuildcommands { "\"%{cfg.buildtarget.directory}/asset_packer\" \"%{wks.location}\" \"%{wks.location}/assets.pak\"" }
+
         cdialect "C17"
         cppdialect "C++17"
 
@@ -228,7 +319,7 @@ if (downloadRaylib) then
 
         filter "system:windows"
             defines{"_WIN32"}
-            links {"winmm", "gdi32", "opengl32"}
+            links {"winmm", "gdi32", "opengl32", "ws2_32"}
             libdirs {"../bin/%{cfg.buildcfg}"}
 
         filter "system:linux"
@@ -240,6 +331,140 @@ if (downloadRaylib) then
         filter{}
         
 
+    project "asset_packer"
+        kind "ConsoleApp"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        -- build-time tool: only raylib's CPU image/audio decoders, never a window
+        files {"../tools/asset_packer.cpp", "../src/assets.cpp", "../src/assets.hpp", "../src/asset_bundle.cpp", "../src/asset_bundle.hpp"}
+        includedirs { "../src" }
+        includedirs {raylib_dir .. "/src" }
+
+        links {"raylib"}
+
+        cppdialect "C++17"
+        flags { "ShadowedVariables"}
+        platform_defines()
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            dependson {"raylib"}
+            links {"raylib.lib"}
+            buildoptions { "/Zc:__cplusplus" }
+
+        filter "system:windows"
+            links {"winmm", "gdi32", "opengl32"}
+            libdirs {"../bin/%{cfg.buildcfg}"}
+
+        filter "system:linux"
+            links {"pthread", "m", "dl", "rt", "X11"}
+
+        filter "system:macosx"
+            links {"OpenGL.framework", "Cocoa.framework", "IOKit.framework", "CoreFoundation.framework", "CoreAudio.framework", "CoreVideo.framework", "AudioToolbox.framework"}
+        filter{}
+
+    project "snake_bench"
+        kind "ConsoleApp"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        -- headless: only the simulation core, no raylib
+        files {"../bench/snake_bench.cpp", "../src/simulation.cpp", "../src/simulation.hpp", "../src/alloc_counter.cpp", "../src/alloc_counter.hpp",
+               "../src/batch_simulation.cpp", "../src/batch_simulation.hpp", "../src/batch_kernels.cpp", "../src/batch_kernels.hpp", "../src/thread_pool.cpp", "../src/thread_pool.hpp", "../src/rng.hpp",
+               "../src/replay.cpp", "../src/replay.hpp", "../src/arena.cpp", "../src/arena.hpp", "../src/game_arena.cpp", "../src/game_arena.hpp",
+               "../src/autopilot.cpp", "../src/autopilot.hpp",
+               "../src/hamilton.cpp", "../src/hamilton.hpp", "../src/broadcast.cpp", "../src/broadcast.hpp"}
+        includedirs { "../src" }
+        defines { "SNAKE_COUNT_ALLOCATIONS" }
+
+        cppdialect "C++17"
+        flags { "ShadowedVariables"}
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            buildoptions { "/Zc:__cplusplus" }
+
+        filter "action:vs*"
+            debugdir "$(SolutionDir)"
+
+        filter "system:linux"
+            links {"pthread"}
+        filter{}
+
+    project "snake_microbench"
+        kind "ConsoleApp"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        -- per-function timings of the simulation hot paths across board sizes; no raylib
+        files {"../bench/micro_bench.cpp", "../src/simulation.cpp", "../src/simulation.hpp", "../src/alloc_counter.cpp", "../src/alloc_counter.hpp",
+               "../src/rng.hpp"}
+        includedirs { "../src" }
+        defines { "SNAKE_COUNT_ALLOCATIONS" }
+
+        cppdialect "C++17"
+        flags { "ShadowedVariables"}
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            buildoptions { "/Zc:__cplusplus" }
+
+        filter "action:vs*"
+            debugdir "$(SolutionDir)"
+        filter{}
+
+    project "snake_server"
+        kind "ConsoleApp"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        -- headless multiplayer server: arenas, the wire protocol and UDP sockets; no raylib
+        files {"../tools/snake_server.cpp", "../src/net_protocol.cpp", "../src/net_protocol.hpp", "../src/net_socket.cpp", "../src/net_socket.hpp",
+               "../src/arena.cpp", "../src/arena.hpp", "../src/simulation.cpp", "../src/simulation.hpp", "../src/thread_pool.cpp", "../src/thread_pool.hpp",
+               "../src/rng.hpp"}
+        includedirs { "../src" }
+
+        cppdialect "C++17"
+        flags { "ShadowedVariables"}
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            buildoptions { "/Zc:__cplusplus" }
+
+        filter "action:vs*"
+            debugdir "$(SolutionDir)"
+
+        filter "system:windows"
+            links {"ws2_32"}
+
+        filter "system:linux"
+            links {"pthread"}
+        filter{}
+
+    project "snake_env"
+        kind "SharedLib"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        -- reinforcement-learning environment: the batch simulation behind a C API for env/snake_env.py; no raylib
+        files {"../env/snake_env.cpp", "../env/snake_env.h", "../src/batch_simulation.cpp", "../src/batch_simulation.hpp",
+               "../src/batch_kernels.cpp", "../src/batch_kernels.hpp", "../src/thread_pool.cpp", "../src/thread_pool.hpp", "../src/rng.hpp"}
+        includedirs { "../src" }
+
+        cppdialect "C++17"
+        flags { "ShadowedVariables"}
+        pic "On"
+        visibility "Hidden" -- only the SNAKE_ENV_API functions are exported
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            buildoptions { "/Zc:__cplusplus" }
+
+        filter "system:linux"
+            links {"pthread"}
+        filter{}
+
     project "raylib"
         kind "StaticLib"
     
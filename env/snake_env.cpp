@@ -0,0 +1,259 @@
+#include "snake_env.h"
+
+#include <cstring>
+#include <vector>
+
+#include "batch_simulation.hpp"
+#include "thread_pool.hpp"
+
+/*
+ * SnakeEnv struct
+ * Objective: the state behind one environment handle.
+ * Member variables:
+ *  - batch, pool : the games and the threads that step them
+ *  - obsMode, viewRadius, viewSize, obsBytes : observation layout; bytes per game
+ *  - prevHead, prevTail, prevFruit, prevScore : each game's state before the current
+ *                                               step, to find the cells it changed
+ *  - lastScore : score of each game's last finished round
+ *  - lastObservations : buffer written by the previous call; grid planes are only
+ *                       updated incrementally when the caller passes it again
+ */
+struct SnakeEnv
+{
+    static constexpr size_t grain = 256; // games per chunk of work
+
+    BatchSimulation batch;
+    ThreadPool pool;
+    int obsMode;
+    int viewRadius;
+    int viewSize;
+    size_t obsBytes;
+    std::vector<int> prevHead, prevTail, prevFruit;
+    std::vector<int32_t> prevScore, lastScore;
+    const uint8_t *lastObservations = nullptr;
+
+    SnakeEnv(int games, int boardSize, int mode, int radius, unsigned int threads)
+        : batch(games, boardSize, 0), pool(threads), obsMode(mode), viewRadius(radius), viewSize(2 * radius + 1),
+          prevHead(games), prevTail(games), prevFruit((size_t)games * BatchSimulation::fruitCount),
+          prevScore(games), lastScore(games, 0)
+    {
+        size_t cells = (size_t)boardSize * boardSize;
+        obsBytes = mode == SNAKE_ENV_OBS_GRID ? 3 * cells : 2 * (size_t)viewSize * viewSize;
+    }
+
+    void Remember(int game);
+    void WriteGrid(int game, uint8_t *obs) const;
+    void UpdateGrid(int game, uint8_t *obs) const;
+    void WriteView(int game, uint8_t *obs) const;
+    void Observe(int game, uint8_t *observations, bool full) const;
+};
+
+/**
+ * SnakeEnv::Remember
+ * ============================
+ * Objective:
+ *   Note game g's head, tail, fruits and score before it is stepped.
+ */
+void SnakeEnv::Remember(int game)
+{
+    prevHead[game] = batch.Head(game);
+    prevTail[game] = batch.Tail(game);
+    for (int k = 0; k < BatchSimulation::fruitCount; k++)
+        prevFruit[(size_t)game * BatchSimulation::fruitCount + k] = batch.FruitCell(game, k);
+    prevScore[game] = batch.Score(game);
+}
+
+/**
+ * SnakeEnv::WriteGrid
+ * ============================
+ * Objective:
+ *   Write all three planes of game g from scratch: body, head, fruit.
+ */
+void SnakeEnv::WriteGrid(int game, uint8_t *obs) const
+{
+    size_t cells = (size_t)batch.BoardSize() * batch.BoardSize();
+    memset(obs, 0, 3 * cells);
+    for (uint32_t i = 0; i < batch.Length(game); i++)
+        obs[batch.BodyCell(game, i)] = 1;
+    obs[cells + batch.Head(game)] = 1;
+    for (int k = 0; k < BatchSimulation::fruitCount; k++)
+    {
+        int fruit = batch.FruitCell(game, k);
+        if (fruit >= 0)
+            obs[2 * cells + fruit] = 1;
+    }
+}
+
+/**
+ * SnakeEnv::UpdateGrid
+ * ============================
+ * Objective:
+ *   Bring game g's planes from the previous tick to this one.
+ *
+ * Approach:
+ *   A tick changes at most the old tail (vacated unless the snake grew or the head
+ *   took its place), the old and new head, and the fruits that were eaten and
+ *   respawned. Old fruit cells are cleared before the current ones are set, so a
+ *   fruit that respawned onto another fruit's old cell stays marked.
+ */
+void SnakeEnv::UpdateGrid(int game, uint8_t *obs) const
+{
+    size_t cells = (size_t)batch.BoardSize() * batch.BoardSize();
+    int head = batch.Head(game);
+    if (!batch.Occupied(game, prevTail[game]))
+        obs[prevTail[game]] = 0;
+    obs[head] = 1;
+    obs[cells + prevHead[game]] = 0;
+    obs[cells + head] = 1;
+
+    const int *before = &prevFruit[(size_t)game * BatchSimulation::fruitCount];
+    for (int k = 0; k < BatchSimulation::fruitCount; k++)
+    {
+        if (before[k] >= 0 && before[k] != batch.FruitCell(game, k))
+            obs[2 * cells + before[k]] = 0;
+    }
+    for (int k = 0; k < BatchSimulation::fruitCount; k++)
+    {
+        int fruit = batch.FruitCell(game, k);
+        if (fruit >= 0)
+            obs[2 * cells + fruit] = 1;
+    }
+}
+
+/**
+ * SnakeEnv::WriteView
+ * ============================
+ * Objective:
+ *   Write game g's egocentric planes: obstacles and fruit in the square of
+ *   viewSize cells centred on the head.
+ */
+void SnakeEnv::WriteView(int game, uint8_t *obs) const
+{
+    const int size = batch.BoardSize();
+    const size_t plane = (size_t)viewSize * viewSize;
+    memset(obs + plane, 0, plane);
+    int head = batch.Head(game);
+    int left = head % size - viewRadius;
+    int top = head / size - viewRadius;
+    int from = left < 0 ? -left : 0;                          // first column on the board
+    int to = left + viewSize > size ? size - left : viewSize; // one past the last
+    for (int vy = 0; vy < viewSize; vy++)
+    {
+        int y = top + vy;
+        uint8_t *row = obs + (size_t)vy * viewSize;
+        if (y < 0 || y >= size)
+        {
+            memset(row, 1, viewSize); // a row beyond the edge is all wall
+            continue;
+        }
+        memset(row, 1, from);
+        memset(row + to, 1, viewSize - to);
+        int index = y * size + left;
+        for (int vx = from; vx < to; vx++)
+            row[vx] = batch.Occupied(game, index + vx);
+    }
+    for (int k = 0; k < BatchSimulation::fruitCount; k++)
+    {
+        int fruit = batch.FruitCell(game, k);
+        int vx = fruit % size - left, vy = fruit / size - top;
+        if (fruit >= 0 && vx >= 0 && vy >= 0 && vx < viewSize && vy < viewSize)
+            obs[plane + (size_t)vy * viewSize + vx] = 1;
+    }
+}
+
+void SnakeEnv::Observe(int game, uint8_t *observations, bool full) const
+{
+    uint8_t *obs = observations + (size_t)game * obsBytes;
+    if (obsMode == SNAKE_ENV_OBS_VIEW)
+        WriteView(game, obs);
+    else if (full)
+        WriteGrid(game, obs);
+    else
+        UpdateGrid(game, obs);
+}
+
+extern "C" SnakeEnv *snake_env_create(int games, int board_size, int obs_mode, int view_radius, int threads)
+{
+    bool validMode = obs_mode == SNAKE_ENV_OBS_GRID || (obs_mode == SNAKE_ENV_OBS_VIEW && view_radius >= 1);
+    if (games <= 0 || board_size < 5 || board_size > 4096 || !validMode)
+        return nullptr;
+    return new SnakeEnv(games, board_size, obs_mode, view_radius, threads > 0 ? (unsigned int)threads : 0);
+}
+
+extern "C" size_t snake_env_observation_size(const SnakeEnv *env)
+{
+    return env->obsBytes;
+}
+
+/**
+ * snake_env_reset
+ * ============================
+ * Objective:
+ *   Restart every game and write full observations.
+ */
+extern "C" void snake_env_reset(SnakeEnv *env, const uint64_t *seeds, uint8_t *observations)
+{
+    env->pool.ParallelFor(env->batch.GameCount(), SnakeEnv::grain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t g = begin; g < end; g++)
+        {
+            if (seeds)
+                env->batch.ResetGame((int)g, seeds[g]);
+            else
+                env->batch.ResetGame((int)g); // carries on with the game's stream
+            env->Observe((int)g, observations, true);
+        }
+    });
+    env->lastObservations = observations;
+}
+
+/**
+ * snake_env_step
+ * ============================
+ * Objective:
+ *   Advance every game by one tick, fill rewards and dones, and restart the games
+ *   that ended.
+ *
+ * Approach:
+ *   Each chunk of games is stepped by one worker from start to finish: remember
+ *   the state, one BatchSimulation::StepActions call for the chunk (lane kernels
+ *   included), then rewards, auto-resets and observations game by game. Grid
+ *   observations are updated in place when the buffer is the one written last.
+ */
+extern "C" void snake_env_step(SnakeEnv *env, const int32_t *actions, uint8_t *observations, float *rewards,
+                               uint8_t *dones)
+{
+    bool incremental = observations == env->lastObservations;
+    env->pool.ParallelFor(env->batch.GameCount(), SnakeEnv::grain, [&](size_t begin, size_t end, unsigned int) {
+        BatchSimulation &batch = env->batch;
+        for (size_t g = begin; g < end; g++)
+            env->Remember((int)g);
+        batch.StepActions(begin, end, actions);
+        for (size_t g = begin; g < end; g++)
+        {
+            int game = (int)g;
+            float reward = (float)(batch.Score(game) - env->prevScore[g]);
+            bool done = !batch.Alive(game);
+            if (done)
+            {
+                if (!batch.Won(game))
+                    reward -= 1.0f;
+                env->lastScore[g] = batch.Score(game);
+                batch.ResetGame(game); // auto-reset on the game's own stream
+            }
+            rewards[g] = reward;
+            dones[g] = done ? 1 : 0;
+            env->Observe(game, observations, done || !incremental);
+        }
+    });
+    env->lastObservations = observations;
+}
+
+extern "C" void snake_env_last_scores(const SnakeEnv *env, int32_t *scores)
+{
+    memcpy(scores, env->lastScore.data(), env->lastScore.size() * sizeof(int32_t));
+}
+
+extern "C" void snake_env_destroy(SnakeEnv *env)
+{
+    delete env;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * =============================
+ * Training Environment Overview
+ * =============================
+ * A C interface to BatchSimulation for reinforcement learning, in the style of a
+ * Gym vector environment: one handle runs `games` independent snake games, and
+ * every call resets or steps all of them at once on a thread pool. Python loads
+ * it through ctypes (env/snake_env.py); any language with a C FFI can do the same.
+ *
+ * Actions are int32 per game: 0 right, 1 down, 2 left, 3 up. A reversal keeps the
+ * current heading. Rewards are float per game: +1 per fruit eaten, -1 on death.
+ * Dones are uint8 per game; a game that ended is restarted in the same call
+ * (auto-reset), so the observation it returns is the first one of the next round.
+ * A restarted game continues on its own random stream, so a run depends only on
+ * the seeds passed to snake_env_reset.
+ *
+ * Observations are uint8 (0 or 1) and written straight into a buffer the caller
+ * owns, snake_env_observation_size() bytes per game, games one after another:
+ *   - SNAKE_ENV_OBS_GRID: three board-sized planes, row-major: body (head
+ *     included), head, fruit. Only the cells a tick changed are rewritten, so a
+ *     step costs a few bytes per game instead of the whole board; this needs the
+ *     caller to pass the same, unmodified buffer as in the previous call (any
+ *     other pointer gets a full write).
+ *   - SNAKE_ENV_OBS_VIEW: two (2r+1) x (2r+1) planes centred on the head, r being
+ *     view_radius: obstacles (body and everything off the board), fruit.
+ *
+ * =============================
+ * Functions
+ * =============================
+ * **SnakeEnv *snake_env_create(int games, int board_size, int obs_mode, int view_radius, int threads)**
+ *   - Return: a new environment, or NULL for invalid arguments; threads <= 0
+ *             uses every hardware thread. Call snake_env_reset before stepping.
+ *
+ * **size_t snake_env_observation_size(const SnakeEnv *env)**
+ *   - Return: observation bytes per game.
+ *
+ * **void snake_env_reset(SnakeEnv *env, const uint64_t *seeds, uint8_t *observations)**
+ *   - Objective: restart every game, game g from seeds[g] (NULL: from its current
+ *                stream), and write the first observations.
+ *
+ * **void snake_env_step(SnakeEnv *env, const int32_t *actions, uint8_t *observations, float *rewards, uint8_t *dones)**
+ *   - Objective: advance every game by one tick.
+ *
+ * **void snake_env_last_scores(const SnakeEnv *env, int32_t *scores)**
+ *   - Objective: the score every game's most recently finished round ended with
+ *                (0 before its first), for logging episode returns.
+ *
+ * **void snake_env_destroy(SnakeEnv *env)**
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#define SNAKE_ENV_API __declspec(dllexport)
+#else
+#define SNAKE_ENV_API __attribute__((visibility("default")))
+#endif
+
+enum
+{
+    SNAKE_ENV_OBS_GRID = 0,
+    SNAKE_ENV_OBS_VIEW = 1
+};
+
+typedef struct SnakeEnv SnakeEnv;
+
+SNAKE_ENV_API SnakeEnv *snake_env_create(int games, int board_size, int obs_mode, int view_radius, int threads);
+SNAKE_ENV_API size_t snake_env_observation_size(const SnakeEnv *env);
+SNAKE_ENV_API void snake_env_reset(SnakeEnv *env, const uint64_t *seeds, uint8_t *observations);
+SNAKE_ENV_API void snake_env_step(SnakeEnv *env, const int32_t *actions, uint8_t *observations, float *rewards,
+                                  uint8_t *dones);
+SNAKE_ENV_API void snake_env_last_scores(const SnakeEnv *env, int32_t *scores);
+SNAKE_ENV_API void snake_env_destroy(SnakeEnv *env);
+
+#ifdef __cplusplus
+}
+#endif
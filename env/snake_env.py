@@ -0,0 +1,121 @@
+"""Vectorised snake environment for reinforcement learning.
+
+ctypes bindings for the C API in snake_env.h, shaped like a Gym vector
+environment: one SnakeVectorEnv runs num_envs games, and reset()/step() act on
+all of them in a single native call. Observations, rewards and dones live in
+numpy arrays owned by the environment; the library writes into them in place,
+so nothing is copied between C++ and Python. The returned arrays are therefore
+overwritten by the next call: copy them if they must be kept.
+
+    env = SnakeVectorEnv(4096, board_size=25)
+    obs = env.reset(seeds=range(4096))
+    obs, rewards, dones, infos = env.step(actions)  # actions: int32, 0 right, 1 down, 2 left, 3 up
+
+Games that end are restarted inside step() (auto-reset); their observation is
+then the first one of the new round, and infos["final_score"] holds the score
+the finished round ended with.
+
+The shared library is looked up next to this file, then in bin/Release and
+bin/Debug of the repository, unless a path is given.
+"""
+
+import ctypes
+import os
+import sys
+
+import numpy as np
+
+OBS_GRID = 0  # body, head and fruit planes of the whole board
+OBS_VIEW = 1  # obstacle and fruit planes of a square around the head
+
+
+def _library_name():
+    if sys.platform.startswith("win"):
+        return "snake_env.dll"
+    if sys.platform == "darwin":
+        return "libsnake_env.dylib"
+    return "libsnake_env.so"
+
+
+def _load(path=None):
+    if path is None:
+        here = os.path.dirname(os.path.abspath(__file__))
+        candidates = [os.path.join(here, _library_name())]
+        candidates += [os.path.join(here, "..", "bin", config, _library_name()) for config in ("Release", "Debug")]
+        path = next((c for c in candidates if os.path.exists(c)), candidates[0])
+    lib = ctypes.CDLL(path)
+    lib.snake_env_create.restype = ctypes.c_void_p
+    lib.snake_env_create.argtypes = [ctypes.c_int] * 5
+    lib.snake_env_observation_size.restype = ctypes.c_size_t
+    lib.snake_env_observation_size.argtypes = [ctypes.c_void_p]
+    lib.snake_env_reset.restype = None
+    lib.snake_env_reset.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p]
+    lib.snake_env_step.restype = None
+    lib.snake_env_step.argtypes = [ctypes.c_void_p] + [ctypes.c_void_p] * 4
+    lib.snake_env_last_scores.restype = None
+    lib.snake_env_last_scores.argtypes = [ctypes.c_void_p, ctypes.c_void_p]
+    lib.snake_env_destroy.restype = None
+    lib.snake_env_destroy.argtypes = [ctypes.c_void_p]
+    return lib
+
+
+class SnakeVectorEnv:
+    """num_envs snake games stepped together.
+
+    obs_mode is OBS_GRID (observations of shape (num_envs, 3, board, board)) or
+    OBS_VIEW (shape (num_envs, 2, 2r+1, 2r+1) with r = view_radius). threads=0
+    uses every hardware thread.
+    """
+
+    def __init__(self, num_envs, board_size=25, obs_mode=OBS_GRID, view_radius=5, threads=0, library=None):
+        self._lib = _load(library)
+        self._env = self._lib.snake_env_create(num_envs, board_size, obs_mode, view_radius, threads)
+        if not self._env:
+            raise ValueError("invalid environment parameters")
+        self.num_envs = num_envs
+        self.board_size = board_size
+        if obs_mode == OBS_GRID:
+            shape = (num_envs, 3, board_size, board_size)
+        else:
+            shape = (num_envs, 2, 2 * view_radius + 1, 2 * view_radius + 1)
+        assert int(np.prod(shape[1:])) == self._lib.snake_env_observation_size(self._env)
+        self.observations = np.zeros(shape, dtype=np.uint8)
+        self.rewards = np.zeros(num_envs, dtype=np.float32)
+        self.dones = np.zeros(num_envs, dtype=np.uint8)
+        self._scores = np.zeros(num_envs, dtype=np.int32)
+        self._actions = np.zeros(num_envs, dtype=np.int32)
+
+    def reset(self, seeds=None):
+        """Restart every game; seeds gives one seed per game (None: keep their streams)."""
+        seed_array = None
+        if seeds is not None:
+            seed_array = np.ascontiguousarray(np.asarray(list(seeds), dtype=np.uint64))
+            if seed_array.shape != (self.num_envs,):
+                raise ValueError("need one seed per game")
+        self._lib.snake_env_reset(self._env, None if seed_array is None else seed_array.ctypes.data,
+                                  self.observations.ctypes.data)
+        return self.observations
+
+    def step(self, actions):
+        """Advance every game by one tick; returns (observations, rewards, dones, infos)."""
+        actions = np.asarray(actions)
+        if actions.dtype == np.int32 and actions.flags["C_CONTIGUOUS"] and actions.shape == (self.num_envs,):
+            buffer = actions
+        else:
+            self._actions[:] = actions  # converts once instead of failing on int64 or views
+            buffer = self._actions
+        self._lib.snake_env_step(self._env, buffer.ctypes.data, self.observations.ctypes.data,
+                                 self.rewards.ctypes.data, self.dones.ctypes.data)
+        infos = {}
+        if self.dones.any():
+            self._lib.snake_env_last_scores(self._env, self._scores.ctypes.data)
+            infos["final_score"] = np.where(self.dones != 0, self._scores, -1)
+        return self.observations, self.rewards, self.dones.view(np.bool_), infos
+
+    def close(self):
+        if self._env:
+            self._lib.snake_env_destroy(self._env)
+            self._env = None
+
+    def __del__(self):
+        self.close()
@@ -0,0 +1,45 @@
+#!/bin/bash
+# Profile guided Perf build: instrument, train on snake_bench, rebuild with the profile.
+# Usage: ./pgo.sh [premake options...], e.g. ./pgo.sh --march=native
+# Replays (*.snkr) and broadcasts (*.snkb) in build/pgo/corpus are part of the training
+# set; drop last_replay.snkr there to train on real games. Needs clang and llvm-profdata.
+set -e
+
+PGO=build/pgo
+PROFDATA=${PROFDATA:-llvm-profdata}
+mkdir -p $PGO/corpus
+rm -rf $PGO/raw $PGO/snake.profdata
+
+# 1. instrumented snake_bench
+cd build
+./premake5 gmake --cc=clang --pgo=generate "$@"
+cd ..
+make clean config=perf_x64
+make config=perf_x64 snake_bench
+
+# 2. training: every policy, the batch kernels, many short games and the corpus
+BENCH=bin/Perf/snake_bench
+if [ -z "$(ls $PGO/corpus)" ]; then
+    $BENCH --policy autopilot --ticks 200000 --record $PGO/corpus/autopilot.snkr
+    $BENCH --policy greedy --ticks 200000 --broadcast $PGO/corpus/greedy.snkb
+fi
+for policy in random greedy autopilot hamilton; do
+    $BENCH --policy $policy --ticks 2000000
+done
+$BENCH --policy random --ticks 500000 --board 64
+$BENCH --games 2000
+$BENCH --batch 4096 --max-ticks 2000
+for file in $PGO/corpus/*.snkr; do
+    if [ -e "$file" ]; then $BENCH --replay "$file" --repeat 5; fi
+done
+for file in $PGO/corpus/*.snkb; do
+    if [ -e "$file" ]; then $BENCH --watch "$file" --repeat 200; fi
+done
+$PROFDATA merge -output=$PGO/snake.profdata $PGO/raw/*.profraw
+
+# 3. every project, optimised with the profile
+cd build
+./premake5 gmake --cc=clang --pgo=use "$@"
+cd ..
+make clean config=perf_x64
+make config=perf_x64
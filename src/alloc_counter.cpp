@@ -0,0 +1,119 @@
+#include "alloc_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef _MSC_VER
+#include <malloc.h> // _aligned_malloc
+#endif
+
+#ifdef SNAKE_COUNT_ALLOCATIONS
+
+// running total shared by every thread; relaxed ordering is enough for a counter
+static std::atomic<size_t> allocationCount{0};
+
+/**
+ * Global operator new / delete replacements
+ * =============================
+ * Objective:
+ *   Forward to malloc/free while incrementing allocationCount, so heap use on
+ *   any code path can be measured by sampling AllocationCount().
+ *
+ * Side Effects:
+ *   - Replaces the program-wide allocator entry points (debug builds only).
+ */
+void *operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
+
+/**
+ * Aligned operator new / delete replacements
+ * =============================
+ * Objective:
+ *   Count the over-aligned forms too; std::pmr::new_delete_resource() allocates
+ *   through them, so heap-backed pmr containers would otherwise go unseen.
+ *
+ * Approach:
+ *   aligned_alloc needs the size rounded up to the alignment; MSVC has no
+ *   aligned_alloc and pairs _aligned_malloc with _aligned_free instead.
+ */
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    size_t align = (size_t)alignment;
+    size_t rounded = ((size ? size : 1) + align - 1) / align * align;
+#ifdef _MSC_VER
+    void *ptr = _aligned_malloc(rounded, align);
+#else
+    void *ptr = std::aligned_alloc(align, rounded);
+#endif
+    if (ptr)
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+#ifdef _MSC_VER
+void operator delete(void *ptr, std::align_val_t) noexcept { _aligned_free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { _aligned_free(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept { _aligned_free(ptr); }
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept { _aligned_free(ptr); }
+#else
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+#endif
+
+size_t AllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+bool AllocationCountingEnabled()
+{
+    return true;
+}
+
+#else
+
+size_t AllocationCount()
+{
+    return 0; // counting compiled out
+}
+
+bool AllocationCountingEnabled()
+{
+    return false;
+}
+
+#endif
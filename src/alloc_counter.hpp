@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * =============================
+ * Allocation Counter Overview
+ * =============================
+ * Debug-only instrumentation that counts every call to the global
+ * `operator new`. The game uses it to prove that a simulation tick does
+ * not touch the heap: sample the counter before and after `Game::Update`
+ * and the difference is the number of allocations the tick made.
+ *
+ * Counting is compiled in only when **SNAKE_COUNT_ALLOCATIONS** is defined
+ * (the Debug configuration does this). Otherwise the replacement operators
+ * are not built and AllocationCount() always returns 0.
+ *
+ * =============================
+ * Functions
+ * =============================
+ * **size_t AllocationCount()**
+ *   - Return: total number of allocations made since program start.
+ *
+ * **bool AllocationCountingEnabled()**
+ *   - Return: true when the counting operators were compiled in.
+ */
+size_t AllocationCount();
+bool AllocationCountingEnabled();
@@ -0,0 +1,302 @@
+#include "arena.hpp"
+
+static const Cell headings[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}; // right, down, left, up
+
+/**
+ * Arena::Arena
+ * ============================
+ * Objective:
+ *   Build a size x size board, spawn `snakeCount` snakes and `fruitCount` fruits.
+ *
+ * Side Effects:
+ *   - Allocates the grid, the per-snake rings and the per-tick scratch lists once.
+ *     Later ticks allocate only when a body outgrows its ring.
+ *
+ * Approach:
+ *   Snakes spawn first, in index order, so the same seed always gives the same
+ *   start. Counts are clamped so every snake id and fruit index fits the owner tags.
+ */
+Arena::Arena(int size, int snakeCount, int fruitCount, uint64_t rngSeed)
+    : boardSize(size), seed(rngSeed), rng(rngSeed)
+{
+    snakeCount = snakeCount < OwnerGrid::maxSnakes ? snakeCount : OwnerGrid::maxSnakes;
+    fruitCount = fruitCount < OwnerGrid::fruitTag ? fruitCount : OwnerGrid::fruitTag - 1;
+
+    grid.Resize(boardSize);
+    snakes.resize(snakeCount);
+    fruits.resize(fruitCount);
+    next.resize(snakeCount);
+    dying.reserve(snakeCount);
+    eatenFruits.reserve(fruitCount);
+
+    for (int i = 0; i < snakeCount; i++)
+    {
+        snakes[i].body.Reserve(startCapacity);
+        Spawn(i);
+    }
+    for (int k = 0; k < fruitCount; k++)
+        PlaceFruit(k);
+}
+
+/**
+ * Arena::Step
+ * ============================
+ * Objective:
+ *   Advance every snake by one tick; see the overview in arena.hpp for the rules.
+ *
+ * Return Value:
+ *   - ArenaEvents → totals for the tick; ArenaSnake::ate/died tell who.
+ *
+ * Approach:
+ *   Tails go first, so no head is blocked by a cell that empties this tick. Heads
+ *   then enter in index order through Enter(), which resolves every conflict from
+ *   the grid alone. Deaths, fruit respawns and snake respawns are applied last, so
+ *   none of them can affect another snake's move within the same tick.
+ */
+ArenaEvents Arena::Step(const Cell *directions)
+{
+    ArenaEvents events;
+    const int count = snakes.size();
+    eatenFruits.clear();
+
+    for (int i = 0; i < count; i++)
+    {
+        ArenaSnake &snake = snakes[i];
+        snake.ate = false;
+        snake.died = false;
+        snake.cause = ArenaDeath::None;
+        snake.entered = false;
+        if (!snake.alive)
+            continue;
+        snake.direction = directions[i];
+        next[i] = snake.body[0] + snake.direction;
+        if (snake.growth > 0)
+        {
+            snake.growth--; // keep the tail this tick
+        }
+        else
+        {
+            grid.Set(snake.body.back(), OwnerGrid::unowned); // tail leaves its cell
+            snake.body.pop_back();
+        }
+    }
+
+    for (int i = 0; i < count; i++)
+        if (snakes[i].alive)
+            Enter(i, next[i], events);
+
+    for (int i : dying)
+        Kill(i);
+    events.deaths = dying.size();
+    dying.clear();
+
+    for (int k : eatenFruits)
+        PlaceFruit(k);
+
+    for (int i = 0; i < count; i++)
+        if (!snakes[i].alive)
+            Spawn(i); // stays dead while the board has no free cell
+    return events;
+}
+
+/**
+ * Arena::Enter
+ * ============================
+ * Objective:
+ *   Move snake `index`'s head onto `head`, or mark it dying if the cell is taken.
+ *
+ * Approach:
+ *   One owner lookup decides everything. A free cell or a fruit is entered. A cell
+ *   owned by a snake whose head entered it this tick is a head-on collision: both
+ *   die (the first one already occupies the cell, which Kill later frees). Any other
+ *   owned cell is a body, the snake's own included, so only the arriving snake dies.
+ *
+ * Variable definition and use:
+ *   owner - grid value at the head cell; other - index of the snake that owns it
+ */
+void Arena::Enter(int index, Cell head, ArenaEvents &events)
+{
+    ArenaSnake &snake = snakes[index];
+    if (!grid.InBounds(head))
+    {
+        dying.push_back(index); // left the board
+        snake.died = true;
+        snake.cause = ArenaDeath::Edge;
+        return;
+    }
+
+    uint16_t owner = grid.Owner(head);
+    if (owner != OwnerGrid::unowned && owner < OwnerGrid::fruitTag)
+    {
+        int other = owner - 1;
+        ArenaSnake &rival = snakes[other];
+        snake.cause = ArenaDeath::Body;
+        if (other != index && rival.entered && rival.body[0] == head)
+        {
+            if (!rival.died)
+            {
+                rival.died = true; // the first head on the cell dies as well
+                rival.cause = ArenaDeath::HeadOn;
+                dying.push_back(other);
+                events.headOnDeaths++;
+            }
+            snake.cause = ArenaDeath::HeadOn;
+            events.headOnDeaths++;
+        }
+        dying.push_back(index);
+        snake.died = true;
+        return;
+    }
+
+    if (owner >= OwnerGrid::fruitTag)
+    {
+        int fruit = owner - OwnerGrid::fruitTag;
+        fruits[fruit].active = false; // respawned at the end of the tick
+        eatenFruits.push_back(fruit);
+        snake.growth++;
+        snake.score++;
+        snake.ate = true;
+        events.fruitsEaten++;
+    }
+
+    if (snake.body.size() == snake.body.capacity())
+        snake.body.Grow(); // rare: amortised by doubling
+    snake.body.push_front(head);
+    grid.Set(head, (uint16_t)(index + 1));
+    snake.entered = true;
+}
+
+/**
+ * Arena::Kill
+ * ============================
+ * Objective:
+ *   Remove a dead snake from the board and keep its score in lastScore.
+ */
+void Arena::Kill(int index)
+{
+    ArenaSnake &snake = snakes[index];
+    for (unsigned int i = 0; i < snake.body.size(); i++)
+        grid.Set(snake.body[i], OwnerGrid::unowned);
+    snake.body.clear();
+    snake.lastScore = snake.score;
+    snake.score = 0;
+    snake.alive = false;
+}
+
+/**
+ * Arena::Spawn
+ * ============================
+ * Objective:
+ *   Put snake `index` on a random free cell with length 1, a random heading and
+ *   startLength - 1 ticks of growth.
+ *
+ * Return Value:
+ *   - bool → false when the board has no free cell (the snake stays dead).
+ */
+bool Arena::Spawn(int index)
+{
+    int freeCount = grid.FreeCount();
+    if (freeCount == 0)
+        return false;
+    ArenaSnake &snake = snakes[index];
+    Cell cell = grid.FreeCell(RandomInt(rng, 0, freeCount - 1));
+    snake.body.clear();
+    snake.body.push_front(cell);
+    grid.Set(cell, (uint16_t)(index + 1));
+    snake.direction = headings[RandomInt(rng, 0, 3)];
+    snake.growth = startLength - 1;
+    snake.alive = true;
+    return true;
+}
+
+/**
+ * Arena::PlaceFruit
+ * ============================
+ * Objective:
+ *   Move fruit `fruit` to a random free cell with a new visual; it stays inactive
+ *   when the board is full.
+ */
+void Arena::PlaceFruit(int fruit)
+{
+    Food &food = fruits[fruit];
+    food.textureIndex = RandomInt(rng, 0, Food::textureCount - 1);
+    int freeCount = grid.FreeCount();
+    food.active = freeCount > 0;
+    if (!food.active)
+        return;
+    food.position = grid.FreeCell(RandomInt(rng, 0, freeCount - 1));
+    grid.Set(food.position, (uint16_t)(OwnerGrid::fruitTag + fruit));
+}
+
+/**
+ * Arena::IsSafe
+ * ============================
+ * Objective:
+ *   Whether snake `index` survives stepping in `direction`, ignoring the other
+ *   heads' moves: the cell is on the board and free, a fruit, or its own tail
+ *   that leaves this tick.
+ */
+bool Arena::IsSafe(int index, Cell direction) const
+{
+    const ArenaSnake &snake = snakes[index];
+    Cell target = snake.body[0] + direction;
+    if (!grid.InBounds(target))
+        return false;
+    uint16_t owner = grid.Owner(target);
+    if (owner == OwnerGrid::unowned || owner >= OwnerGrid::fruitTag)
+        return true;
+    return owner == index + 1 && target == snake.body.back() && snake.growth == 0;
+}
+
+/**
+ * Arena::BotDirection
+ * ============================
+ * Objective:
+ *   Steer snake `index` toward its fruit (`index % fruits`), falling back to any
+ *   safe heading; O(1) per snake, so bots do not change the tick's complexity.
+ *
+ * Approach:
+ *   Try the axis that closes the distance to the fruit, then the other one, then
+ *   straight ahead, then the remaining headings from a random start. Reversals
+ *   are never chosen unless nothing else is left.
+ */
+Cell Arena::BotDirection(int index, SimRandom &botRng) const
+{
+    const ArenaSnake &snake = snakes[index];
+    if (!snake.alive)
+        return snake.direction;
+    Cell head = snake.body[0];
+    Cell current = snake.direction;
+    auto usable = [&](Cell d)
+    {
+        bool reversal = d.x == -current.x && d.y == -current.y && snake.body.size() > 1;
+        return !reversal && IsSafe(index, d);
+    };
+
+    if (!fruits.empty())
+    {
+        const Food &target = fruits[index % fruits.size()];
+        if (target.active)
+        {
+            if (target.position.x != head.x)
+            {
+                Cell d = {(int16_t)(target.position.x > head.x ? 1 : -1), 0};
+                if (usable(d))
+                    return d;
+            }
+            if (target.position.y != head.y)
+            {
+                Cell d = {0, (int16_t)(target.position.y > head.y ? 1 : -1)};
+                if (usable(d))
+                    return d;
+            }
+        }
+    }
+    if (usable(current))
+        return current;
+    int start = RandomInt(botRng, 0, 3);
+    for (int i = 0; i < 4; i++)
+        if (usable(headings[(start + i) % 4]))
+            return headings[(start + i) % 4];
+    return current; // boxed in
+}
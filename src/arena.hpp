@@ -0,0 +1,232 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "simulation.hpp"
+
+/**
+ * =============================
+ * Arena Overview
+ * =============================
+ * Many snakes (bots and players) on one board. Every snake writes its id into
+ * one shared OwnerGrid, so "did this head hit anybody?" is a single lookup
+ * whatever the number of snakes or segments, and a tick costs O(snakes) plus
+ * the cells of snakes that die or respawn.
+ *
+ * One tick, in a fixed order so its outcome never depends on iteration order:
+ *   1. every living snake computes its next head and, unless it is growing, frees
+ *      its tail; heads may therefore follow any tail, including another snake's;
+ *   2. heads enter in index order. A head off the board or on a body dies. A head
+ *      on a cell that another head entered this same tick kills both snakes (and
+ *      any third arriving later), whoever came first. A head on a fruit eats it;
+ *   3. dead snakes are removed, eaten fruits respawn, and dead snakes respawn at
+ *      a random free cell with length 1 and growth for startLength - 1 ticks.
+ *
+ * The arena keeps the Simulation's conventions: Cell coordinates, a seeded
+ * SimRandom for every random choice, storage reserved up front, and Food for the
+ * fruits so the renderer draws them the same way. Bodies start with a small ring
+ * and grow by doubling, since hundreds of snakes cannot each reserve a full board.
+ *
+ * =============================
+ * Arena (public API)
+ * =============================
+ * **Arena(int boardSize, int snakeCount, int fruitCount, uint64_t seed)**
+ *   - Objective: build the board and spawn every snake and fruit.
+ *
+ * **ArenaEvents Step(const Cell *directions)**
+ *   - Objective: advance one tick, snake i heading directions[i] (ignored for
+ *                snakes that are dead at the start of the tick).
+ *
+ * **Cell BotDirection(int index, SimRandom &botRng) const**
+ *   - Objective: a cheap bot move for snake `index`: chase fruit `index % fruits`,
+ *                avoid cells that are occupied or off the board.
+ */
+
+/*
+ * OwnerGrid class
+ * Objective: OccupancyGrid for many snakes: one 16-bit owner per cell instead of a bit,
+ *            with the same free-cell index for O(1) random spawns and the same
+ *            per-chunk versions for the renderer.
+ * Member variables:
+ *  - size       : cells per row/column.
+ *  - owner      : per cell, unowned (0), snake id + 1, or fruitTag + fruit index.
+ *  - freeCells, freeSlot, chunksPerRow, chunkVersion : as in OccupancyGrid.
+ * Member functions:
+ *  - Resize(), InBounds(), FreeCount(), FreeCell(), ChunkOf() : as in OccupancyGrid.
+ *  - Owner()  : owner value of an in-bounds cell.
+ *  - Set()    : change the owner of a cell, keeping the free list in step.
+ */
+class OwnerGrid
+{
+public:
+    static constexpr uint16_t unowned = 0;
+    static constexpr uint16_t fruitTag = 0x8000;         // owner >= fruitTag is fruit (owner - fruitTag)
+    static constexpr int maxSnakes = fruitTag - 1;       // ids 1 .. maxSnakes
+    static constexpr int chunkShift = OccupancyGrid::chunkShift;
+    static constexpr int chunkCells = OccupancyGrid::chunkCells;
+
+    int size = 0;
+    std::vector<uint16_t> owner;        // row-major (index = y * size + x)
+    std::vector<int> freeCells;         // dense list of free cell indices
+    std::vector<int> freeSlot;          // freeSlot[index] = position of index inside freeCells
+    int chunksPerRow = 0;
+    std::vector<uint32_t> chunkVersion; // incremented whenever a cell of the chunk changes
+
+    /*
+     * Resize
+     * Objective: allocate a size x size board with every cell free.
+     */
+    void Resize(int boardSize)
+    {
+        size = boardSize;
+        owner.assign(size * size, unowned);
+        freeCells.resize(size * size);
+        freeSlot.resize(size * size);
+        for (int i = 0; i < size * size; i++)
+        {
+            freeCells[i] = i;
+            freeSlot[i] = i;
+        }
+        chunksPerRow = (size + chunkCells - 1) >> chunkShift;
+        chunkVersion.assign(chunksPerRow * chunksPerRow, 1); // renderers start from 0, see BoardRenderer
+    }
+
+    bool InBounds(Cell cell) const
+    {
+        return cell.x >= 0 && cell.y >= 0 && cell.x < size && cell.y < size;
+    }
+
+    uint16_t Owner(Cell cell) const
+    {
+        return owner[cell.y * size + cell.x];
+    }
+
+    int ChunkOf(Cell cell) const
+    {
+        return (cell.y >> chunkShift) * chunksPerRow + (cell.x >> chunkShift);
+    }
+
+    /*
+     * Set
+     * Objective: give an in-bounds cell a new owner (unowned, a snake or a fruit).
+     * Side effects: mutates the owner array, the free-cell index and the chunk version
+     *
+     * Approach: the free list only changes when the cell turns free or stops being
+     * free; both are the O(1) swap-remove / append of OccupancyGrid::Set.
+     */
+    void Set(Cell cell, uint16_t value)
+    {
+        int index = cell.y * size + cell.x;
+        uint16_t previous = owner[index];
+        if (previous == value)
+            return;
+        owner[index] = value;
+        chunkVersion[ChunkOf(cell)]++;
+
+        if (previous == unowned)
+        {
+            int last = freeCells.back(); // swap-remove from the free list
+            freeCells[freeSlot[index]] = last;
+            freeSlot[last] = freeSlot[index];
+            freeCells.pop_back();
+        }
+        else if (value == unowned)
+        {
+            freeSlot[index] = freeCells.size(); // capacity is size*size, never reallocates
+            freeCells.push_back(index);
+        }
+    }
+
+    int FreeCount() const
+    {
+        return freeCells.size();
+    }
+
+    Cell FreeCell(int i) const
+    {
+        int index = freeCells[i];
+        return Cell{(int16_t)(index % size), (int16_t)(index / size)};
+    }
+};
+
+/*
+ * ArenaDeath enum
+ * Objective: why a snake died in the last tick, so front ends can tell edge deaths
+ *            from collisions.
+ */
+enum class ArenaDeath : uint8_t
+{
+    None,   // alive, or spawned this tick
+    Edge,   // the head left the board
+    Body,   // the head entered a body, its own or another snake's
+    HeadOn, // two or more heads entered the same cell
+};
+
+/*
+ * ArenaSnake struct
+ * Objective: one snake of the arena.
+ * Member variables:
+ *  - body       : segments head first; grows on demand.
+ *  - direction  : heading used for the last tick.
+ *  - growth     : ticks left during which the tail stays put.
+ *  - score      : fruits eaten since the last spawn; lastScore holds the score at death.
+ *  - alive      : false between death and respawn (only while the board is full).
+ *  - ate, died  : what happened to this snake in the last tick.
+ *  - cause      : why it died in the last tick (None unless died).
+ *  - entered    : its head entered a cell in the current tick (head-on detection).
+ */
+struct ArenaSnake
+{
+    SnakeBody body;
+    Cell direction = {1, 0};
+    int growth = 0;
+    int score = 0;
+    int lastScore = 0;
+    bool alive = false;
+    bool ate = false;
+    bool died = false;
+    ArenaDeath cause = ArenaDeath::None;
+    bool entered = false;
+};
+
+/*
+ * ArenaEvents struct
+ * Objective: totals over one arena tick; per-snake outcomes are in ArenaSnake.
+ */
+struct ArenaEvents
+{
+    int fruitsEaten = 0;
+    int deaths = 0;
+    int headOnDeaths = 0; ///< deaths from two or more heads entering one cell
+};
+
+class Arena
+{
+public:
+    static constexpr int startLength = 3;    // length a snake reaches after spawning
+    static constexpr int startCapacity = 64; // initial body ring; grows by doubling
+
+    const int boardSize;
+    const uint64_t seed;
+    OwnerGrid grid;
+    std::vector<ArenaSnake> snakes; // id i is stored in the grid as i + 1
+    std::vector<Food> fruits;       // fruit k is stored in the grid as fruitTag + k
+
+    Arena(int size, int snakeCount, int fruitCount, uint64_t rngSeed);
+
+    ArenaEvents Step(const Cell *directions);
+    Cell BotDirection(int index, SimRandom &botRng) const;
+    bool IsSafe(int index, Cell direction) const;
+    const std::vector<int> &EatenFruits() const { return eatenFruits; } ///< eaten (and respawned) in the last tick
+
+private:
+    void Enter(int index, Cell head, ArenaEvents &events);
+    void Kill(int index);
+    bool Spawn(int index);
+    void PlaceFruit(int fruit);
+
+    SimRandom rng;                // spawn positions, headings and fruit visuals
+    std::vector<Cell> next;       // per snake, the head cell of the current tick
+    std::vector<int> dying;       // snakes that die this tick, in the order they were hit
+    std::vector<int> eatenFruits; // fruits eaten this tick, respawned at its end; kept until the next Step
+};
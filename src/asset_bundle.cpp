@@ -0,0 +1,153 @@
+#include "asset_bundle.hpp"
+
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * AssetBundle::~AssetBundle
+ * ============================
+ * Objective:
+ *   Unmap the bundle if it is still open.
+ */
+AssetBundle::~AssetBundle()
+{
+    Close();
+}
+
+/**
+ * AssetBundle::Open
+ * ============================
+ * Objective:
+ *   Map a pack file read-only and check that it can be trusted before any entry
+ *   is handed out.
+ *
+ * Input:
+ *   - const char *path → pack file written by asset_packer.
+ *
+ * Return Value:
+ *   - bool → false when the file is missing, cannot be mapped, or fails validation.
+ *
+ * Approach:
+ *   mmap (or CreateFileMapping on Windows) the whole file; then verify the magic,
+ *   version, that the entry table fits, and that every entry's data range lies
+ *   inside the file and every name is terminated. Nothing is copied or decoded.
+ */
+bool AssetBundle::Open(const char *path)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(PackHeader))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    base = (const unsigned char *)view;
+    length = (size_t)fileSize.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(PackHeader))
+    {
+        close(fd);
+        return false;
+    }
+    void *view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping keeps the file referenced
+    if (view == MAP_FAILED)
+        return false;
+    base = (const unsigned char *)view;
+    length = (size_t)info.st_size;
+#endif
+
+    const PackHeader *header = (const PackHeader *)base;
+    bool valid = memcmp(header->magic, "SNKA", 4) == 0 && header->version == packVersion &&
+                 header->entryCount <= (length - sizeof(PackHeader)) / sizeof(PackEntry);
+    const PackEntry *entries = (const PackEntry *)(base + sizeof(PackHeader));
+    for (uint32_t i = 0; valid && i < header->entryCount; i++)
+    {
+        const PackEntry &entry = entries[i];
+        valid = memchr(entry.name, 0, packNameLength) != nullptr &&
+                entry.offset <= length && entry.size <= length - entry.offset;
+    }
+    if (!valid)
+        Close();
+    return valid;
+}
+
+/**
+ * AssetBundle::Close
+ * ============================
+ * Objective:
+ *   Unmap the file; every pointer returned by Data() becomes invalid.
+ */
+void AssetBundle::Close()
+{
+    if (!base)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle((HANDLE)mappingHandle);
+    CloseHandle((HANDLE)fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap((void *)base, length);
+#endif
+    base = nullptr;
+    length = 0;
+}
+
+/**
+ * AssetBundle::Find
+ * ============================
+ * Objective:
+ *   Look an entry up by name.
+ *
+ * Approach:
+ *   Linear scan; a bundle holds a handful of entries and lookups happen only at startup.
+ */
+const PackEntry *AssetBundle::Find(const char *name) const
+{
+    if (!base)
+        return nullptr;
+    const PackHeader *header = (const PackHeader *)base;
+    const PackEntry *entries = (const PackEntry *)(base + sizeof(PackHeader));
+    for (uint32_t i = 0; i < header->entryCount; i++)
+    {
+        if (strcmp(entries[i].name, name) == 0)
+            return &entries[i];
+    }
+    return nullptr;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * =============================
+ * Asset Bundle Overview
+ * =============================
+ * assets.pak is written at build time by tools/asset_packer and holds every
+ * startup asset already decoded into the form the GPU/audio upload wants:
+ * RGBA8 pixels for images (buttons pre-scaled, food tiles pre-packed into the
+ * atlas) and raw PCM for sounds. At run time the file is memory-mapped and the
+ * game points raylib Image/Wave structs straight into the mapping, so cold start
+ * is one mmap plus the uploads, with no PNG/MP3 decode and no resize.
+ *
+ * =============================
+ * File layout (little endian, native struct layout)
+ * =============================
+ *   PackHeader                      magic "SNKA", version, entry count
+ *   PackEntry[entryCount]           name, kind, data offset/size, kind fields
+ *   data blobs                      each starting on a packAlignment boundary
+ *
+ * Entry names are the source path, with "@scale" appended for pre-scaled images
+ * (see AssetKey in assets.hpp). This header is raylib-free so the platform
+ * mapping code can include OS headers without name clashes.
+ *
+ * =============================
+ * AssetBundle (public API)
+ * =============================
+ * **bool Open(const char *path)**
+ *   - Objective: map the file read-only and validate header and entry table.
+ *   - Return: false when the file is missing or malformed (the bundle stays closed).
+ *
+ * **const PackEntry *Find(const char *name) const**
+ *   - Return: the entry with that name, or nullptr.
+ *
+ * **const void *Data(const PackEntry &entry) const**
+ *   - Return: pointer to the entry's bytes inside the mapping; valid until Close().
+ */
+
+static const uint32_t packVersion = 1;
+static const uint32_t packAlignment = 64;  // blobs start on cache-line boundaries
+static const int packNameLength = 48;
+
+enum PackKind : uint32_t
+{
+    PackImage = 1, ///< fields: width, height, raylib PixelFormat, mipmaps
+    PackWave = 2,  ///< fields: frameCount, sampleRate, sampleSize, channels
+};
+
+struct PackHeader
+{
+    char magic[4];       ///< "SNKA"
+    uint32_t version;    ///< packVersion
+    uint32_t entryCount; ///< number of PackEntry records after the header
+    uint32_t reserved;   ///< zero
+};
+
+struct PackEntry
+{
+    char name[packNameLength]; ///< NUL-terminated lookup key
+    uint32_t kind;             ///< PackKind
+    uint32_t fields[4];        ///< kind-specific values, see PackKind
+    uint32_t reserved;         ///< zero
+    uint64_t offset;           ///< start of the data from the beginning of the file
+    uint64_t size;             ///< data bytes
+};
+
+static_assert(sizeof(PackHeader) == 16, "pack header layout");
+static_assert(sizeof(PackEntry) == 88, "pack entry layout");
+
+class AssetBundle
+{
+public:
+    AssetBundle() = default;
+    ~AssetBundle();
+    AssetBundle(const AssetBundle &) = delete; // owns the mapping
+    AssetBundle &operator=(const AssetBundle &) = delete;
+
+    bool Open(const char *path);
+    void Close();
+    bool IsOpen() const { return base != nullptr; }
+    const PackEntry *Find(const char *name) const;
+    const void *Data(const PackEntry &entry) const { return base + entry.offset; }
+
+private:
+    const unsigned char *base = nullptr; // start of the mapping
+    size_t length = 0;                   // mapped bytes
+    void *fileHandle = nullptr;          // Windows only: file and mapping handles
+    void *mappingHandle = nullptr;
+};
@@ -0,0 +1,198 @@
+#include "assets.hpp"
+
+#include <cstdio>
+
+#include "simulation.hpp" // Food::textureCount
+
+/*
+ * AssetKey
+ * Objective: build the bundle entry name of an image at a given scale.
+ * Output: writes a NUL-terminated name into out
+ */
+void AssetKey(char *out, size_t size, const char *path, float scale)
+{
+    if (scale == 1.0f)
+        snprintf(out, size, "%s", path);
+    else
+        snprintf(out, size, "%s@%.2f", path, scale);
+}
+
+/*
+ * LoadScaledImage
+ * Objective: CPU-side preparation of an image: decode, resize, convert to RGBA8.
+ * Return value: Image - owned by the caller (UnloadImage)
+ */
+Image LoadScaledImage(const char *path, float scale)
+{
+    Image image = LoadImage(path);
+    if (scale != 1.0f)
+        ImageResize(&image, (int)(image.width * scale), (int)(image.height * scale));
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    return image;
+}
+
+/*
+ * BuildFoodAtlas
+ * Objective: pack graphics/food1..N.png left to right into one RGBA8 image.
+ * Return value: Image - tile i occupies x in [i * width / N, (i + 1) * width / N)
+ *
+ * Approach: tiles are sized to the largest food image so differently sized
+ * images still land in equal columns; smaller ones sit in the top-left corner.
+ */
+Image BuildFoodAtlas()
+{
+    Image tiles[Food::textureCount];
+    int tileWidth = 0;
+    int tileHeight = 0;
+    for (int i = 0; i < Food::textureCount; i++)
+    {
+        char path[32];
+        snprintf(path, sizeof(path), "graphics/food%i.png", i + 1); // not TextFormat: may run off the main thread
+        tiles[i] = LoadImage(path);
+        if (tiles[i].width > tileWidth)
+            tileWidth = tiles[i].width;
+        if (tiles[i].height > tileHeight)
+            tileHeight = tiles[i].height;
+    }
+
+    Image atlas = GenImageColor(tileWidth * Food::textureCount, tileHeight, BLANK);
+    for (int i = 0; i < Food::textureCount; i++)
+    {
+        Rectangle source = {0, 0, (float)tiles[i].width, (float)tiles[i].height};
+        Rectangle target = {(float)(i * tileWidth), 0, (float)tiles[i].width, (float)tiles[i].height};
+        ImageDraw(&atlas, tiles[i], source, target, WHITE);
+        UnloadImage(tiles[i]); // CPU copy no longer needed
+    }
+    return atlas;
+}
+
+/*
+ * ImageFromBundle
+ * Objective: view a packed image inside the mapping.
+ * Return value: bool - false when the bundle has no usable image entry of that name
+ *
+ * Approach: the Image struct points into the mapped file; uploading only reads it,
+ * so the pixels go from page cache to the GPU without a copy in between (and the
+ * Image must not be unloaded).
+ */
+static bool ImageFromBundle(const AssetBundle *bundle, const char *name, Image &image)
+{
+    const PackEntry *entry = bundle ? bundle->Find(name) : nullptr;
+    if (!entry || entry->kind != PackImage)
+        return false;
+    Image view = {(void *)bundle->Data(*entry), (int)entry->fields[0], (int)entry->fields[1],
+                  (int)entry->fields[3], (int)entry->fields[2]};
+    if ((size_t)GetPixelDataSize(view.width, view.height, view.format) > entry->size)
+        return false; // truncated entry; decode the source instead
+    image = view;
+    return true;
+}
+
+/*
+ * DecodeImageAsset
+ * Objective: pixels of `path` at `scale`, from the bundle or decoded on the spot.
+ */
+Image DecodeImageAsset(const AssetBundle *bundle, const char *path, float scale, bool &owned)
+{
+    char key[packNameLength];
+    AssetKey(key, sizeof(key), path, scale);
+    Image image;
+    owned = !ImageFromBundle(bundle, key, image);
+    if (owned)
+        image = LoadScaledImage(path, scale);
+    return image;
+}
+
+/*
+ * DecodeFoodAtlas
+ * Objective: the food atlas pixels, from the bundle or built from the PNGs.
+ */
+Image DecodeFoodAtlas(const AssetBundle *bundle, bool &owned)
+{
+    Image image;
+    owned = !ImageFromBundle(bundle, foodAtlasName, image);
+    if (owned)
+        image = BuildFoodAtlas();
+    return image;
+}
+
+/*
+ * DecodeSoundAsset
+ * Objective: PCM of `path`, pre-decoded in the bundle or decoded from the source file.
+ *
+ * Approach: like ImageFromBundle, a bundled Wave points into the mapping;
+ * LoadSoundFromWave copies it into the audio buffer.
+ */
+Wave DecodeSoundAsset(const AssetBundle *bundle, const char *path, bool &owned)
+{
+    const PackEntry *entry = bundle ? bundle->Find(path) : nullptr;
+    if (entry && entry->kind == PackWave)
+    {
+        Wave view = {entry->fields[0], entry->fields[1], entry->fields[2], entry->fields[3],
+                     (void *)bundle->Data(*entry)};
+        if ((uint64_t)view.frameCount * view.channels * (view.sampleSize / 8) <= entry->size)
+        {
+            owned = false;
+            return view;
+        }
+    }
+    owned = true;
+    return LoadMixerWave(path);
+}
+
+/*
+ * LoadMixerWave
+ * Objective: decode a sound file into the mixer format (what the pack stores).
+ * Return value: Wave - owned by the caller (UnloadWave); empty when the file failed
+ */
+Wave LoadMixerWave(const char *path)
+{
+    Wave wave = LoadWave(path);
+    if (wave.data)
+        WaveFormat(&wave, mixerSampleRate, 32, mixerChannels);
+    return wave;
+}
+
+/*
+ * DecodeAudioClip
+ * Objective: owned mixer-format PCM of `path` for AudioMixer.
+ * Return value: AudioClip - free with UnloadAudioClip
+ *
+ * Approach: bundled PCM is already in the mixer format and only copied out of the
+ * mapping; WaveFormat is a no-op then and only converts an old or foreign pack.
+ */
+AudioClip DecodeAudioClip(const AssetBundle *bundle, const char *path)
+{
+    bool owned;
+    Wave wave = DecodeSoundAsset(bundle, path, owned);
+    if (!owned)
+        wave = WaveCopy(wave); // the mapping closes once loading is done
+    if (!wave.data)
+        return AudioClip{nullptr, 0};
+    WaveFormat(&wave, mixerSampleRate, 32, mixerChannels);
+    return AudioClip{(float *)wave.data, wave.frameCount};
+}
+
+/*
+ * UnloadAudioClip
+ * Objective: release the samples allocated by DecodeAudioClip.
+ */
+void UnloadAudioClip(AudioClip clip)
+{
+    if (clip.samples)
+        UnloadWave(Wave{clip.frameCount, (unsigned int)mixerSampleRate, 32, (unsigned int)mixerChannels, clip.samples});
+}
+
+/*
+ * LoadTextureAsset
+ * Objective: texture of `path` drawn at `scale`, decoded and uploaded synchronously.
+ */
+Texture2D LoadTextureAsset(const AssetBundle *bundle, const char *path, float scale)
+{
+    bool owned;
+    Image image = DecodeImageAsset(bundle, path, scale, owned);
+    Texture2D texture = LoadTextureFromImage(image);
+    if (owned)
+        UnloadImage(image);
+    return texture;
+}
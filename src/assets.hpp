@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <raylib.h>
+
+#include "asset_bundle.hpp"
+
+/**
+ * =============================
+ * Assets Overview
+ * =============================
+ * One place that knows how each startup asset is prepared, used both by the game
+ * and by tools/asset_packer so the two can never disagree:
+ *
+ *  - packedImages : button images and the scale main() draws them at.
+ *  - packedSounds : sound effects, stored already converted to the mixer format
+ *                  (mixerSampleRate, 32-bit float, mixerChannels).
+ *  - the food atlas: food1..food4.png side by side (see BuildFoodAtlas).
+ *
+ * The Decode*Asset functions return the pixels/PCM straight from an open
+ * AssetBundle when it has a matching entry and otherwise decode the source file,
+ * so the game still runs from a checkout without assets.pak (or with a stale one
+ * that lacks an entry). They touch no GPU or audio device and are safe to call
+ * from a worker thread (see AsyncLoader).
+ *
+ * =============================
+ * Functions
+ * =============================
+ * **void AssetKey(char *out, size_t size, const char *path, float scale)**
+ *   - Objective: bundle entry name for an image at a scale ("path@0.65"), or the
+ *                plain path when scale is 1.
+ *
+ * **Image LoadScaledImage(const char *path, float scale)**
+ *   - Objective: decode and resize on the CPU, converted to RGBA8.
+ *
+ * **Image BuildFoodAtlas()**
+ *   - Objective: decode the food images and pack them into one row (RGBA8).
+ *
+ * **Image DecodeImageAsset(const AssetBundle *bundle, const char *path, float scale, bool &owned)**
+ * **Image DecodeFoodAtlas(const AssetBundle *bundle, bool &owned)**
+ * **Wave DecodeSoundAsset(const AssetBundle *bundle, const char *path, bool &owned)**
+ *   - Objective: CPU-ready data, from the bundle when possible. `bundle` may be null.
+ *   - Output: owned → true when the result was decoded and must be unloaded by the
+ *             caller; false when it points into the bundle mapping (keep the bundle
+ *             open until it has been uploaded, and never unload it).
+ *
+ * **AudioClip DecodeAudioClip(const AssetBundle *bundle, const char *path)**
+ *   - Objective: the sound as an owned AudioClip in the mixer format; the PCM is
+ *                copied out of the bundle, so the bundle may close afterwards.
+ *
+ * **void UnloadAudioClip(AudioClip clip)**
+ *   - Objective: free a clip's samples (no-op for an empty clip).
+ *
+ * **Wave LoadMixerWave(const char *path)**
+ *   - Objective: decode a sound file and convert it to the mixer format.
+ *
+ * **Texture2D LoadTextureAsset(const AssetBundle *bundle, const char *path, float scale)**
+ *   - Objective: synchronous decode + upload; needs an open window.
+ */
+
+struct ImageAssetSpec
+{
+    const char *path; ///< source image, relative to the working directory
+    float scale;      ///< scale it is drawn at
+};
+
+static const ImageAssetSpec packedImages[] = {
+    {"graphics/start_button.png", 0.65f},
+    {"graphics/exit_button.png", 0.65f},
+    {"graphics/restart.png", 1.5f},
+};
+
+/*
+ * AudioClip
+ * Objective: a sound effect ready for AudioMixer: interleaved 32-bit float PCM at
+ *            mixerSampleRate with mixerChannels channels (null samples when absent).
+ */
+struct AudioClip
+{
+    float *samples;          ///< frameCount * mixerChannels samples, owned by the clip
+    unsigned int frameCount; ///< length in frames
+};
+
+static const int mixerSampleRate = 44100; ///< output rate of AudioMixer and of every clip
+static const int mixerChannels = 1;       ///< effects are mixed in mono
+
+static const char *const packedSounds[] = {"sounds/wall.mp3", "sounds/eat.mp3"};
+static const char *const foodAtlasName = "food_atlas";
+
+void AssetKey(char *out, size_t size, const char *path, float scale);
+Image LoadScaledImage(const char *path, float scale);
+Image BuildFoodAtlas();
+Image DecodeImageAsset(const AssetBundle *bundle, const char *path, float scale, bool &owned);
+Image DecodeFoodAtlas(const AssetBundle *bundle, bool &owned);
+Wave DecodeSoundAsset(const AssetBundle *bundle, const char *path, bool &owned);
+Wave LoadMixerWave(const char *path);
+AudioClip DecodeAudioClip(const AssetBundle *bundle, const char *path);
+void UnloadAudioClip(AudioClip clip);
+Texture2D LoadTextureAsset(const AssetBundle *bundle, const char *path, float scale);
@@ -0,0 +1,198 @@
+#include "async_loader.hpp"
+
+#include "assets.hpp"
+
+/**
+ * AsyncLoader::~AsyncLoader
+ * ============================
+ * Objective:
+ *   Stop the worker and release every decoded asset that was never delivered,
+ *   e.g. when the window is closed while loading.
+ */
+AsyncLoader::~AsyncLoader()
+{
+    Cancel();
+    for (int i = delivered; i < decoded; i++)
+    {
+        Job &job = jobs[i];
+        if (job.kind == SoundJob)
+            UnloadAudioClip(job.clip); // no-op for resident jobs
+        else if (job.owned)
+            UnloadImage(job.image);
+    }
+}
+
+/**
+ * AsyncLoader::Cancel
+ * ============================
+ * Objective:
+ *   Stop decoding after the current job and wait for the worker to exit; decoded
+ *   but undelivered assets are freed by the destructor.
+ */
+void AsyncLoader::Cancel()
+{
+    stop = true;
+    if (worker.joinable())
+        worker.join();
+}
+
+/**
+ * AsyncLoader::Queue
+ * ============================
+ * Objective:
+ *   Find the job already queued for `key`, or append a new one.
+ *
+ * Return Value:
+ *   - Job* → the job the caller attaches its callback to.
+ *
+ * Approach:
+ *   A repeated key shares the first job, so a file requested by several owners is
+ *   decoded and uploaded once. A key the cache already holds becomes a resident
+ *   job that the worker skips and Pump() answers with another reference.
+ */
+AsyncLoader::Job *AsyncLoader::Queue(JobKind kind, const char *key, const char *path, float scale)
+{
+    for (Job &job : jobs)
+    {
+        if (job.kind == kind && job.key == key)
+            return &job;
+    }
+
+    jobs.push_back(Job{kind, key, path, scale, {}, {}, {}, {}});
+    Job &job = jobs.back();
+    if (kind == SoundJob)
+        job.sound = cache.FindSound(key);
+    else
+        job.texture = cache.FindTexture(key);
+    return &job;
+}
+
+/**
+ * AsyncLoader::AddImage / AddFoodAtlas / AddSound
+ * ============================
+ * Objective:
+ *   Queue a request. `path` must outlive the loader (string literals in practice).
+ */
+void AsyncLoader::AddImage(const char *path, float scale, TextureReady ready)
+{
+    char key[packNameLength];
+    AssetKey(key, sizeof(key), path, scale);
+    Queue(ImageJob, key, path, scale)->textures.push_back(std::move(ready));
+}
+
+void AsyncLoader::AddFoodAtlas(TextureReady ready)
+{
+    Queue(AtlasJob, foodAtlasName, nullptr, 1.0f)->textures.push_back(std::move(ready));
+}
+
+void AsyncLoader::AddSound(const char *path, SoundReady ready)
+{
+    Queue(SoundJob, path, path, 1.0f)->sounds.push_back(std::move(ready));
+}
+
+/**
+ * AsyncLoader::Start
+ * ============================
+ * Objective:
+ *   Launch the decode thread; the job list is read-only from here on.
+ */
+void AsyncLoader::Start(const AssetBundle *bundle)
+{
+    worker = std::thread(&AsyncLoader::Work, this, bundle);
+}
+
+/**
+ * AsyncLoader::Work
+ * ============================
+ * Objective:
+ *   Worker thread body: open the audio device if any sound was requested, then
+ *   decode the jobs in order.
+ *
+ * Approach:
+ *   Opening the audio device is the slowest single startup step and needs no GL
+ *   context, so it happens here too (AudioMixer opens its stream on it later). Each decoded job is published by bumping
+ *   `decoded` under the mutex; the main thread only reads jobs below that index.
+ */
+void AsyncLoader::Work(const AssetBundle *bundle)
+{
+    for (const Job &job : jobs)
+    {
+        if (job.kind == SoundJob)
+        {
+            InitAudioDevice(); // once; CloseAudioDevice stays with the owner of the sounds
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < jobs.size() && !stop; i++)
+    {
+        Job &job = jobs[i];
+        if (job.texture || job.sound)
+            ; // shared with an entry the cache already holds
+        else if (job.kind == ImageJob)
+            job.image = DecodeImageAsset(bundle, job.path, job.scale, job.owned);
+        else if (job.kind == AtlasJob)
+            job.image = DecodeFoodAtlas(bundle, job.owned);
+        else
+            job.clip = DecodeAudioClip(bundle, job.path);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        decoded = (int)i + 1;
+    }
+}
+
+/**
+ * AsyncLoader::Pump
+ * ============================
+ * Objective:
+ *   Main-thread half of loading: upload decoded assets into the cache and hand a
+ *   handle to every requester.
+ *
+ * Input:
+ *   - int maxUploads → per-frame budget, so one frame never pays for every upload.
+ *
+ * Side Effects:
+ *   - Creates textures; moves clips into the cache; runs job callbacks; frees decoded images.
+ *
+ * Approach:
+ *   The upload is adopted by the cache, then each requester gets its own reference
+ *   through Find; the job's own handle is dropped once everyone has theirs.
+ */
+void AsyncLoader::Pump(int maxUploads)
+{
+    if (stop)
+        return; // cancelled: the destructor owns what is left
+    int ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready = decoded;
+    }
+
+    for (int uploads = 0; delivered < ready && uploads < maxUploads; uploads++)
+    {
+        Job &job = jobs[delivered];
+        if (job.kind == SoundJob)
+        {
+            if (!job.sound)
+            {
+                job.sound = cache.AdoptSound(job.key.c_str(), job.clip); // already in its final form
+            }
+            for (SoundReady &callback : job.sounds)
+                callback(cache.FindSound(job.key.c_str()));
+            job.sound.Reset();
+        }
+        else
+        {
+            if (!job.texture)
+            {
+                job.texture = cache.AdoptTexture(job.key.c_str(), LoadTextureFromImage(job.image));
+                if (job.owned)
+                    UnloadImage(job.image);
+            }
+            for (TextureReady &callback : job.textures)
+                callback(cache.FindTexture(job.key.c_str()));
+            job.texture.Reset();
+        }
+        delivered++;
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <raylib.h>
+
+#include "resource_cache.hpp"
+
+class AssetBundle;
+
+/**
+ * =============================
+ * Class Overview
+ * =============================
+ * The **AsyncLoader** class moves startup asset work off the first frame. A
+ * worker thread opens the audio device and decodes every requested image and
+ * sound (from the asset bundle when it has them, otherwise from the source
+ * files); sounds come out as finished AudioClips. The main thread calls Pump()
+ * once per frame and performs the GPU texture uploads, a bounded number per
+ * frame, so the window and menu appear immediately and never stall on a long
+ * upload.
+ *
+ * Uploaded assets go into the ResourceCache and requesters receive handles. A
+ * key that is already resident, or already queued, is not decoded again: the
+ * request just waits for (or immediately gets) a reference to the same entry.
+ *
+ * raylib's GPU calls must run on the thread that owns the GL context, so only
+ * CPU work happens on the worker. Completion callbacks always run on the main
+ * thread, inside Pump().
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **AsyncLoader(ResourceCache &cache)**
+ *   - Objective: bind the loader to the cache that will own what it loads.
+ *
+ * **void AddImage(const char *path, float scale, TextureReady ready)**
+ * **void AddFoodAtlas(TextureReady ready)**
+ * **void AddSound(const char *path, SoundReady ready)**
+ *   - Objective: queue work; jobs are decoded in the order they were added, so
+ *                add what the first screen needs first. Only valid before Start().
+ *
+ * **void Start(const AssetBundle *bundle)**
+ *   - Objective: launch the worker. The bundle (may be null) must stay open until
+ *                Done() is true.
+ *
+ * **void Pump(int maxUploads)**
+ *   - Objective: upload up to maxUploads decoded assets and run their callbacks.
+ *
+ * **bool Done() const / float Progress() const**
+ *   - Objective: whether every job has been delivered / fraction delivered so far.
+ *
+ * **void Cancel()**
+ *   - Objective: abandon the remaining decodes and join the worker. Pump() delivers
+ *                nothing afterwards.
+ *
+ * **~AsyncLoader()**
+ *   - Objective: Cancel() and free anything decoded but never delivered.
+ */
+class AsyncLoader
+{
+public:
+    typedef std::function<void(TextureHandle)> TextureReady;
+    typedef std::function<void(SoundHandle)> SoundReady;
+
+    explicit AsyncLoader(ResourceCache &resources) : cache(resources) {}
+    ~AsyncLoader();
+    AsyncLoader(const AsyncLoader &) = delete; // owns a thread
+    AsyncLoader &operator=(const AsyncLoader &) = delete;
+
+    void AddImage(const char *path, float scale, TextureReady ready);
+    void AddFoodAtlas(TextureReady ready);
+    void AddSound(const char *path, SoundReady ready);
+    void Start(const AssetBundle *bundle);
+    void Pump(int maxUploads);
+    void Cancel();
+    bool Done() const { return delivered == (int)jobs.size(); }
+    float Progress() const { return jobs.empty() ? 1.0f : (float)delivered / jobs.size(); }
+
+private:
+    enum JobKind
+    {
+        ImageJob,
+        AtlasJob,
+        SoundJob,
+    };
+
+    struct Job
+    {
+        JobKind kind;
+        std::string key;                    // ResourceCache key (AssetKey of path and scale)
+        const char *path;                   // source file (unused for the atlas)
+        float scale;                        // draw scale of images
+        std::vector<TextureReady> textures; // image/atlas requesters sharing this job
+        std::vector<SoundReady> sounds;     // sound requesters sharing this job
+        TextureHandle texture;              // held from queueing (already resident) or upload until delivery
+        SoundHandle sound;
+        Image image = {};                   // decoded by the worker
+        AudioClip clip = {};                // sounds: always owned
+        bool owned = false;                 // image must be freed (false: points into the bundle)
+    };
+
+    Job *Queue(JobKind kind, const char *key, const char *path, float scale);
+    void Work(const AssetBundle *bundle);
+
+    ResourceCache &cache;           // receives every upload (main thread only)
+    std::vector<Job> jobs;          // fixed once Start() runs
+    std::thread worker;
+    std::mutex mutex;               // guards decoded
+    int decoded = 0;                // jobs[0, decoded) hold CPU data ready to upload
+    int delivered = 0;              // jobs[0, delivered) were uploaded (main thread only)
+    std::atomic<bool> stop{false};  // set by Cancel() to abandon the remaining decodes
+};
@@ -0,0 +1,203 @@
+#include "audio_mixer.hpp"
+
+std::atomic<AudioMixer *> AudioMixer::current{nullptr};
+
+/**
+ * AudioMixer::AudioMixer
+ * ============================
+ * Objective:
+ *   Store the pool size and buffer size; the stream is created by Open().
+ */
+AudioMixer::AudioMixer(int poolSize, int frames)
+    : voiceCount(poolSize < 1 ? 1 : (poolSize > maxVoices ? maxVoices : poolSize)), bufferFrames(frames)
+{
+}
+
+AudioMixer::~AudioMixer()
+{
+    Close();
+}
+
+/**
+ * AudioMixer::Open
+ * ============================
+ * Objective:
+ *   Create the mixing stream with this mixer's buffer size and start it.
+ *
+ * Return Value:
+ *   - bool → true when the mixer is (now) playing.
+ *
+ * Side Effects:
+ *   - From here on the audio thread calls Mix() every bufferFrames frames.
+ *
+ * Approach:
+ *   The buffer size of an AudioStream is taken from the raylib default at load
+ *   time, so the default is set for this one stream and restored right after.
+ */
+bool AudioMixer::Open()
+{
+    if (open)
+        return true;
+    if (!IsAudioDeviceReady())
+        return false;
+    AudioMixer *none = nullptr;
+    if (!current.compare_exchange_strong(none, this))
+    {
+        TraceLog(LOG_WARNING, "MIXER: another mixer is already open");
+        return false;
+    }
+
+    SetAudioStreamBufferSizeDefault(bufferFrames);
+    stream = LoadAudioStream(mixerSampleRate, 32, mixerChannels); // 32-bit float, like the clips
+    SetAudioStreamBufferSizeDefault(0);                           // back to raylib's default
+    SetAudioStreamCallback(stream, MixCallback);
+    PlayAudioStream(stream);
+    open = true;
+
+    TraceLog(LOG_INFO, "MIXER: %i voices, %i-frame buffer (%.1f ms)", voiceCount, bufferFrames,
+             1000.0 * bufferFrames / mixerSampleRate);
+    return true;
+}
+
+/**
+ * AudioMixer::Close
+ * ============================
+ * Objective:
+ *   Stop and unload the stream. raylib stops calling the callback once the
+ *   stream is unloaded, so clips may be freed afterwards.
+ */
+void AudioMixer::Close()
+{
+    if (!open)
+        return;
+    StopAudioStream(stream);
+    UnloadAudioStream(stream);
+    current = nullptr;
+    open = false;
+    for (Voice &voice : voices)
+        voice = Voice{};
+    PlayRequest dropped;
+    while (requests.TryPop(dropped))
+        ; // never started
+}
+
+/**
+ * AudioMixer::Play
+ * ============================
+ * Objective:
+ *   Ask the audio thread to start a clip.
+ *
+ * Input:
+ *   - const AudioClip &clip → pre-decoded PCM; must stay loaded until Close().
+ *   - int priority → importance of the event; ties steal the oldest voice.
+ *   - float volume → gain applied to this voice.
+ *
+ * Side Effects:
+ *   - None on this thread beyond one ring push; a full ring drops the request.
+ */
+void AudioMixer::Play(const AudioClip &clip, int priority, float volume)
+{
+    if (!open || !clip.samples || clip.frameCount == 0)
+        return;
+    requests.TryPush(PlayRequest{clip.samples, clip.frameCount, priority, volume});
+}
+
+/**
+ * AudioMixer::MixCallback
+ * ============================
+ * Objective:
+ *   raylib's stream callback (audio thread); forwards to the open mixer.
+ */
+void AudioMixer::MixCallback(void *buffer, unsigned int frames)
+{
+    AudioMixer *mixer = current.load(std::memory_order_acquire);
+    if (mixer)
+        mixer->Mix((float *)buffer, frames);
+}
+
+/**
+ * AudioMixer::StartVoice
+ * ============================
+ * Objective:
+ *   Assign a request to a voice (audio thread).
+ *
+ * Approach:
+ *   - The same clip started less than retriggerMs ago: drop the request.
+ *   - A free voice: take it.
+ *   - Otherwise steal the lowest-priority voice, the oldest among equals, as long
+ *     as its priority does not exceed the request's; else drop the request.
+ */
+void AudioMixer::StartVoice(const PlayRequest &request)
+{
+    const unsigned int retriggerFrames = (unsigned int)(mixerSampleRate * retriggerMs / 1000);
+    Voice *idle = nullptr;   // first free voice
+    Voice *victim = nullptr; // lowest priority, oldest among equals
+    for (int i = 0; i < voiceCount; i++)
+    {
+        Voice &voice = voices[i];
+        if (!voice.samples)
+        {
+            if (!idle)
+                idle = &voice;
+            continue;
+        }
+        if (voice.samples == request.samples && voice.cursor < retriggerFrames)
+            return; // this clip is just starting already
+        if (!victim || voice.priority < victim->priority ||
+            (voice.priority == victim->priority && voice.started < victim->started))
+            victim = &voice;
+    }
+    if (!idle && victim->priority > request.priority)
+        return; // every voice is busy with something more important
+
+    *(idle ? idle : victim) = Voice{request.samples, request.frameCount, 0, request.priority, request.volume, ++serial};
+}
+
+/**
+ * AudioMixer::Mix
+ * ============================
+ * Objective:
+ *   Fill one stream buffer (audio thread): start pending requests, then sum all
+ *   active voices.
+ *
+ * Input:
+ *   - float *out → frames * mixerChannels interleaved samples to write.
+ *
+ * Approach:
+ *   Voices are added with their gain and the sum is clamped to [-1, 1], so a
+ *   burst of overlapping sounds saturates instead of wrapping around.
+ */
+void AudioMixer::Mix(float *out, unsigned int frames)
+{
+    PlayRequest request;
+    while (requests.TryPop(request))
+        StartVoice(request);
+
+    const unsigned int samples = frames * mixerChannels;
+    for (unsigned int i = 0; i < samples; i++)
+        out[i] = 0.0f;
+
+    for (int v = 0; v < voiceCount; v++)
+    {
+        Voice &voice = voices[v];
+        if (!voice.samples)
+            continue;
+        unsigned int count = voice.frameCount - voice.cursor;
+        if (count > frames)
+            count = frames;
+        const float *in = voice.samples + (size_t)voice.cursor * mixerChannels;
+        for (unsigned int i = 0; i < count * mixerChannels; i++)
+            out[i] += in[i] * voice.volume;
+        voice.cursor += count;
+        if (voice.cursor >= voice.frameCount)
+            voice = Voice{}; // finished; free for the next request
+    }
+
+    for (unsigned int i = 0; i < samples; i++)
+    {
+        if (out[i] > 1.0f)
+            out[i] = 1.0f;
+        else if (out[i] < -1.0f)
+            out[i] = -1.0f;
+    }
+}
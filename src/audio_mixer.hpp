@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+
+#include <raylib.h>
+
+#include "assets.hpp" // AudioClip and the mixer format
+#include "spsc_ring.hpp"
+
+/**
+ * =============================
+ * Class Overview
+ * =============================
+ * The **AudioMixer** plays sound effects through a single raylib AudioStream
+ * and mixes them itself, instead of calling PlaySound per event.
+ *
+ * - Clips are pre-decoded PCM in the mixer format (see AudioClip), so playing one
+ *   only sets up a voice. Nothing is decoded or converted at play time.
+ * - A fixed pool of voices plays simultaneous events side by side. Replaying a
+ *   clip does not restart (cut off) the copy that is already sounding.
+ * - Each request carries a priority. When every voice is busy, the new sound
+ *   takes the oldest voice of the lowest priority at or below its own, or is
+ *   dropped. A death sound is therefore never lost under a burst of eat sounds.
+ *   A request for a clip that started less than retriggerMs ago is dropped too,
+ *   so several ticks in one frame do not stack the same sound into a loud spike.
+ * - The stream buffer size is set per mixer. The time from Play() to audible
+ *   output is bounded by roughly two buffers plus the device period.
+ *
+ * Play() runs on the main thread and only pushes a request into a lock-free ring.
+ * The audio thread starts requested voices and mixes them in its stream callback
+ * (raylib callbacks carry no user pointer, so only one mixer may be open at a time).
+ *
+ * The clips passed to Play() must stay loaded until Close(): voices read them
+ * directly.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **AudioMixer(int poolSize, int bufferFrames)**
+ *   - Objective: configure the pool size (at most maxVoices) and the stream buffer
+ *                in frames; nothing is opened yet.
+ *
+ * **bool Open()**
+ *   - Objective: create and start the stream. Needs an initialized audio device;
+ *                returns false (and stays silent) without one. Does nothing when
+ *                already open.
+ *
+ * **void Close()**
+ *   - Objective: stop the stream; afterwards no voice touches any clip.
+ *
+ * **void Play(const AudioClip &clip, int priority, float volume)**
+ *   - Objective: queue a clip; higher priority wins when voices run out. Ignored
+ *                while closed or for an empty clip.
+ *
+ * **~AudioMixer()**
+ *   - Objective: Close().
+ */
+class AudioMixer
+{
+public:
+    static constexpr int maxVoices = 16;
+    static constexpr int retriggerMs = 20;
+
+    AudioMixer(int poolSize, int bufferFrames);
+    ~AudioMixer();
+    AudioMixer(const AudioMixer &) = delete; // registered with the audio thread
+    AudioMixer &operator=(const AudioMixer &) = delete;
+
+    bool Open();
+    void Close();
+    bool IsOpen() const { return open; }
+    void Play(const AudioClip &clip, int priority, float volume = 1.0f);
+
+private:
+    struct PlayRequest
+    {
+        const float *samples;
+        unsigned int frameCount;
+        int priority;
+        float volume;
+    };
+
+    struct Voice
+    {
+        const float *samples = nullptr; // null while the voice is free
+        unsigned int frameCount = 0;
+        unsigned int cursor = 0;        // next frame to mix
+        int priority = 0;
+        float volume = 1.0f;
+        unsigned long long started = 0; // request serial, for picking the oldest voice
+    };
+
+    static void MixCallback(void *buffer, unsigned int frames);
+    void Mix(float *out, unsigned int frames);
+    void StartVoice(const PlayRequest &request);
+
+    static std::atomic<AudioMixer *> current; // the open mixer the callback feeds
+
+    int voiceCount;                      // voices in use, <= maxVoices
+    int bufferFrames;                    // stream buffer size in frames
+    bool open = false;
+    AudioStream stream = {};
+    SpscRing<PlayRequest, 64> requests;  // main thread -> audio thread
+    Voice voices[maxVoices];             // audio thread only
+    unsigned long long serial = 0;       // audio thread only
+};
@@ -0,0 +1,325 @@
+#include "autopilot.hpp"
+
+static const Cell steps[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}; // right, down, left, up
+
+/**
+ * Autopilot::Reserve
+ * ============================
+ * Objective:
+ *   Size the per-cell buffers for a board; a no-op unless the size changed.
+ */
+void Autopilot::Reserve(int boardSize)
+{
+    if (boardSize == size)
+        return;
+    size = boardSize;
+    size_t cells = (size_t)size * size;
+    seen.assign(cells, 0);
+    blocked.assign(cells, 0);
+    cameFrom.assign(cells, 0);
+    queue.assign(cells, 0);
+    path.clear();
+    path.reserve(cells);
+    seenStamp = blockedStamp = 0;
+}
+
+/**
+ * Autopilot::NextStamp
+ * ============================
+ * Objective:
+ *   Start a new generation of `marks`: every cell counts as unmarked again.
+ *   Only when the 32-bit stamp wraps is the array actually cleared.
+ */
+void Autopilot::NextStamp(std::vector<uint32_t> &marks, uint32_t &stamp)
+{
+    if (++stamp == 0)
+    {
+        marks.assign(marks.size(), 0);
+        stamp = 1;
+    }
+}
+
+/**
+ * Autopilot::Decide
+ * ============================
+ * Objective:
+ *   Choose this tick's direction.
+ *
+ * Approach:
+ *   Keep following the planned path while the head is where the plan expects,
+ *   the snake has the length the plan was checked for, the fruit is still there and
+ *   the next cell is free. Otherwise plan again, and when no fruit can be reached
+ *   safely fall back to keeping the tail in reach.
+ *
+ * Variable definition and use:
+ *   length - body length once pending growth applies; differs from planLength only
+ *            after a fruit the plan did not aim for was eaten on the way
+ */
+Cell Autopilot::Decide(const Simulation &sim)
+{
+    Reserve(sim.boardSize);
+    const Snake &snake = sim.snake;
+    Cell head = snake.body[0];
+
+    int length = (int)snake.body.size() + (snake.addSegment ? 1 : 0);
+    bool targetStillThere = false;
+    for (const Food &f : sim.fruits)
+        targetStillThere = targetStillThere || (f.active && f.position == pathTarget);
+    if (path.empty() || head != pathHead || length != planLength || !targetStillThere)
+    {
+        path.clear();
+        if (!Plan(sim))
+            return Fallback(sim);
+    }
+
+    Cell step = steps[path.back()];
+    Cell next = head + step;
+    bool tailLeaves = !snake.addSegment && next == snake.body.back();
+    if (!snake.occupancy.InBounds(next) || (snake.IsOccupied(next) && !tailLeaves))
+    {
+        path.clear(); // cannot happen while the plan holds; stay safe regardless
+        return Fallback(sim);
+    }
+    path.pop_back();
+    pathHead = next;
+    return step;
+}
+
+/**
+ * Autopilot::Plan
+ * ============================
+ * Objective:
+ *   Breadth-first search from the head to the nearest active fruit.
+ *
+ * Return Value:
+ *   - bool → true with `path` filled when a fruit was found and eating it keeps the
+ *            tail reachable; false with `path` empty otherwise.
+ *
+ * Approach:
+ *   Body cells are walls, except the tail when it is about to move. A fruit is
+ *   recognised when it is first pushed, so the search ends one layer early. The
+ *   path is read back through cameFrom, which leaves it last step first, ready to
+ *   be consumed with pop_back().
+ *
+ * Variable definition and use:
+ *   first, last - read and write positions in queue; goal - index of the fruit found
+ */
+bool Autopilot::Plan(const Simulation &sim)
+{
+    const Snake &snake = sim.snake;
+    const OccupancyGrid &grid = snake.occupancy;
+    Cell head = snake.body[0];
+    Cell tail = snake.body.back();
+    bool tailLeaves = !snake.addSegment;
+
+    searches++;
+    NextStamp(seen, seenStamp);
+    int headIndex = head.y * size + head.x;
+    seen[headIndex] = seenStamp;
+    queue[0] = headIndex;
+    int first = 0, last = 1;
+    int goal = -1;
+    while (first < last && goal < 0)
+    {
+        int index = queue[first++];
+        Cell cell = Cell{(int16_t)(index % size), (int16_t)(index / size)};
+        for (int d = 0; d < 4 && goal < 0; d++)
+        {
+            Cell next = cell + steps[d];
+            if (!grid.InBounds(next))
+                continue;
+            int nextIndex = next.y * size + next.x;
+            if (seen[nextIndex] == seenStamp || (grid.cells[nextIndex] && !(tailLeaves && next == tail)))
+                continue;
+            seen[nextIndex] = seenStamp;
+            cameFrom[nextIndex] = (uint8_t)d;
+            queue[last++] = nextIndex;
+            for (const Food &f : sim.fruits)
+                if (f.active && f.position == next)
+                    goal = nextIndex;
+        }
+    }
+    if (goal < 0)
+        return false;
+
+    for (int index = goal; index != headIndex;)
+    {
+        uint8_t d = cameFrom[index];
+        path.push_back(d);
+        index -= steps[d].y * size + steps[d].x;
+    }
+    pathHead = head;
+    pathTarget = Cell{(int16_t)(goal % size), (int16_t)(goal / size)};
+    planLength = (int)snake.body.size() + (snake.addSegment ? 1 : 0);
+    if (TailReachableAfterPlan(sim))
+        return true;
+    path.clear();
+    return false;
+}
+
+/**
+ * Autopilot::TailReachableAfterPlan
+ * ============================
+ * Objective:
+ *   The safety check: once the snake has followed `path` and eaten the fruit, is
+ *   there still a way from its head to its tail? If so it can always follow its
+ *   tail around and never gets boxed in.
+ *
+ * Approach:
+ *   Build the body the snake will have on the fruit with blocked stamps: the last
+ *   length cells of the way there, path cells first, then the front of the old
+ *   body. The parts of the grid the tail has left by then are free, so only those
+ *   stamps (not the occupancy grid) are walls for the search from the fruit.
+ *
+ * Variable definition and use:
+ *   length - body length on arrival; kept - old body cells still covered then;
+ *   virtualTail - the cell the tail will be on
+ */
+bool Autopilot::TailReachableAfterPlan(const Simulation &sim)
+{
+    const Snake &snake = sim.snake;
+    int pathLength = (int)path.size();
+    int length = (int)snake.body.size() + (snake.addSegment ? 1 : 0);
+    int kept = length - pathLength;
+
+    NextStamp(blocked, blockedStamp);
+    Cell cell = snake.body[0];
+    Cell virtualTail = cell;
+    for (int i = pathLength - 1, walked = 1; i >= 0; i--, walked++)
+    {
+        cell = cell + steps[path[i]];
+        if (walked > pathLength - length) // among the last `length` cells of the way
+        {
+            blocked[cell.y * size + cell.x] = blockedStamp;
+            if (walked == pathLength - length + 1)
+                virtualTail = cell;
+        }
+    }
+    for (int i = 0; i < kept; i++)
+    {
+        Cell segment = snake.body[i];
+        blocked[segment.y * size + segment.x] = blockedStamp;
+        virtualTail = segment;
+    }
+
+    NextStamp(seen, seenStamp);
+    Cell start = cell; // the fruit
+    int startIndex = start.y * size + start.x;
+    seen[startIndex] = seenStamp;
+    queue[0] = startIndex;
+    int first = 0, last = 1;
+    while (first < last)
+    {
+        int index = queue[first++];
+        Cell at = Cell{(int16_t)(index % size), (int16_t)(index / size)};
+        for (int d = 0; d < 4; d++)
+        {
+            Cell next = at + steps[d];
+            if (!snake.occupancy.InBounds(next))
+                continue;
+            if (next == virtualTail && index != startIndex)
+                return true; // right next to the fruit does not count: the tail waits a tick after eating
+            int nextIndex = next.y * size + next.x;
+            if (seen[nextIndex] == seenStamp || blocked[nextIndex] == blockedStamp)
+                continue;
+            seen[nextIndex] = seenStamp;
+            queue[last++] = nextIndex;
+        }
+    }
+    return false;
+}
+
+/**
+ * Autopilot::Flood
+ * ============================
+ * Objective:
+ *   Search the board as it will be after the head moves to `start`, towards the
+ *   new tail `target`.
+ *
+ * Return Value:
+ *   - int → the distance to `target` when it is reached (`reached` set), otherwise
+ *           the number of cells reachable from `start`.
+ */
+int Autopilot::Flood(const Simulation &sim, Cell start, Cell target, bool &reached)
+{
+    const Snake &snake = sim.snake;
+    const OccupancyGrid &grid = snake.occupancy;
+    Cell tail = snake.body.back();
+    bool tailLeaves = !snake.addSegment;
+
+    searches++;
+    NextStamp(seen, seenStamp);
+    int startIndex = start.y * size + start.x;
+    seen[startIndex] = seenStamp;
+    queue[0] = startIndex;
+    int first = 0, last = 1;
+    int depth = 0, layerEnd = 1;
+    reached = false;
+    while (first < last)
+    {
+        if (first == layerEnd)
+        {
+            depth++;
+            layerEnd = last;
+        }
+        int index = queue[first++];
+        Cell at = Cell{(int16_t)(index % size), (int16_t)(index / size)};
+        for (int d = 0; d < 4; d++)
+        {
+            Cell next = at + steps[d];
+            if (!grid.InBounds(next))
+                continue;
+            if (next == target)
+            {
+                reached = true;
+                return depth + 1;
+            }
+            int nextIndex = next.y * size + next.x;
+            if (seen[nextIndex] == seenStamp || (grid.cells[nextIndex] && !(tailLeaves && next == tail)))
+                continue;
+            seen[nextIndex] = seenStamp;
+            queue[last++] = nextIndex;
+        }
+    }
+    return last;
+}
+
+/**
+ * Autopilot::Fallback
+ * ============================
+ * Objective:
+ *   No fruit is safely reachable: pick the move that keeps the snake alive longest.
+ *
+ * Approach:
+ *   Every move that survives this tick is scored by a search from its cell. Moves
+ *   that can still reach the tail win, and among them the one with the longest way
+ *   to it, which makes the snake trail its tail instead of coiling up. If none can,
+ *   the move with the most room is taken.
+ */
+Cell Autopilot::Fallback(const Simulation &sim)
+{
+    const Snake &snake = sim.snake;
+    Cell head = snake.body[0];
+    Cell tail = snake.body.back();
+    bool tailLeaves = !snake.addSegment;
+    Cell newTail = tailLeaves && snake.body.size() >= 2 ? snake.body[snake.body.size() - 2] : tail;
+
+    Cell best = snake.direction;
+    bool bestReached = false;
+    int bestValue = -1;
+    for (int d = 0; d < 4; d++)
+    {
+        Cell next = head + steps[d];
+        if (!snake.occupancy.InBounds(next) || (snake.IsOccupied(next) && !(tailLeaves && next == tail)))
+            continue;
+        bool reached;
+        int value = Flood(sim, next, newTail, reached);
+        if ((reached && !bestReached) || (reached == bestReached && value > bestValue))
+        {
+            best = steps[d];
+            bestReached = reached;
+            bestValue = value;
+        }
+    }
+    return best;
+}
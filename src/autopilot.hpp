@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "simulation.hpp"
+
+/**
+ * =============================
+ * Autopilot Overview
+ * =============================
+ * Picks the player's direction every tick: the shortest path to the nearest fruit,
+ * taken only if the snake could still reach its own tail after eating it, and
+ * otherwise the move that best keeps the tail in reach. Used for the game's
+ * --autopilot mode and the benchmark's `autopilot` policy.
+ *
+ * The searches are breadth-first over the Simulation's occupancy grid and never
+ * allocate after the first call on a board size:
+ * - visited cells are marked with a per-search stamp instead of being cleared, so
+ *   a search costs the cells it reaches, not the board;
+ * - the queue, the per-cell first steps and the planned path are fixed-size
+ *   buffers kept between ticks.
+ *
+ * A planned path stays valid while the snake follows it at the length it was
+ * planned for: cells ahead of the head can then only be vacated by the moving tail,
+ * never filled. A fruit that respawns onto the path and is eaten on the way makes
+ * the snake longer than the tail check assumed, so that also starts a new search.
+ * The autopilot therefore plans once per fruit and afterwards only checks that the
+ * head, the length, the target fruit and the next cell are still as planned, so
+ * most ticks cost O(1) even on large boards.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **Cell Decide(const Simulation &sim)**
+ *   - Objective: the direction to pass to sim.Step() this tick.
+ *
+ * **void Reserve(int boardSize)**
+ *   - Objective: size the buffers up front (Decide() does it on first use otherwise).
+ *
+ * **int Searches() const**
+ *   - Return: breadth-first searches run so far (for benchmarks).
+ */
+class Autopilot
+{
+public:
+    Cell Decide(const Simulation &sim);
+    void Reserve(int boardSize);
+    int Searches() const { return searches; }
+
+private:
+    void NextStamp(std::vector<uint32_t> &marks, uint32_t &stamp);
+    bool Plan(const Simulation &sim);
+    bool TailReachableAfterPlan(const Simulation &sim);
+    Cell Fallback(const Simulation &sim);
+    int Flood(const Simulation &sim, Cell start, Cell target, bool &reached);
+
+    int size = 0;
+    std::vector<uint32_t> seen;      // per cell: stamp of the search that reached it
+    uint32_t seenStamp = 0;
+    std::vector<uint32_t> blocked;   // per cell: stamp of the virtual body it belongs to
+    uint32_t blockedStamp = 0;
+    std::vector<uint8_t> cameFrom;   // per cell: direction code of the step that reached it
+    std::vector<int> queue;          // breadth-first frontier, one slot per cell
+    std::vector<uint8_t> path;       // planned direction codes, last step first
+    Cell pathHead = {0, 0};          // where the head must be for path.back() to apply
+    Cell pathTarget = {0, 0};        // fruit the path leads to
+    int planLength = 0;              // body length, pending growth included, the path was checked for
+    int searches = 0;
+};
@@ -0,0 +1,230 @@
+#include "batch_kernels.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SNAKE_LANES_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SNAKE_TARGET_AVX2 // MSVC emits AVX2 intrinsics without a per-function target
+#else
+#define SNAKE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SNAKE_LANES_NEON 1
+#include <arm_neon.h>
+#endif
+
+/**
+ * CheckScalar
+ * ============================
+ * Objective:
+ *   Reference kernel: flags for games [from, batch.count), one at a time.
+ *
+ * Approach:
+ *   Casting to uint16 turns the two-sided bounds test into one compare per axis,
+ *   exactly like the vector kernels' unsigned compares.
+ */
+static void CheckScalar(const LaneBatch &batch, size_t from, uint8_t *flags)
+{
+    const uint16_t size = (uint16_t)batch.boardSize;
+    for (size_t i = from; i < batch.count; i++)
+    {
+        int16_t x = batch.headX[i];
+        int16_t y = batch.headY[i];
+        uint8_t flag = ((uint16_t)x >= size || (uint16_t)y >= size) ? laneOutside : 0;
+        for (int k = 0; k < batch.fruitCount; k++)
+        {
+            size_t slot = k * batch.fruitStride + i;
+            if (batch.fruitX[slot] == x && batch.fruitY[slot] == y)
+                flag |= LaneFruitBit(k);
+        }
+        flags[i] = flag;
+    }
+}
+
+#ifdef SNAKE_LANES_X86
+/**
+ * CheckAvx2
+ * ============================
+ * Objective:
+ *   Flags for 16 games per iteration; returns how many games it handled (the rest
+ *   are left to CheckScalar).
+ *
+ * Approach:
+ *   Bounds: as unsigned 16-bit values negative coordinates are huge, so
+ *   min(v, boardSize - 1) == v holds exactly for 0 <= v < boardSize. Fruit hits: an
+ *   x compare AND a y compare per fruit, masked to the fruit's bit. The 16 word
+ *   flags are then packed to bytes (values fit, so the saturation never triggers).
+ */
+SNAKE_TARGET_AVX2 static size_t CheckAvx2(const LaneBatch &batch, uint8_t *flags)
+{
+    const __m256i last = _mm256_set1_epi16((int16_t)(batch.boardSize - 1));
+    const __m256i outside = _mm256_set1_epi16(laneOutside);
+    size_t i = 0;
+    for (; i + 16 <= batch.count; i += 16)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(batch.headX + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(batch.headY + i));
+        __m256i inside = _mm256_and_si256(_mm256_cmpeq_epi16(_mm256_min_epu16(x, last), x),
+                                          _mm256_cmpeq_epi16(_mm256_min_epu16(y, last), y));
+        __m256i flag = _mm256_andnot_si256(inside, outside);
+        for (int k = 0; k < batch.fruitCount; k++)
+        {
+            size_t slot = k * batch.fruitStride + i;
+            __m256i fruitX = _mm256_loadu_si256((const __m256i *)(batch.fruitX + slot));
+            __m256i fruitY = _mm256_loadu_si256((const __m256i *)(batch.fruitY + slot));
+            __m256i hit = _mm256_and_si256(_mm256_cmpeq_epi16(x, fruitX), _mm256_cmpeq_epi16(y, fruitY));
+            flag = _mm256_or_si256(flag, _mm256_and_si256(hit, _mm256_set1_epi16(LaneFruitBit(k))));
+        }
+        __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(flag), _mm256_extracti128_si256(flag, 1));
+        _mm_storeu_si128((__m128i *)(flags + i), bytes);
+    }
+    return i;
+}
+
+/**
+ * CpuHasAvx2
+ * ============================
+ * Objective:
+ *   Whether the CPU and the OS (saved YMM state) support AVX2.
+ */
+static bool CpuHasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)); // OSXSAVE and AVX
+    if (!osSavesAvx || (_xgetbv(0) & 6) != 6)
+        return false; // XMM and YMM state not enabled by the OS
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#ifdef SNAKE_LANES_NEON
+/**
+ * CheckNeon
+ * ============================
+ * Objective:
+ *   Flags for 8 games per iteration; returns how many games it handled.
+ *
+ * Approach:
+ *   Same tests as CheckAvx2, with NEON's native unsigned compare for the bounds
+ *   and a narrowing move from 16-bit lanes to bytes.
+ */
+static size_t CheckNeon(const LaneBatch &batch, uint8_t *flags)
+{
+    const uint16x8_t size = vdupq_n_u16((uint16_t)batch.boardSize);
+    const uint16x8_t outside = vdupq_n_u16(laneOutside);
+    size_t i = 0;
+    for (; i + 8 <= batch.count; i += 8)
+    {
+        int16x8_t x = vld1q_s16(batch.headX + i);
+        int16x8_t y = vld1q_s16(batch.headY + i);
+        uint16x8_t inside = vandq_u16(vcltq_u16(vreinterpretq_u16_s16(x), size),
+                                      vcltq_u16(vreinterpretq_u16_s16(y), size));
+        uint16x8_t flag = vbicq_u16(outside, inside);
+        for (int k = 0; k < batch.fruitCount; k++)
+        {
+            size_t slot = k * batch.fruitStride + i;
+            uint16x8_t hit = vandq_u16(vceqq_s16(x, vld1q_s16(batch.fruitX + slot)),
+                                       vceqq_s16(y, vld1q_s16(batch.fruitY + slot)));
+            flag = vorrq_u16(flag, vandq_u16(hit, vdupq_n_u16(LaneFruitBit(k))));
+        }
+        vst1_u8(flags + i, vmovn_u16(flag));
+    }
+    return i;
+}
+#endif
+
+/**
+ * LaneKernelSupported
+ * ============================
+ * Return Value:
+ *   - bool → true when `kernel` was compiled in and this CPU can run it.
+ */
+bool LaneKernelSupported(LaneKernel kernel)
+{
+    switch (kernel)
+    {
+    case LaneKernel::Scalar:
+        return true;
+    case LaneKernel::Avx2:
+#ifdef SNAKE_LANES_X86
+        {
+            static const bool avx2 = CpuHasAvx2(); // cpuid once
+            return avx2;
+        }
+#else
+        return false;
+#endif
+    case LaneKernel::Neon:
+#ifdef SNAKE_LANES_NEON
+        return true; // mandatory on AArch64
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+/**
+ * BestLaneKernel
+ * ============================
+ * Return Value:
+ *   - LaneKernel → the widest supported kernel: Avx2, then Neon, then Scalar.
+ */
+LaneKernel BestLaneKernel()
+{
+    if (LaneKernelSupported(LaneKernel::Avx2))
+        return LaneKernel::Avx2;
+    if (LaneKernelSupported(LaneKernel::Neon))
+        return LaneKernel::Neon;
+    return LaneKernel::Scalar;
+}
+
+const char *LaneKernelName(LaneKernel kernel)
+{
+    switch (kernel)
+    {
+    case LaneKernel::Avx2:
+        return "avx2";
+    case LaneKernel::Neon:
+        return "neon";
+    default:
+        return "scalar";
+    }
+}
+
+/**
+ * CheckLanes
+ * ============================
+ * Objective:
+ *   Write the flag byte of every game in `batch` with the requested kernel.
+ *
+ * Approach:
+ *   The vector kernel covers whole groups of lanes and reports how far it got;
+ *   the scalar kernel finishes the remainder, so any count is valid.
+ */
+void CheckLanes(LaneKernel kernel, const LaneBatch &batch, uint8_t *flags)
+{
+    size_t done = 0;
+    if (!LaneKernelSupported(kernel))
+        kernel = LaneKernel::Scalar;
+#ifdef SNAKE_LANES_X86
+    if (kernel == LaneKernel::Avx2)
+        done = CheckAvx2(batch, flags);
+#endif
+#ifdef SNAKE_LANES_NEON
+    if (kernel == LaneKernel::Neon)
+        done = CheckNeon(batch, flags);
+#endif
+    CheckScalar(batch, done, flags);
+}
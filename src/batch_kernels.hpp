@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * =============================
+ * Batch Kernels Overview
+ * =============================
+ * Lane-parallel collision checks for BatchSimulation. Once every game of a chunk
+ * has picked its move, one call tests all of the new heads at once, one game per
+ * 16-bit lane:
+ *   - bounds: the head left [0, boardSize) on either axis (CheckCollisionWithEdges);
+ *   - fruit hits: the head equals fruit k (CheckCollisionWithFood), for every fruit.
+ *
+ * The result per game is a flag byte: bit 0 for out of bounds, bit 1 + k for fruit
+ * k. The batch keeps coordinates as int16 and fruits fruit-major, so the inputs are
+ * already contiguous across games and load straight into vector registers.
+ *
+ * Kernels:
+ *   - Avx2   : 16 games per instruction (x86-64, picked only if the CPU reports AVX2).
+ *   - Neon   : 8 games per instruction (AArch64, where NEON is always present).
+ *   - Scalar : one game at a time; the reference and the fallback.
+ * Every kernel produces identical flags, so results never depend on the machine.
+ *
+ * =============================
+ * Functions
+ * =============================
+ * **LaneKernel BestLaneKernel()**
+ *   - Return: the fastest kernel this CPU supports (detected once, at first call).
+ *
+ * **bool LaneKernelSupported(LaneKernel kernel)** / **const char *LaneKernelName(LaneKernel kernel)**
+ *
+ * **void CheckLanes(LaneKernel kernel, const LaneBatch &batch, uint8_t *flags)**
+ *   - Objective: write one flag byte per game of `batch`; an unsupported kernel
+ *                falls back to Scalar.
+ */
+
+enum class LaneKernel
+{
+    Scalar,
+    Avx2,
+    Neon,
+};
+
+/*
+ * LaneBatch struct
+ * Objective: the inputs of one CheckLanes call, all indexed by game within the range.
+ * Member variables:
+ *  - headX, headY : new head of each game.
+ *  - fruitX, fruitY : fruit k of game g at [k * fruitStride + g]; inactive fruits are -1.
+ *  - count : games in the range; fruitCount : fruits per game (at most 7).
+ */
+struct LaneBatch
+{
+    const int16_t *headX;
+    const int16_t *headY;
+    const int16_t *fruitX;
+    const int16_t *fruitY;
+    size_t fruitStride;
+    size_t count;
+    int fruitCount;
+    int boardSize;
+};
+
+static constexpr uint8_t laneOutside = 1; ///< flag bit: head is off the board
+inline uint8_t LaneFruitBit(int fruit) { return (uint8_t)(2 << fruit); } ///< flag bit: head on fruit
+
+LaneKernel BestLaneKernel();
+bool LaneKernelSupported(LaneKernel kernel);
+const char *LaneKernelName(LaneKernel kernel);
+void CheckLanes(LaneKernel kernel, const LaneBatch &batch, uint8_t *flags);
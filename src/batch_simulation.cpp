@@ -0,0 +1,463 @@
+#include "batch_simulation.hpp"
+
+static const int8_t stepX[4] = {1, 0, -1, 0}; // right, down, left, up
+static const int8_t stepY[4] = {0, 1, 0, -1};
+
+/*
+ * PopCount64
+ * Objective: number of set bits in a 64-bit word (portable fallback for the builtin).
+ */
+static inline int PopCount64(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int bits = 0;
+    for (; word; word &= word - 1)
+        bits++;
+    return bits;
+#endif
+}
+
+/**
+ * BatchSimulation::BatchSimulation
+ * ============================
+ * Objective:
+ *   Allocate the structure-of-arrays state for `games` boards of size x size and
+ *   start every game from streams of `seed`.
+ *
+ * Side Effects:
+ *   - All memory is allocated here; Reset/Run never allocate again.
+ */
+BatchSimulation::BatchSimulation(int games, int size, uint64_t seed)
+    : gameCount(games), boardSize(size), cellCount(size * size)
+{
+    ringSize = 1;
+    while (ringSize < (uint32_t)cellCount + 1)
+        ringSize <<= 1; // a full board plus one, rounded up for mask indexing
+    ringMask = ringSize - 1;
+    wordsPerGame = (cellCount + 63) / 64;
+
+    headX.resize(games);
+    headY.resize(games);
+    dirX.resize(games);
+    dirY.resize(games);
+    length.resize(games);
+    ringFirst.resize(games);
+    body.resize((size_t)games * ringSize);
+    occupancy.resize((size_t)games * wordsPerGame);
+    fruitX.resize((size_t)games * fruitCount);
+    fruitY.resize((size_t)games * fruitCount);
+    grow.resize(games);
+    alive.resize(games);
+    won.resize(games);
+    score.resize(games);
+    ticks.resize(games);
+    rng.resize(games);
+    nextX.resize(games);
+    nextY.resize(games);
+    laneFlags.resize(games);
+
+    Reset(seed);
+}
+
+/**
+ * BatchSimulation::Reset
+ * ============================
+ * Objective:
+ *   Restart every game. Game g gets the base generator for `seed` jumped g times,
+ *   so each game's stream depends only on the seed and its index.
+ */
+void BatchSimulation::Reset(uint64_t seed)
+{
+    Rng stream(seed);
+    for (int g = 0; g < gameCount; g++)
+    {
+        rng[g] = stream;
+        stream.Jump(); // next non-overlapping stream
+        ResetGame(g);
+    }
+}
+
+/**
+ * BatchSimulation::ResetGame (seeded)
+ * ============================
+ * Objective:
+ *   Restart game g alone from a new stream of `seed`, leaving every other game as
+ *   it is; its results then depend only on that seed.
+ */
+void BatchSimulation::ResetGame(int game, uint64_t seed)
+{
+    rng[game] = Rng(seed);
+    ResetGame(game);
+}
+
+/**
+ * BatchSimulation::ResetGame
+ * ============================
+ * Objective:
+ *   Put game g in the starting position used by Snake::Reset and place its fruits.
+ */
+void BatchSimulation::ResetGame(int game)
+{
+    for (int w = 0; w < wordsPerGame; w++)
+        occupancy[(size_t)game * wordsPerGame + w] = 0;
+
+    int row = boardSize * 9 / 25;
+    int headColumn = boardSize * 6 / 25 < 2 ? 2 : boardSize * 6 / 25;
+    size_t base = (size_t)game * ringSize;
+    for (int i = 0; i < 3; i++)
+    {
+        int index = row * boardSize + headColumn - i;
+        body[base + i] = index; // head at ring index 0, tail at 2
+        SetCell(game, index);
+    }
+    ringFirst[game] = 0;
+    length[game] = 3;
+    headX[game] = (int16_t)headColumn;
+    headY[game] = (int16_t)row;
+    dirX[game] = 1;
+    dirY[game] = 0;
+    grow[game] = 0;
+    alive[game] = 1;
+    won[game] = 0;
+    score[game] = 0;
+    ticks[game] = 0;
+
+    for (int k = 0; k < fruitCount; k++)
+        PlaceFruit(game, k);
+}
+
+/**
+ * BatchSimulation::PlaceFruit
+ * ============================
+ * Objective:
+ *   Move fruit k of game g to a uniformly random free cell; mark it inactive
+ *   (x = -1) when the board is full.
+ *
+ * Approach:
+ *   The batch keeps only an occupancy bitset per game (no free list), to keep the
+ *   per-game footprint small. A few rejection samples find a free cell quickly on
+ *   a sparse board; when they all miss, the r-th free cell is located by counting
+ *   free bits a word at a time, which bounds the cost at cellCount/64 words.
+ */
+void BatchSimulation::PlaceFruit(int game, int fruit)
+{
+    size_t slot = (size_t)fruit * gameCount + game;
+    int freeCount = cellCount - (int)length[game];
+    if (freeCount <= 0)
+    {
+        fruitX[slot] = -1; // nowhere to go; never matches a head
+        fruitY[slot] = -1;
+        return;
+    }
+
+    Rng &r = rng[game];
+    int index = -1;
+    for (int attempt = 0; attempt < 8 && index < 0; attempt++)
+    {
+        int candidate = (int)r.Below(cellCount);
+        if (!TestCell(game, candidate))
+            index = candidate;
+    }
+    if (index < 0)
+    {
+        int target = (int)r.Below(freeCount); // pick the target-th free cell
+        const uint64_t *words = &occupancy[(size_t)game * wordsPerGame];
+        for (int w = 0; w < wordsPerGame; w++)
+        {
+            uint64_t freeBits = ~words[w];
+            if (w == wordsPerGame - 1 && (cellCount & 63))
+                freeBits &= (1ULL << (cellCount & 63)) - 1; // ignore bits past the board
+            int bits = PopCount64(freeBits);
+            if (target >= bits)
+            {
+                target -= bits;
+                continue;
+            }
+            for (int b = 0; b < 64; b++)
+            {
+                if (((freeBits >> b) & 1) && target-- == 0)
+                {
+                    index = w * 64 + b;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+
+    fruitX[slot] = (int16_t)(index % boardSize);
+    fruitY[slot] = (int16_t)(index / boardSize);
+}
+
+/**
+ * BatchSimulation::IsSafe
+ * ============================
+ * Return Value:
+ *   - bool → true when a head moving to (x, y) survives the tick: on the board and
+ *            not on the body, where the tail cell counts as free unless growing.
+ */
+bool BatchSimulation::IsSafe(int game, int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= boardSize || y >= boardSize)
+        return false;
+    int index = y * boardSize + x;
+    if (!TestCell(game, index))
+        return true;
+    uint32_t tail = body[(size_t)game * ringSize + ((ringFirst[game] + length[game] - 1) & ringMask)];
+    return (int)tail == index && !grow[game];
+}
+
+/**
+ * BatchSimulation::ChooseDirection
+ * ============================
+ * Objective:
+ *   Bot policy for game g. Returns an index into stepX/stepY; never a reversal.
+ *
+ * Approach:
+ *   Random: keep the heading, 1 in 8 ticks try a random one, take the first safe
+ *   option. Greedy: try the axis moves that close the distance to the first active
+ *   fruit, then fall back to the random policy.
+ */
+int BatchSimulation::ChooseDirection(int game, BatchPolicy policy)
+{
+    int x = headX[game];
+    int y = headY[game];
+    int current = dirX[game] == 1 ? 0 : dirY[game] == 1 ? 1 : dirX[game] == -1 ? 2 : 3;
+    int reverse = (current + 2) & 3;
+    Rng &r = rng[game];
+
+    if (policy == BatchPolicy::Greedy)
+    {
+        for (int k = 0; k < fruitCount; k++)
+        {
+            size_t slot = (size_t)k * gameCount + game;
+            if (fruitX[slot] < 0)
+                continue;
+            int wanted[2] = {
+                fruitX[slot] == x ? -1 : (fruitX[slot] > x ? 0 : 2),
+                fruitY[slot] == y ? -1 : (fruitY[slot] > y ? 1 : 3),
+            };
+            for (int d : wanted)
+            {
+                if (d >= 0 && d != reverse && IsSafe(game, x + stepX[d], y + stepY[d]))
+                    return d;
+            }
+            break;
+        }
+    }
+
+    int preferred = current;
+    if (r.Below(8) == 0)
+        preferred = (int)r.Below(4); // occasional random turn
+    if (preferred != reverse && IsSafe(game, x + stepX[preferred], y + stepY[preferred]))
+        return preferred;
+
+    int start = (int)r.Below(4);
+    for (int i = 0; i < 4; i++)
+    {
+        int d = (start + i) & 3;
+        if (d != reverse && IsSafe(game, x + stepX[d], y + stepY[d]))
+            return d;
+    }
+    return current; // boxed in: keep going and lose the round
+}
+
+/**
+ * BatchSimulation::MoveGame
+ * ============================
+ * Objective:
+ *   First pass of a tick for game g: pick the direction and compute the new head
+ *   into nextX/nextY for the lane kernel.
+ */
+void BatchSimulation::MoveGame(int game, BatchPolicy policy)
+{
+    if (alive[game])
+        ApplyMove(game, ChooseDirection(game, policy));
+}
+
+/**
+ * BatchSimulation::ApplyMove
+ * ============================
+ * Objective:
+ *   Turn game g to direction d (an index into stepX/stepY) and compute its new head.
+ */
+void BatchSimulation::ApplyMove(int game, int d)
+{
+    dirX[game] = stepX[d];
+    dirY[game] = stepY[d];
+    nextX[game] = (int16_t)(headX[game] + stepX[d]);
+    nextY[game] = (int16_t)(headY[game] + stepY[d]);
+    ticks[game]++;
+}
+
+/**
+ * BatchSimulation::ResolveGame
+ * ============================
+ * Objective:
+ *   Last pass of a tick for game g, with the same rules and order as
+ *   Simulation::Update; bounds and fruit hits come from laneFlags.
+ *
+ * Approach:
+ *   Edge flag, pop the tail unless growing, occupancy test for the tail collision,
+ *   push the head, then the flagged fruits in index order (so fruit respawns draw
+ *   from the game's stream in the same order as before) and the board-full check.
+ *   The flags were computed against the fruits as they were before this tick,
+ *   which is also what the sequential version compared against: a respawned
+ *   fruit never lands on the head, whose cell is already occupied.
+ */
+void BatchSimulation::ResolveGame(int game)
+{
+    if (!alive[game])
+        return;
+
+    uint8_t flags = laneFlags[game];
+    if (flags & laneOutside)
+    {
+        alive[game] = 0; // hit the edge
+        return;
+    }
+
+    int x = nextX[game];
+    int y = nextY[game];
+    size_t base = (size_t)game * ringSize;
+    if (grow[game])
+    {
+        grow[game] = 0;
+    }
+    else
+    {
+        uint32_t tail = body[base + ((ringFirst[game] + length[game] - 1) & ringMask)];
+        ClearCell(game, tail);
+        length[game]--;
+    }
+
+    int index = y * boardSize + x;
+    if (TestCell(game, index))
+    {
+        alive[game] = 0; // ran into the body
+        return;
+    }
+    SetCell(game, index);
+    ringFirst[game] = (ringFirst[game] - 1) & ringMask;
+    body[base + ringFirst[game]] = index;
+    length[game]++;
+    headX[game] = (int16_t)x;
+    headY[game] = (int16_t)y;
+
+    for (int k = 0; k < fruitCount; k++)
+    {
+        if (flags & LaneFruitBit(k))
+        {
+            score[game]++;
+            grow[game] = 1;
+            PlaceFruit(game, k);
+        }
+    }
+
+    if ((int)length[game] == cellCount)
+    {
+        won[game] = 1; // board full
+        alive[game] = 0;
+    }
+}
+
+/**
+ * BatchSimulation::StepRange
+ * ============================
+ * Objective:
+ *   Advance games [begin, end) by one tick on the calling thread.
+ *
+ * Approach:
+ *   Move every game, check all new heads with one CheckLanes call (lanes of games
+ *   that already ended hold stale heads, and their flags are ignored), then
+ *   resolve every game. Ranges from different threads never overlap, so the
+ *   scratch arrays need no synchronisation.
+ */
+void BatchSimulation::StepRange(size_t begin, size_t end, BatchPolicy policy)
+{
+    for (size_t g = begin; g < end; g++)
+        MoveGame((int)g, policy);
+    ResolveRange(begin, end);
+}
+
+/**
+ * BatchSimulation::StepActions
+ * ============================
+ * Objective:
+ *   Advance games [begin, end) by one tick with the caller's moves; games that have
+ *   ended stay as they are until they are reset.
+ *
+ * Approach:
+ *   As StepRange, with the policy replaced by actions[g] masked to a direction. A
+ *   reversal would run straight into the neck, so it keeps the current heading.
+ */
+void BatchSimulation::StepActions(size_t begin, size_t end, const int32_t *actions)
+{
+    for (size_t g = begin; g < end; g++)
+    {
+        if (!alive[g])
+            continue;
+        int current = dirX[g] == 1 ? 0 : dirY[g] == 1 ? 1 : dirX[g] == -1 ? 2 : 3;
+        int d = actions[g] & 3;
+        ApplyMove((int)g, d == ((current + 2) & 3) ? current : d);
+    }
+    ResolveRange(begin, end);
+}
+
+/**
+ * BatchSimulation::ResolveRange
+ * ============================
+ * Objective:
+ *   Second and third pass of a tick over games [begin, end) whose moves are set.
+ */
+void BatchSimulation::ResolveRange(size_t begin, size_t end)
+{
+    LaneBatch lanes = {&nextX[begin], &nextY[begin], &fruitX[begin], &fruitY[begin],
+                       (size_t)gameCount, end - begin, fruitCount, boardSize};
+    CheckLanes(kernel, lanes, &laneFlags[begin]);
+
+    for (size_t g = begin; g < end; g++)
+        ResolveGame((int)g);
+}
+
+/**
+ * BatchSimulation::Run
+ * ============================
+ * Objective:
+ *   Play every game for up to maxTicks more ticks or until it ends.
+ *
+ * Approach:
+ *   Chunks of `grain` games are the unit of work. A worker steps its chunk tick by
+ *   tick (all games of the chunk per tick, so the SoA fields stream through cache)
+ *   and stops early once every game in the chunk has ended; chunks that finish
+ *   early free their worker to steal the remaining ones.
+ */
+void BatchSimulation::Run(ThreadPool &pool, int maxTicks, BatchPolicy policy, size_t grain)
+{
+    pool.ParallelFor(gameCount, grain, [&](size_t begin, size_t end, unsigned int) {
+        for (int t = 0; t < maxTicks && begin < end; t++)
+        {
+            StepRange(begin, end, policy);
+            while (begin < end && !alive[begin])
+                begin++; // games that ended at either edge drop out of the range
+            while (begin < end && !alive[end - 1])
+                end--;
+        }
+    });
+}
+
+/**
+ * BatchSimulation::TotalTicks
+ * ============================
+ * Return Value:
+ *   - long long → ticks played across all games.
+ */
+long long BatchSimulation::TotalTicks() const
+{
+    long long total = 0;
+    for (int g = 0; g < gameCount; g++)
+        total += ticks[g];
+    return total;
+}
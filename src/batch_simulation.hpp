@@ -0,0 +1,165 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "batch_kernels.hpp"
+#include "rng.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * =============================
+ * BatchSimulation Overview
+ * =============================
+ * Runs many independent snake games at once for bot evaluation. The rules match
+ * Simulation (move, eat, edge, tail, board full), but the state of all games is
+ * stored structure-of-arrays: one array per field, indexed by game. A tick then
+ * walks each field linearly across a chunk of games, which keeps the hot loop in
+ * cache and leaves room for vectorised kernels over lanes of games.
+ *
+ * A tick over a range of games runs in three passes: every game picks its move
+ * and computes its new head; one CheckLanes call (batch_kernels.hpp) tests all
+ * those heads against the board bounds and every fruit with AVX2 or NEON,
+ * 8-16 games per instruction; then each game applies its move from the flags.
+ * The kernel is chosen by CPU detection and can be forced with SetKernel; every
+ * kernel gives identical results.
+ *
+ * Games are stepped in chunks of `grain` games on a work-stealing ThreadPool.
+ * Each game owns a deterministic Rng stream (the base seed jumped once per game),
+ * used both for fruit placement and for the bot policy, so a run's results are
+ * identical for any thread count or scheduling.
+ *
+ * =============================
+ * State layout (per game g)
+ * =============================
+ * - headX[g], headY[g]           : head cell.
+ * - dirX[g], dirY[g]             : current direction.
+ * - length[g], ringFirst[g]      : body length and ring index of the head.
+ * - body[g * ringSize + i]       : ring of cell indices (y * boardSize + x).
+ * - occupancy[g * wordsPerGame]  : one bit per cell.
+ * - fruitX/fruitY[k * games + g] : fruit k of game g (fruit-major, so fruit k of
+ *                                  neighbouring games is contiguous).
+ * - grow[g], alive[g], won[g]    : pending growth and round state.
+ * - score[g], ticks[g]           : results so far.
+ * - rng[g]                       : the game's random stream.
+ * - nextX[g], nextY[g], laneFlags[g] : per-tick scratch: the new head and its kernel flags.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **BatchSimulation(int games, int boardSize, uint64_t seed)**
+ *   - Objective: allocate all state and start every game.
+ *
+ * **void Reset(uint64_t seed)**
+ *   - Objective: restart every game from new streams of `seed`.
+ *
+ * **void Run(ThreadPool &pool, int maxTicks, BatchPolicy policy, size_t grain)**
+ *   - Objective: play every game until it ends or reaches maxTicks.
+ *
+ * **void StepRange(size_t begin, size_t end, BatchPolicy policy)**
+ *   - Objective: advance games [begin, end) by one tick (single threaded).
+ *
+ * **void StepActions(size_t begin, size_t end, const int32_t *actions)**
+ *   - Objective: the same with the moves given by the caller, actions[g] for game g
+ *                (0 right, 1 down, 2 left, 3 up); a reversal keeps the heading, as
+ *                the game's input queue does. Used by the training environment.
+ *
+ * **void ResetGame(int game) / void ResetGame(int game, uint64_t seed)**
+ *   - Objective: restart one game, continuing its random stream / on a fresh
+ *                stream of `seed`.
+ *
+ * **Head / Tail / BodyCell / Length / FruitCell / Occupied / Score / Won**
+ *   - Return: read access to one game's state for observation encoders; cells are
+ *             indices y * boardSize + x, and an inactive fruit is -1.
+ *
+ * **void SetKernel(LaneKernel kernel)**
+ *   - Objective: force the collision kernel (unsupported kernels run as Scalar).
+ *
+ * **BatchResult Result(int game)**
+ *   - Return: score, ticks played and whether the game filled the board.
+ */
+
+enum class BatchPolicy
+{
+    Random, ///< straight most of the time, random safe turns otherwise
+    Greedy  ///< steer toward the first fruit, fall back to a safe move
+};
+
+struct BatchResult
+{
+    int score; ///< fruits eaten
+    int ticks; ///< ticks survived
+    bool won;  ///< ended by filling the board
+};
+
+class BatchSimulation
+{
+public:
+    static constexpr int fruitCount = 3; // same as Simulation::fruitCount
+    static_assert(fruitCount <= 7, "fruit hits must fit the lane flag byte");
+
+    BatchSimulation(int games, int size, uint64_t seed);
+
+    void Reset(uint64_t seed);
+    void Run(ThreadPool &pool, int maxTicks, BatchPolicy policy, size_t grain = 64);
+    void StepRange(size_t begin, size_t end, BatchPolicy policy);
+    void StepActions(size_t begin, size_t end, const int32_t *actions);
+    void ResetGame(int game);
+    void ResetGame(int game, uint64_t seed);
+
+    int GameCount() const { return gameCount; }
+    int BoardSize() const { return boardSize; }
+    void SetKernel(LaneKernel laneKernel) { kernel = laneKernel; }
+    LaneKernel Kernel() const { return kernel; }
+    bool Alive(int game) const { return alive[game] != 0; }
+    BatchResult Result(int game) const { return BatchResult{score[game], ticks[game], won[game] != 0}; }
+    long long TotalTicks() const;
+
+    int Head(int game) const { return headY[game] * boardSize + headX[game]; }
+    int Tail(int game) const { return BodyCell(game, length[game] - 1); }
+    int BodyCell(int game, uint32_t i) const { return (int)body[(size_t)game * ringSize + ((ringFirst[game] + i) & ringMask)]; }
+    uint32_t Length(int game) const { return length[game]; }
+    int FruitCell(int game, int fruit) const
+    {
+        size_t slot = (size_t)fruit * gameCount + game;
+        return fruitX[slot] < 0 ? -1 : fruitY[slot] * boardSize + fruitX[slot];
+    }
+    bool Occupied(int game, int index) const { return TestCell(game, index); }
+    int Score(int game) const { return score[game]; }
+    bool Won(int game) const { return won[game] != 0; }
+
+private:
+    void MoveGame(int game, BatchPolicy policy);
+    void ApplyMove(int game, int direction);
+    void ResolveRange(size_t begin, size_t end);
+    void ResolveGame(int game);
+    void PlaceFruit(int game, int fruit);
+    int ChooseDirection(int game, BatchPolicy policy);
+    bool IsSafe(int game, int x, int y) const;
+
+    bool TestCell(int game, int index) const
+    {
+        return (occupancy[(size_t)game * wordsPerGame + (index >> 6)] >> (index & 63)) & 1;
+    }
+    void SetCell(int game, int index) { occupancy[(size_t)game * wordsPerGame + (index >> 6)] |= 1ULL << (index & 63); }
+    void ClearCell(int game, int index) { occupancy[(size_t)game * wordsPerGame + (index >> 6)] &= ~(1ULL << (index & 63)); }
+
+    int gameCount;
+    int boardSize;
+    int cellCount;          // boardSize * boardSize
+    uint32_t ringSize;      // power of two >= cellCount + 1
+    uint32_t ringMask;
+    int wordsPerGame;       // 64-bit words of occupancy per game
+
+    std::vector<int16_t> headX, headY;
+    std::vector<int8_t> dirX, dirY;
+    std::vector<uint32_t> length, ringFirst;
+    std::vector<uint32_t> body;
+    std::vector<uint64_t> occupancy;
+    std::vector<int16_t> fruitX, fruitY;
+    std::vector<uint8_t> grow, alive, won;
+    std::vector<int32_t> score, ticks;
+    std::vector<Rng> rng;
+    std::vector<int16_t> nextX, nextY; // head after this tick's move
+    std::vector<uint8_t> laneFlags;    // CheckLanes output for this tick
+    LaneKernel kernel = BestLaneKernel();
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+/**
+ * =============================
+ * Board Geometry Overview
+ * =============================
+ * The size of a square board as a type, so code that runs every tick can be
+ * compiled once for the shipped board and once for any size. Board<N> holds N as a
+ * compile-time constant. Bounds checks then compare against an immediate, row-major
+ * indices multiply by a constant, and anything derived from N, such as the number
+ * of occupancy chunks per row, folds away. Board<0>, alias DynamicBoard, has the
+ * same interface with the size read at run time, so every board size keeps working.
+ *
+ * Hot functions take the geometry as a template parameter, for example
+ * Snake::Update(B board). Simulation::Update picks FixedBoard when the board is
+ * SNAKE_FIXED_BOARD cells across and DynamicBoard otherwise. That is one branch per
+ * tick, and the simulation cannot tell which path ran.
+ *
+ * SNAKE_FIXED_BOARD defaults to the shipped 25 x 25 board. A build can set it to
+ * another size (premake5 --fixed-board=N), or to 0 to compile only the dynamic path,
+ * which is how the two are compared.
+ *
+ * =============================
+ * Members (both forms)
+ * =============================
+ * **int Size() const** - cells per row/column.
+ * **int Cells() const** - Size() * Size().
+ * **bool InBounds(Cell cell) const** - both coordinates within [0, Size()-1].
+ * **int Index(Cell cell) const** - row-major index y * Size() + x of an in-bounds cell.
+ */
+#ifndef SNAKE_FIXED_BOARD
+#define SNAKE_FIXED_BOARD 25 // board size the tick is specialised for; 0 builds only the dynamic path
+#endif
+
+template <int N>
+struct Board
+{
+    static_assert(N > 0 && N <= 4096, "Board<N> needs a size the 16-bit Cell can address");
+
+    constexpr Board() = default;
+    constexpr int Size() const { return N; }
+    constexpr int Cells() const { return N * N; }
+
+    template <typename C>
+    constexpr bool InBounds(C cell) const
+    {
+        return (unsigned)cell.x < (unsigned)N && (unsigned)cell.y < (unsigned)N; // negatives wrap past N
+    }
+
+    template <typename C>
+    constexpr int Index(C cell) const
+    {
+        return cell.y * N + cell.x;
+    }
+};
+
+template <>
+struct Board<0>
+{
+    int size;
+
+    constexpr explicit Board(int boardSize) : size(boardSize) {}
+    constexpr int Size() const { return size; }
+    constexpr int Cells() const { return size * size; }
+
+    template <typename C>
+    constexpr bool InBounds(C cell) const
+    {
+        return (unsigned)cell.x < (unsigned)size && (unsigned)cell.y < (unsigned)size;
+    }
+
+    template <typename C>
+    constexpr int Index(C cell) const
+    {
+        return cell.y * size + cell.x;
+    }
+};
+
+typedef Board<0> DynamicBoard; ///< Size known at run time: any board.
+#if SNAKE_FIXED_BOARD > 0
+typedef Board<SNAKE_FIXED_BOARD> FixedBoard; ///< The board the tick is specialised for.
+#endif
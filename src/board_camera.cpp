@@ -0,0 +1,126 @@
+#include "board_camera.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * BoardCamera::BoardCamera
+ * ============================
+ * Objective:
+ *   Centre the board in the viewport at the starting zoom.
+ *
+ * Input:
+ *   - Rectangle screenView → on-screen area the board is drawn into (square).
+ *   - float worldPixels → board size in board space (cells * cell pixels).
+ *   - float startZoom → initial zoom; also the upper bound of the smallest zoom, so a
+ *                       board smaller than the view is never shrunk further.
+ */
+BoardCamera::BoardCamera(Rectangle screenView, float worldPixels, float startZoom)
+    : viewport(screenView), boardPixels(worldPixels)
+{
+    minZoom = std::min(startZoom, viewport.width / boardPixels);
+    maxZoom = std::max(startZoom, 3.0f);
+    camera.offset = Vector2{viewport.x + viewport.width / 2, viewport.y + viewport.height / 2};
+    camera.target = Vector2{boardPixels / 2, boardPixels / 2};
+    camera.rotation = 0.0f;
+    camera.zoom = startZoom;
+    Clamp();
+}
+
+/**
+ * BoardCamera::Update
+ * ============================
+ * Objective:
+ *   Handle the camera controls for this frame and follow `focus`.
+ *
+ * Side Effects:
+ *   - Reads the mouse wheel, mouse buttons and the C key.
+ *
+ * Approach:
+ *   The wheel zooms by 10% per notch. While following, zoom happens about the
+ *   focus; otherwise the board point under the cursor stays under it. Dragging
+ *   moves the target by the mouse delta in board space and stops following.
+ *
+ * Variable definition and use:
+ *   before - board point under the cursor before the zoom changed
+ */
+void BoardCamera::Update(Vector2 focus)
+{
+    Vector2 mouse = GetMousePosition();
+    bool inView = CheckCollisionPointRec(mouse, viewport);
+
+    float wheel = GetMouseWheelMove();
+    if (wheel != 0.0f && inView)
+    {
+        Vector2 before = GetScreenToWorld2D(mouse, camera);
+        camera.zoom = std::clamp(camera.zoom * std::pow(1.1f, wheel), minZoom, maxZoom);
+        if (!following)
+        {
+            Vector2 after = GetScreenToWorld2D(mouse, camera);
+            camera.target = Vector2{camera.target.x + before.x - after.x, camera.target.y + before.y - after.y};
+        }
+    }
+
+    if (inView && (IsMouseButtonDown(MOUSE_BUTTON_RIGHT) || IsMouseButtonDown(MOUSE_BUTTON_MIDDLE)))
+    {
+        Vector2 delta = GetMouseDelta();
+        if (delta.x != 0.0f || delta.y != 0.0f)
+        {
+            camera.target = Vector2{camera.target.x - delta.x / camera.zoom, camera.target.y - delta.y / camera.zoom};
+            following = false; // the player is looking elsewhere
+        }
+    }
+    if (IsKeyPressed(KEY_C))
+        following = true;
+
+    if (following)
+        camera.target = focus;
+    Clamp();
+}
+
+/**
+ * BoardCamera::Clamp
+ * ============================
+ * Objective:
+ *   Keep the view inside the board; centre the board when it is smaller than the view.
+ */
+void BoardCamera::Clamp()
+{
+    float half = viewport.width / 2 / camera.zoom; // half the view in board space
+    if (2 * half >= boardPixels)
+        camera.target = Vector2{boardPixels / 2, boardPixels / 2};
+    else
+        camera.target = Vector2{std::clamp(camera.target.x, half, boardPixels - half),
+                                std::clamp(camera.target.y, half, boardPixels - half)};
+}
+
+/**
+ * BoardCamera::Begin / BoardCamera::End
+ * ============================
+ * Objective:
+ *   Clip to the viewport and draw in board space until End().
+ */
+void BoardCamera::Begin() const
+{
+    BeginScissorMode((int)viewport.x, (int)viewport.y, (int)viewport.width, (int)viewport.height);
+    BeginMode2D(camera);
+}
+
+void BoardCamera::End() const
+{
+    EndMode2D();
+    EndScissorMode();
+}
+
+/**
+ * BoardCamera::VisibleArea
+ * ============================
+ * Objective:
+ *   Board-space rectangle currently shown in the viewport.
+ */
+Rectangle BoardCamera::VisibleArea() const
+{
+    float width = viewport.width / camera.zoom;
+    float height = viewport.height / camera.zoom;
+    return Rectangle{camera.target.x - width / 2, camera.target.y - height / 2, width, height};
+}
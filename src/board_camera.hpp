@@ -0,0 +1,67 @@
+#pragma once
+#include <raylib.h>
+
+/**
+ * =============================
+ * Class Overview
+ * =============================
+ * The **BoardCamera** class maps board space (cell (0,0) at the origin) into a
+ * fixed on-screen viewport, so the window no longer has to grow with the board.
+ * It follows a point (the snake's head) by default; the player can zoom with the
+ * mouse wheel and pan by dragging with the right or middle button, which stops
+ * following until C is pressed. The view is clamped to the board, and the
+ * smallest zoom shows the whole board at once.
+ *
+ * Drawing between Begin() and End() is clipped to the viewport with a scissor
+ * rectangle, and VisibleArea() tells renderers which part of the board needs
+ * drawing at all.
+ *
+ * =============================
+ * Member Variables (private)
+ * =============================
+ * - **Camera2D camera**     : raylib camera; offset is the viewport centre.
+ * - **Rectangle viewport**  : on-screen area of the board view.
+ * - **float boardPixels**   : width and height of the board in board space.
+ * - **float minZoom, maxZoom** : zoom limits (whole board ... close-up).
+ * - **bool following**      : whether Update() centres on the followed point.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **BoardCamera(Rectangle screenView, float worldPixels, float startZoom)**
+ *   - Objective: show the board at `startZoom` inside `screenView`.
+ *
+ * **void Update(Vector2 focus)**
+ *   - Objective: apply wheel zoom, drag panning and the C key, then centre on
+ *                `focus` (board space) while following, and clamp to the board.
+ *
+ * **void Begin() const / void End() const**
+ *   - Objective: enter/leave the clipped 2D mode (inside BeginDrawing).
+ *
+ * **Rectangle VisibleArea() const**
+ *   - Return: the part of board space shown in the viewport.
+ *
+ * **float Zoom() const**
+ *   - Return: screen pixels per board-space pixel.
+ */
+class BoardCamera
+{
+public:
+    BoardCamera(Rectangle screenView, float worldPixels, float startZoom);
+
+    void Update(Vector2 focus);
+    void Begin() const;
+    void End() const;
+    Rectangle VisibleArea() const;
+    float Zoom() const { return camera.zoom; }
+
+private:
+    void Clamp();
+
+    Camera2D camera;     ///< Target is the board-space point at the viewport centre.
+    Rectangle viewport;  ///< On-screen board view.
+    float boardPixels;   ///< Board width/height in board space.
+    float minZoom;       ///< Whole board visible.
+    float maxZoom;       ///< Closest allowed zoom.
+    bool following = true; ///< Centre on the focus point every Update().
+};
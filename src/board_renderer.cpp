@@ -0,0 +1,420 @@
+#include "board_renderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <rlgl.h>
+
+static const int quadsPerBatch = 1024; // well under raylib's default 8192-quad vertex buffer
+
+/**
+ * BoardRenderer::BoardRenderer
+ * ============================
+ * Objective:
+ *   Rasterise the rounded snake segment once and size the chunk table for the board.
+ *
+ * Input:
+ *   - int pixels → size of a cell in board space; the sprite is baked at exactly this
+ *                  size so it is drawn 1:1 at zoom 1.
+ *   - int cells → cells per row/column of the board.
+ *
+ * Side Effects:
+ *   - Creates a render texture on the GPU; chunk textures are created on first use.
+ *
+ * Approach:
+ *   The segment is drawn in white with the same roundness and corner count the old
+ *   per-segment path used, so tinting it with darkGreen at draw time gives the same
+ *   pixels. Bilinear filtering keeps it smooth when the camera zooms; at zoom 1 the
+ *   quads sit on whole pixels and sample texel centres, so nothing changes there.
+ */
+BoardRenderer::BoardRenderer(int pixels, int cells)
+    : cellPixels(pixels), boardSize(cells)
+{
+    segmentSprite = LoadRenderTexture(cellPixels, cellPixels);
+    BeginTextureMode(segmentSprite);
+    ClearBackground(BLANK); // transparent outside the rounded corners
+    DrawRectangleRounded(Rectangle{0, 0, (float)cellPixels, (float)cellPixels}, 0.5, 6, WHITE);
+    EndTextureMode();
+    SetTextureFilter(segmentSprite.texture, TEXTURE_FILTER_BILINEAR);
+
+    int chunksPerRow = (boardSize + OccupancyGrid::chunkCells - 1) >> OccupancyGrid::chunkShift;
+    chunks.resize(chunksPerRow * chunksPerRow);
+    texels.resize(4 * OccupancyGrid::chunkCells * OccupancyGrid::chunkCells);
+}
+
+/**
+ * BoardRenderer::SetFoodAtlas
+ * ============================
+ * Objective:
+ *   Install the food atlas and derive the tile size from it.
+ *
+ * Approach:
+ *   The atlas (see BuildFoodAtlas) places food1..foodN left to right; a fruit's
+ *   textureIndex is its tile column.
+ */
+void BoardRenderer::SetFoodAtlas(TextureHandle atlas)
+{
+    foodAtlas = std::move(atlas); // drops the previous atlas, if any
+    foodWidth = foodAtlas.Get().width / Food::textureCount;
+    foodHeight = foodAtlas.Get().height;
+}
+
+/**
+ * BoardRenderer::~BoardRenderer
+ * ============================
+ * Objective:
+ *   Release the segment sprite and every chunk texture; the atlas handle releases itself.
+ */
+BoardRenderer::~BoardRenderer()
+{
+    UnloadRenderTexture(segmentSprite);
+    for (ChunkTile &tile : chunks)
+        if (tile.texture.id != 0)
+            UnloadTexture(tile.texture);
+}
+
+/**
+ * BoardRenderer::Quad
+ * ============================
+ * Objective:
+ *   Append one textured quad to the open RL_QUADS batch.
+ *
+ * Input:
+ *   - Vector2 position → top-left corner in board space.
+ *   - float width, height → size in board space.
+ *   - Rectangle uv → normalised texture coordinates (x, y, width, height).
+ *   - Color tint → vertex colour multiplied with the texture.
+ *
+ * Approach:
+ *   Same vertex order and winding as raylib's DrawTexturePro: top-left,
+ *   bottom-left, bottom-right, top-right.
+ */
+void BoardRenderer::Quad(Vector2 position, float width, float height, Rectangle uv, Color tint)
+{
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    rlTexCoord2f(uv.x, uv.y);
+    rlVertex2f(position.x, position.y);
+    rlTexCoord2f(uv.x, uv.y + uv.height);
+    rlVertex2f(position.x, position.y + height);
+    rlTexCoord2f(uv.x + uv.width, uv.y + uv.height);
+    rlVertex2f(position.x + width, position.y + height);
+    rlTexCoord2f(uv.x + uv.width, uv.y);
+    rlVertex2f(position.x + width, position.y);
+}
+
+/**
+ * BoardRenderer::Refresh
+ * ============================
+ * Objective:
+ *   Bring one chunk's cached state up to the grid's version of it: the covered-cell
+ *   count always, and with `upload` also its texel texture.
+ *
+ * Input:
+ *   - uint32_t version → the grid's current version of the chunk.
+ *   - Shade shade → colour of cell (x, y), alpha 0 where nothing is drawn.
+ *
+ * Side Effects:
+ *   - May create or update the chunk's texture on the GPU.
+ *
+ * Approach:
+ *   A chunk whose version matches what the tile was built from is untouched, so
+ *   only the chunks the heads and tails moved through are rescanned. Grid versions
+ *   start at 1, so the tiles' initial 0 always mismatches. Texels hold the shade
+ *   colour directly and tiles are drawn untinted. A chunk that is still empty gets
+ *   no texture at all.
+ *
+ * Variable definition and use:
+ *   n - cells per chunk row; baseX, baseY - first cell of the chunk
+ */
+template <typename Shade>
+void BoardRenderer::Refresh(uint32_t version, int chunk, int chunksPerRow, bool upload, Shade shade)
+{
+    ChunkTile &tile = chunks[chunk];
+    if (tile.countVersion == version && (!upload || tile.textureVersion == version))
+        return;
+
+    const int n = OccupancyGrid::chunkCells;
+    const int baseX = (chunk % chunksPerRow) * n;
+    const int baseY = (chunk / chunksPerRow) * n;
+    int covered = 0;
+    for (int y = 0; y < n; y++)
+    {
+        for (int x = 0; x < n; x++)
+        {
+            bool inside = baseX + x < boardSize && baseY + y < boardSize; // edge chunks overhang the board
+            Color color = inside ? shade(baseX + x, baseY + y) : BLANK;
+            covered += color.a != 0;
+            if (upload)
+            {
+                unsigned char *texel = &texels[4 * (y * n + x)];
+                texel[0] = color.r;
+                texel[1] = color.g;
+                texel[2] = color.b;
+                texel[3] = color.a;
+            }
+        }
+    }
+    tile.covered = covered;
+    tile.countVersion = version;
+    if (!upload)
+        return;
+
+    tile.textureVersion = version;
+    if (tile.texture.id != 0)
+        UpdateTexture(tile.texture, texels.data());
+    else if (covered > 0)
+        tile.texture = LoadTextureFromImage(Image{texels.data(), n, n, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8});
+}
+
+/**
+ * BoardRenderer::DrawCells
+ * ============================
+ * Objective:
+ *   Emit one sprite quad per covered cell of the rectangle [fromX, toX) x [fromY, toY),
+ *   except cell index hiddenCell (-1 for none).
+ *
+ * Approach:
+ *   One rlgl batch per row, with rlCheckRenderBatchLimit before it, so even a
+ *   fully covered view flushes cleanly; rows sharing the sprite still merge into
+ *   one draw call. Render textures are stored bottom-up, so the sprite is sampled
+ *   with V flipped.
+ */
+template <typename Shade>
+void BoardRenderer::DrawCells(int fromX, int fromY, int toX, int toY, Shade shade, int hiddenCell)
+{
+    const Rectangle flipped = {0.0f, 1.0f, 1.0f, -1.0f};
+    const float size = (float)cellPixels;
+    for (int y = fromY; y < toY; y++)
+    {
+        rlCheckRenderBatchLimit(4 * (toX - fromX));
+        rlSetTexture(segmentSprite.texture.id);
+        rlBegin(RL_QUADS);
+        for (int x = fromX; x < toX; x++)
+        {
+            Color color = shade(x, y);
+            if (color.a != 0 && y * boardSize + x != hiddenCell)
+                Quad(Vector2{x * size, y * size}, size, size, flipped, color);
+        }
+        rlEnd();
+    }
+}
+
+/**
+ * BoardRenderer::DrawGrid
+ * ============================
+ * Objective:
+ *   Draw every shaded cell that lies inside the visible part of the board.
+ *
+ * Input:
+ *   - const uint32_t *versions, int chunksPerRow → the grid's chunk table.
+ *   - Rectangle view → visible area in board space (BoardCamera::VisibleArea).
+ *   - float zoom → screen pixels per board-space pixel.
+ *   - Shade shade → colour of cell (x, y), alpha 0 where nothing is drawn.
+ *   - int hiddenCell → cell index to leave out of the sprites (the caller draws it
+ *                      itself), or -1; tiles always include it.
+ *
+ * Approach:
+ *   Clamp the view to the board and walk the chunks it touches. Chunks without a
+ *   covered cell are skipped outright. When a cell is at least detailPixels on
+ *   screen, the covered cells of the chunk that are in view are drawn as sprites;
+ *   below that the rounded shape is not visible anyway, so the chunk is a single
+ *   quad of its texel texture (nearest filtering keeps cells crisp).
+ *
+ * Variable definition and use:
+ *   firstX..lastY - visible cells, half open; chunkSize - board-space size of a chunk
+ */
+template <typename Shade>
+void BoardRenderer::DrawGrid(const uint32_t *versions, int chunksPerRow, Rectangle view, float zoom,
+                             Shade shade, int hiddenCell)
+{
+    const int n = OccupancyGrid::chunkCells;
+    const float size = (float)cellPixels;
+    const float chunkSize = n * size;
+    const bool tiles = size * zoom < detailPixels;
+
+    int firstX = std::max(0, (int)std::floor(view.x / size));
+    int firstY = std::max(0, (int)std::floor(view.y / size));
+    int lastX = std::min(boardSize, (int)std::ceil((view.x + view.width) / size));
+    int lastY = std::min(boardSize, (int)std::ceil((view.y + view.height) / size));
+
+    for (int chunkY = firstY / n; chunkY * n < lastY; chunkY++)
+    {
+        for (int chunkX = firstX / n; chunkX * n < lastX; chunkX++)
+        {
+            int chunk = chunkY * chunksPerRow + chunkX;
+            Refresh(versions[chunk], chunk, chunksPerRow, tiles, shade);
+            const ChunkTile &tile = chunks[chunk];
+            if (tile.covered == 0)
+                continue; // nothing to draw in this chunk
+
+            if (tiles)
+            {
+                rlCheckRenderBatchLimit(4);
+                rlSetTexture(tile.texture.id);
+                rlBegin(RL_QUADS);
+                Quad(Vector2{chunkX * chunkSize, chunkY * chunkSize}, chunkSize, chunkSize, Rectangle{0, 0, 1, 1}, WHITE);
+                rlEnd();
+            }
+            else
+            {
+                DrawCells(std::max(firstX, chunkX * n), std::max(firstY, chunkY * n),
+                          std::min(lastX, (chunkX + 1) * n), std::min(lastY, (chunkY + 1) * n), shade, hiddenCell);
+            }
+        }
+    }
+    rlSetTexture(0);
+}
+
+/**
+ * BoardRenderer::DrawSnake
+ * ============================
+ * Objective:
+ *   Draw the single snake's covered cells in `tint` (see DrawGrid), with the head and
+ *   the tail in between ticks when `motion` is given.
+ *
+ * Approach:
+ *   The grid holds the current tick. The head's cell is left out of the sprites and
+ *   drawn instead at the interpolated position between the previous head (still a
+ *   body cell) and the current one, so the head grows out of the neck. The popped
+ *   tail cell is drawn sliding onto the current tail, which shrinks the end of the
+ *   body. Nothing here depends on the body length.
+ */
+void BoardRenderer::DrawSnake(const OccupancyGrid &occupancy, Rectangle view, float zoom, Color tint,
+                              const SnakeMotion *motion)
+{
+    const float size = (float)cellPixels;
+    bool interpolate = motion && size * zoom >= detailPixels;
+    int hiddenCell = interpolate ? motion->headTo.y * boardSize + motion->headTo.x : -1;
+    DrawGrid(occupancy.chunkVersion.data(), occupancy.chunksPerRow, view, zoom, [&](int x, int y)
+    {
+        return occupancy.cells[y * boardSize + x] ? tint : BLANK;
+    }, hiddenCell);
+    if (!interpolate)
+        return;
+
+    auto between = [&](Cell from, Cell to)
+    {
+        float t = motion->fraction;
+        return Vector2{(from.x + (to.x - from.x) * t) * size, (from.y + (to.y - from.y) * t) * size};
+    };
+    const Rectangle flipped = {0.0f, 1.0f, 1.0f, -1.0f};
+    rlCheckRenderBatchLimit(8);
+    rlSetTexture(segmentSprite.texture.id);
+    rlBegin(RL_QUADS);
+    if (motion->tailMoving)
+        Quad(between(motion->tailFrom, motion->tailTo), size, size, flipped, tint);
+    Quad(between(motion->headFrom, motion->headTo), size, size, flipped, tint);
+    rlEnd();
+    rlSetTexture(0);
+}
+
+/**
+ * BoardRenderer::DrawArena
+ * ============================
+ * Objective:
+ *   Draw every arena snake (see DrawGrid). Snake `player` is palette[0]; the others,
+ *   in index order, cycle through palette[1..paletteSize-1]. Fruit cells are left
+ *   to DrawFruits.
+ *
+ * Approach:
+ *   With motions, as in DrawSnake but for every snake: a cell that is the headTo of
+ *   the snake owning it is left out of the sprites, and once the grid is drawn each
+ *   snake gets its head (and moving tail) quad. Heads are found from the owner of
+ *   the cell, so hiding them costs one compare per drawn cell, not a search.
+ */
+void BoardRenderer::DrawArena(const OwnerGrid &grid, Rectangle view, float zoom, const Color *palette, int paletteSize,
+                              int player, const SnakeMotion *motions, int motionCount)
+{
+    const float size = (float)cellPixels;
+    bool interpolate = motions && size * zoom >= detailPixels;
+    auto colour = [&](int snake)
+    {
+        if (snake == player)
+            return palette[0];
+        return palette[1 + (snake - (snake > player ? 1 : 0)) % (paletteSize - 1)];
+    };
+    DrawGrid(grid.chunkVersion.data(), grid.chunksPerRow, view, zoom, [&](int x, int y)
+    {
+        uint16_t owner = grid.owner[y * boardSize + x];
+        if (owner == OwnerGrid::unowned || owner >= OwnerGrid::fruitTag)
+            return BLANK;
+        int snake = owner - 1;
+        if (interpolate && snake < motionCount && motions[snake].headTo.x == x && motions[snake].headTo.y == y)
+            return BLANK; // drawn in between ticks below
+        return colour(snake);
+    });
+    if (!interpolate)
+        return;
+
+    // heads may slide in from one cell outside the view
+    const float left = view.x - size, top = view.y - size;
+    const float right = view.x + view.width + size, bottom = view.y + view.height + size;
+    auto between = [&](Cell from, Cell to, float t)
+    {
+        return Vector2{(from.x + (to.x - from.x) * t) * size, (from.y + (to.y - from.y) * t) * size};
+    };
+    const Rectangle flipped = {0.0f, 1.0f, 1.0f, -1.0f};
+    rlSetTexture(segmentSprite.texture.id);
+    for (int snake = 0; snake < motionCount; snake++)
+    {
+        const SnakeMotion &motion = motions[snake];
+        if (!grid.InBounds(motion.headTo) || grid.Owner(motion.headTo) != snake + 1)
+            continue; // dead, or waiting to respawn
+        Vector2 head = between(motion.headFrom, motion.headTo, motion.fraction);
+        if (head.x < left || head.x > right || head.y < top || head.y > bottom)
+            continue;
+        rlCheckRenderBatchLimit(8);
+        rlBegin(RL_QUADS);
+        if (motion.tailMoving)
+            Quad(between(motion.tailFrom, motion.tailTo, motion.fraction), size, size, flipped, colour(snake));
+        Quad(head, size, size, flipped, colour(snake));
+        rlEnd();
+    }
+    rlSetTexture(0);
+}
+
+/**
+ * BoardRenderer::DrawFruits
+ * ============================
+ * Objective:
+ *   Draw every active fruit inside the view from the atlas in one batch.
+ *
+ * Approach:
+ *   Each fruit selects its atlas column by textureIndex and is drawn at its native
+ *   size at the cell's top-left corner, matching the old DrawTextureV placement.
+ *   When that would be under detailPixels on screen the fruit is scaled up about
+ *   the cell centre instead, so food can still be spotted on a zoomed-out board.
+ *
+ * Variable definition and use:
+ *   grow - scale applied to the native tile size (1 unless zoomed far out)
+ */
+void BoardRenderer::DrawFruits(const Food *fruits, size_t count, Rectangle view, float zoom)
+{
+    const float size = (float)cellPixels;
+    const float tileU = 1.0f / Food::textureCount; // width of one tile in UV space
+    if (!foodAtlas)
+        return; // still loading
+
+    const float grow = foodWidth * zoom < detailPixels ? detailPixels / (foodWidth * zoom) : 1.0f;
+    const float width = foodWidth * grow;
+    const float height = foodHeight * grow;
+
+    rlCheckRenderBatchLimit(4 * (int)count);
+    rlSetTexture(foodAtlas.Get().id);
+    rlBegin(RL_QUADS);
+    for (size_t i = 0; i < count; i++)
+    {
+        const Food &f = fruits[i];
+        if (!f.active) // nothing to draw while the board is full
+            continue;
+        Vector2 pos = {f.position.x * size, f.position.y * size};
+        if (grow > 1.0f)
+            pos = Vector2{pos.x + (size - width) / 2, pos.y + (size - height) / 2};
+        if (pos.x > view.x + view.width || pos.y > view.y + view.height || pos.x + width < view.x || pos.y + height < view.y)
+            continue; // outside the view
+        Quad(pos, width, height, Rectangle{f.textureIndex * tileU, 0.0f, tileU, 1.0f}, WHITE);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include <raylib.h>
+#include <vector>
+
+#include "arena.hpp"
+#include "resource_cache.hpp"
+#include "simulation.hpp"
+
+/**
+ * =============================
+ * Class Overview
+ * =============================
+ * The **BoardRenderer** class draws the snake and the fruits with as few GPU
+ * draw calls and as little CPU tessellation as possible.
+ *
+ * The rounded segment shape is rasterised once into a RenderTexture at load time;
+ * every frame each segment is then a single textured quad instead of a
+ * DrawRectangleRounded call that rebuilds its corner fans on the CPU. The four
+ * food images are packed side by side into one atlas texture, so all fruits share
+ * one texture too. All quads of one texture are emitted inside one rlgl batch
+ * (rlBegin/rlEnd with the same texture bound), which raylib submits as a single
+ * draw call.
+ *
+ * Everything is drawn in board space (cell (0,0) at the origin, cellPixels per
+ * cell) inside the BoardCamera's 2D mode, and only what falls inside the visible
+ * rectangle is emitted, so the cost follows the view rather than the board size.
+ * Snakes are read from the grid chunk by chunk (see OccupancyGrid's chunkVersion;
+ * the arena's OwnerGrid uses the same chunks and colours each snake by its id):
+ *   - zoomed in, each visible chunk that holds any segment emits one sprite quad per
+ *     covered cell;
+ *   - zoomed out past detailPixels per cell, each visible chunk is one quad of a
+ *     small RGBA texture with one texel per cell, rebuilt only when the chunk's version
+ *     changed, so a 1000x1000 board costs a few hundred quads and about two chunk
+ *     uploads per tick.
+ *
+ * =============================
+ * Member Variables (private)
+ * =============================
+ * - **RenderTexture2D segmentSprite** : white rounded cell, tinted per draw.
+ * - **TextureHandle foodAtlas**       : food1..foodN.png in one row (shared through the cache).
+ * - **int foodWidth, foodHeight**     : size of one food tile inside the atlas.
+ * - **int cellPixels**                : size of a board cell in board space (1:1 at zoom 1).
+ * - **int boardSize**                 : cells per row/column.
+ * - **std::vector<ChunkTile> chunks**  : per grid chunk, its texel texture, the grid versions
+ *                                        it was built from and its covered-cell count.
+ * - **std::vector<unsigned char> texels** : scratch buffer for one chunk upload.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **BoardRenderer(int pixels, int cells)**
+ *   - Objective: bake the segment sprite for a cells x cells board.
+ *   - Side Effects: needs an open window (GPU context).
+ *
+ * **void SetFoodAtlas(TextureHandle atlas)**
+ *   - Objective: take a reference to the food atlas (see BuildFoodAtlas); fruits are
+ *                not drawn until it arrives.
+ *
+ * **~BoardRenderer()**
+ *   - Objective: free the sprite and the chunk textures and drop the atlas reference.
+ *
+ * **void DrawSnake(const OccupancyGrid &occupancy, Rectangle view, float zoom, Color tint, const SnakeMotion *motion)**
+ *   - Objective: draw every covered cell inside `view` (board space), as sprites or
+ *                as chunk tiles depending on the on-screen cell size. With `motion`,
+ *                the head and the tail are drawn part of the way between their cells
+ *                of the previous and the current tick (sprites only: tiles are too
+ *                small to show it). That is two extra quads whatever the length.
+ *
+ * **void DrawArena(const OwnerGrid &grid, Rectangle view, float zoom, const Color *palette, int paletteSize, int player,
+ *                  const SnakeMotion *motions, int motionCount)**
+ *   - Objective: the same for every arena snake: the player (snake `player`, 0 by
+ *                default) in palette[0], the others cycling through the rest
+ *                (paletteSize >= 2). With `motions` (motionCount entries, one per
+ *                snake index), each snake's head and tail are drawn in between ticks
+ *                like DrawSnake's; an entry whose headTo is not a cell of that snake
+ *                (a dead one) is skipped. That is up to two extra quads per snake.
+ *
+ * A renderer keeps chunk state for one grid, so it draws either a single snake or an
+ * arena, always with the same colours.
+ *
+ * **void DrawFruits(const Food *fruits, size_t count, Rectangle view, float zoom)**
+ *   - Objective: draw every active fruit inside `view` in one batch; zoomed out,
+ *                fruits keep at least detailPixels on screen so they stay visible.
+ *
+ * Both draw functions require an active BeginDrawing/EndDrawing block, normally
+ * inside BoardCamera::Begin/End.
+ */
+/*
+ * SnakeMotion struct
+ * Objective: where the head and the tail were before the last tick and how far the
+ *            display has got towards the current tick.
+ * Member variables:
+ *  - headFrom, headTo : previous and current head cell (body[1] and body[0])
+ *  - tailFrom, tailTo : popped tail cell and the current one; ignored unless tailMoving
+ *  - fraction : 0 shows the previous tick, 1 the current one
+ */
+struct SnakeMotion
+{
+    Cell headFrom;
+    Cell headTo;
+    Cell tailFrom;
+    Cell tailTo;
+    bool tailMoving;
+    float fraction;
+};
+
+class BoardRenderer
+{
+public:
+    static constexpr float detailPixels = 4.0f; // on-screen cell size below which chunks are drawn as tiles
+
+    BoardRenderer(int pixels, int cells);
+    ~BoardRenderer();
+    BoardRenderer(const BoardRenderer &) = delete; // owns GPU textures
+    BoardRenderer &operator=(const BoardRenderer &) = delete;
+
+    void SetFoodAtlas(TextureHandle atlas);
+    void DrawSnake(const OccupancyGrid &occupancy, Rectangle view, float zoom, Color tint,
+                   const SnakeMotion *motion = nullptr);
+    void DrawArena(const OwnerGrid &grid, Rectangle view, float zoom, const Color *palette, int paletteSize, int player = 0,
+                   const SnakeMotion *motions = nullptr, int motionCount = 0);
+    void DrawFruits(const Food *fruits, size_t count, Rectangle view, float zoom);
+
+private:
+    struct ChunkTile
+    {
+        Texture2D texture = {};      // one RGBA texel per cell; id 0 until first needed
+        uint32_t textureVersion = 0; // chunkVersion the texels were uploaded from
+        uint32_t countVersion = 0;   // chunkVersion `covered` was counted at
+        int covered = 0;             // covered cells at countVersion
+    };
+
+    void Quad(Vector2 position, float width, float height, Rectangle uv, Color tint);
+    template <typename Shade>
+    void DrawGrid(const uint32_t *versions, int chunksPerRow, Rectangle view, float zoom, Shade shade,
+                  int hiddenCell = -1);
+    template <typename Shade>
+    void Refresh(uint32_t version, int chunk, int chunksPerRow, bool upload, Shade shade);
+    template <typename Shade>
+    void DrawCells(int fromX, int fromY, int toX, int toY, Shade shade, int hiddenCell);
+
+    RenderTexture2D segmentSprite; ///< Pre-rasterised rounded cell (white, transparent corners).
+    TextureHandle foodAtlas;       ///< Every Food visual in one texture, indexed by textureIndex.
+    int foodWidth = 0;             ///< Width of one atlas tile in pixels.
+    int foodHeight = 0;            ///< Height of one atlas tile in pixels.
+    int cellPixels;                ///< Size of a board cell in board space.
+    int boardSize;                 ///< Cells per row/column.
+    std::vector<ChunkTile> chunks; ///< One per OccupancyGrid chunk, row-major.
+    std::vector<unsigned char> texels; ///< Scratch texels for one chunk upload.
+};
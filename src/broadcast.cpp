@@ -0,0 +1,567 @@
+#include "broadcast.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static const Cell broadcastDirections[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}; // right, down, left, up
+static const size_t headerBytes = 17; // magic, version, board size, interval, seed
+static const int maxRun = 32;         // ticks one run op can hold
+
+/*
+ * DirectionCode
+ * Objective: 2-bit code of a unit direction (index into broadcastDirections).
+ */
+static int DirectionCode(Cell direction)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        if (broadcastDirections[i] == direction)
+            return i;
+    }
+    return 0; // not a unit step; never produced by the game
+}
+
+/*
+ * WriteVarint / ReadVarint / VarintSize
+ * Objective: LEB128 unsigned integers, as in replay files.
+ * Return value: ReadVarint returns false when the value does not end before `end`.
+ */
+static void WriteVarint(std::vector<uint8_t> &out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+static bool ReadVarint(const std::vector<uint8_t> &in, size_t &pos, size_t end, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (pos >= end)
+            return false;
+        uint8_t byte = in[pos++];
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+static size_t VarintSize(uint64_t value)
+{
+    size_t bytes = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        bytes++;
+    }
+    return bytes;
+}
+
+static void WriteFruit(std::vector<uint8_t> &out, const Food &fruit, int boardSize)
+{
+    WriteVarint(out, (uint64_t)(fruit.active ? 1 : 0) | ((uint64_t)fruit.textureIndex << 1));
+    if (fruit.active)
+        WriteVarint(out, (uint64_t)(fruit.position.y * boardSize + fruit.position.x));
+}
+
+static bool SameFruit(const Food &a, const Food &b)
+{
+    return a.active == b.active && a.textureIndex == b.textureIndex && (!a.active || a.position == b.position);
+}
+
+/**
+ * BroadcastRecorder::Begin
+ * ============================
+ * Objective:
+ *   Start a recording at the simulation's current state: header and first keyframe.
+ *
+ * Approach:
+ *   Both buffers are reserved for the largest chunk an interval can produce (a
+ *   keyframe of a full board plus interval ticks that each ate every fruit), so
+ *   Record() never allocates as long as the pending bytes are taken about once a
+ *   chunk.
+ */
+void BroadcastRecorder::Begin(const Simulation &sim, uint32_t keyframeInterval)
+{
+    interval = std::clamp(keyframeInterval, 1u, 0xFFFFu);
+    tick = 0;
+    open = false;
+    size_t cells = (size_t)sim.boardSize * sim.boardSize;
+    size_t largestChunk = cells / 4 + 64 + (size_t)interval * (1 + Simulation::fruitCount * 7);
+    chunk.clear();
+    chunk.reserve(largestChunk);
+    pending.clear();
+    pending.reserve(2 * largestChunk + headerBytes);
+
+    pending.insert(pending.end(), {'S', 'N', 'K', 'B', 1});
+    pending.push_back((uint8_t)(sim.boardSize & 0xff));
+    pending.push_back((uint8_t)(sim.boardSize >> 8));
+    pending.push_back((uint8_t)(interval & 0xff));
+    pending.push_back((uint8_t)(interval >> 8));
+    for (int i = 0; i < 8; i++)
+        pending.push_back((uint8_t)(sim.seed >> (8 * i)));
+    OpenChunk(sim, 0);
+}
+
+/**
+ * BroadcastRecorder::OpenChunk
+ * ============================
+ * Objective:
+ *   Start a chunk whose keyframe is the simulation's current state.
+ *
+ * Input:
+ *   - int roundEnd → why the previous round ended (format codes), 0 when it did not.
+ */
+void BroadcastRecorder::OpenChunk(const Simulation &sim, int roundEnd)
+{
+    const SnakeBody &body = sim.snake.body;
+    const int size = sim.boardSize;
+    open = true;
+    chunkFirst = tick;
+    chunkTicks = 0;
+    runLength = 0;
+    chunk.clear();
+
+    WriteVarint(chunk, (uint64_t)sim.score);
+    uint64_t speedBits;
+    memcpy(&speedBits, &sim.speed, sizeof(speedBits));
+    for (int i = 0; i < 8; i++)
+        chunk.push_back((uint8_t)(speedBits >> (8 * i)));
+    chunk.push_back((uint8_t)(DirectionCode(sim.snake.direction) | (sim.snake.addSegment ? 4 : 0) | (roundEnd << 3)));
+    WriteVarint(chunk, body.size());
+    Cell tail = body.back();
+    WriteVarint(chunk, (uint64_t)(tail.y * size + tail.x));
+    uint8_t packed = 0;
+    for (unsigned int i = body.size() - 1; i > 0; i--)
+    {
+        unsigned int slot = (body.size() - 1 - i) & 3;
+        Cell step = {(int16_t)(body[i - 1].x - body[i].x), (int16_t)(body[i - 1].y - body[i].y)};
+        packed |= (uint8_t)(DirectionCode(step) << (2 * slot));
+        if (slot == 3 || i == 1)
+        {
+            chunk.push_back(packed);
+            packed = 0;
+        }
+    }
+    for (int k = 0; k < Simulation::fruitCount; k++)
+    {
+        WriteFruit(chunk, sim.fruits[k], size);
+        fruits[k] = sim.fruits[k];
+    }
+}
+
+/**
+ * BroadcastRecorder::FlushRun
+ * ============================
+ * Objective:
+ *   Write the straight run counted so far as one op byte.
+ */
+void BroadcastRecorder::FlushRun()
+{
+    if (runLength == 0)
+        return;
+    chunk.push_back((uint8_t)(0x80 | ((runLength - 1) << 2) | runDirection));
+    runLength = 0;
+}
+
+/**
+ * BroadcastRecorder::CloseChunk
+ * ============================
+ * Objective:
+ *   Move the open chunk, with its length and tick header, to the pending bytes.
+ */
+void BroadcastRecorder::CloseChunk()
+{
+    if (!open)
+        return;
+    FlushRun();
+    WriteVarint(pending, VarintSize(chunkFirst) + VarintSize(chunkTicks) + chunk.size());
+    WriteVarint(pending, chunkFirst);
+    WriteVarint(pending, chunkTicks);
+    pending.insert(pending.end(), chunk.begin(), chunk.end());
+    open = false;
+}
+
+/**
+ * BroadcastRecorder::Record
+ * ============================
+ * Objective:
+ *   Add the tick Simulation::Step() just ran to the recording. Call after the step.
+ *
+ * Approach:
+ *   A tick that ended the round closes the chunk; the reset board becomes the next
+ *   keyframe, tagged with the reason. Any other tick is a delta: its direction, plus
+ *   the slots whose fruit changed (an eaten fruit always respawns on another cell).
+ *   Ticks that ate nothing are counted into runs of one direction, so a snake going
+ *   straight costs one byte per 32 ticks. After `interval` deltas the chunk closes
+ *   and the current state starts the next one.
+ */
+void BroadcastRecorder::Record(const Simulation &sim, const TickEvents &events)
+{
+    if (!open)
+        return;
+    tick++;
+    if (events.RoundOver())
+    {
+        CloseChunk();
+        OpenChunk(sim, events.hitEdge ? 1 : events.hitTail ? 2 : 3);
+        return;
+    }
+
+    int direction = DirectionCode(sim.snake.direction);
+    int changed = 0;
+    for (int k = 0; k < Simulation::fruitCount; k++)
+        changed += SameFruit(fruits[k], sim.fruits[k]) ? 0 : 1;
+    if (changed == 0)
+    {
+        if (runLength > 0 && (runDirection != direction || runLength == maxRun))
+            FlushRun();
+        runDirection = direction;
+        runLength++;
+    }
+    else
+    {
+        FlushRun();
+        chunk.push_back((uint8_t)(direction | (changed << 2)));
+        for (int k = 0; k < Simulation::fruitCount; k++)
+        {
+            if (SameFruit(fruits[k], sim.fruits[k]))
+                continue;
+            chunk.push_back((uint8_t)k);
+            WriteFruit(chunk, sim.fruits[k], sim.boardSize);
+            fruits[k] = sim.fruits[k];
+        }
+    }
+    chunkTicks++;
+    if (chunkTicks >= interval)
+    {
+        CloseChunk();
+        OpenChunk(sim, 0);
+    }
+}
+
+void BroadcastRecorder::Finish()
+{
+    CloseChunk();
+}
+
+/**
+ * BroadcastRecorder::TakePending
+ * ============================
+ * Objective:
+ *   Append the finished bytes to `out`, keeping the reserved buffer.
+ */
+void BroadcastRecorder::TakePending(std::vector<uint8_t> &out)
+{
+    out.insert(out.end(), pending.begin(), pending.end());
+    pending.clear();
+}
+
+/**
+ * BroadcastPlayer::Load
+ * ============================
+ * Objective:
+ *   Read a broadcast file and index its chunks.
+ *
+ * Approach:
+ *   Every keyframe is parsed once, without building any state, to check it and to
+ *   find where its deltas start. Chunks must follow on from each other: an interval
+ *   keyframe repeats the last state of the chunk before it, a round-end keyframe is
+ *   the state after it. A trailing chunk that is cut short is left out, so a file
+ *   still being recorded plays up to its last whole chunk.
+ *
+ * Return Value:
+ *   - bool → false on I/O errors, a bad header or inconsistent chunks.
+ */
+bool BroadcastPlayer::Load(const char *path)
+{
+    data.clear();
+    chunks.clear();
+    positioned = false;
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return false;
+    uint8_t buffer[4096];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.insert(data.end(), buffer, buffer + got);
+    fclose(file);
+
+    if (data.size() < headerBytes || memcmp(data.data(), "SNKB", 4) != 0 || data[4] != 1)
+        return false;
+    boardSize = data[5] | (data[6] << 8);
+    keyframeInterval = data[7] | (data[8] << 8);
+    seed = 0;
+    for (int i = 0; i < 8; i++)
+        seed |= (uint64_t)data[9 + i] << (8 * i);
+    if (boardSize < 5 || boardSize > 4096)
+        return false;
+
+    size_t cursor = headerBytes;
+    while (cursor < data.size())
+    {
+        uint64_t length, first, ticks;
+        if (!ReadVarint(data, cursor, data.size(), length) || length > data.size() - cursor)
+            break; // cut off while being written
+        ChunkInfo info;
+        info.end = cursor + length;
+        if (!ReadVarint(data, cursor, info.end, first) || !ReadVarint(data, cursor, info.end, ticks) ||
+            first + ticks > UINT32_MAX)
+            return false;
+        info.firstTick = (uint32_t)first;
+        info.ticks = (uint32_t)ticks;
+        info.keyframe = cursor;
+        int roundEnd;
+        if (!ReadKeyframe(cursor, nullptr, roundEnd) || cursor > info.end)
+            return false;
+        info.deltas = cursor;
+
+        uint32_t follows = chunks.empty() ? 0 : chunks.back().firstTick + chunks.back().ticks + (roundEnd ? 1 : 0);
+        if (info.firstTick != follows || (chunks.empty() && roundEnd))
+            return false;
+        chunks.push_back(info);
+        cursor = info.end;
+    }
+    return !chunks.empty();
+}
+
+/**
+ * BroadcastPlayer::ReadFruit
+ * ============================
+ * Objective:
+ *   Decode one fruit; false when it does not fit the board.
+ */
+bool BroadcastPlayer::ReadFruit(size_t &at, Food &fruit) const
+{
+    uint64_t code, cell = 0;
+    if (!ReadVarint(data, at, data.size(), code) || (code >> 1) >= (uint64_t)Food::textureCount)
+        return false;
+    if ((code & 1) && (!ReadVarint(data, at, data.size(), cell) || cell >= (uint64_t)boardSize * boardSize))
+        return false;
+    fruit.active = code & 1;
+    fruit.textureIndex = (int)(code >> 1);
+    if (fruit.active)
+        fruit.position = Cell{(int16_t)(cell % boardSize), (int16_t)(cell / boardSize)};
+    return true;
+}
+
+/**
+ * BroadcastPlayer::ReadKeyframe
+ * ============================
+ * Objective:
+ *   Decode the keyframe at `at` into sim, or only check it when sim is null.
+ *
+ * Approach:
+ *   The body is rebuilt from the tail: each packed code is the step to the next
+ *   segment, and push_front() makes the last cell decoded the head. Occupancy is
+ *   cleared and set cell by cell, O(board) once per keyframe.
+ *
+ * Return Value:
+ *   - bool → false when the keyframe is truncated or leaves the board.
+ */
+bool BroadcastPlayer::ReadKeyframe(size_t &at, Simulation *sim, int &roundEnd) const
+{
+    const uint64_t cells = (uint64_t)boardSize * boardSize;
+    uint64_t score, length, tail;
+    if (!ReadVarint(data, at, data.size(), score) || data.size() - at < 9)
+        return false;
+    uint64_t speedBits = 0;
+    for (int i = 0; i < 8; i++)
+        speedBits |= (uint64_t)data[at + i] << (8 * i);
+    uint8_t flags = data[at + 8];
+    at += 9;
+    roundEnd = flags >> 3;
+    if (!ReadVarint(data, at, data.size(), length) || length == 0 || length > cells ||
+        !ReadVarint(data, at, data.size(), tail) || tail >= cells)
+        return false;
+    size_t packedBytes = (size_t)((length - 1 + 3) / 4);
+    if (data.size() - at < packedBytes)
+        return false;
+
+    Snake *snake = sim ? &sim->snake : nullptr;
+    if (snake)
+    {
+        snake->body.clear();
+        snake->occupancy.Clear();
+    }
+    Cell cell = {(int16_t)(tail % boardSize), (int16_t)(tail / boardSize)};
+    for (uint64_t i = 0;; i++)
+    {
+        if (cell.x < 0 || cell.y < 0 || cell.x >= boardSize || cell.y >= boardSize)
+            return false;
+        if (snake)
+        {
+            snake->body.push_front(cell);
+            snake->occupancy.Set(cell, true);
+        }
+        if (i + 1 == length)
+            break;
+        cell = cell + broadcastDirections[(data[at + i / 4] >> (2 * (i & 3))) & 3];
+    }
+    at += packedBytes;
+
+    for (int k = 0; k < Simulation::fruitCount; k++)
+    {
+        Food scratch;
+        if (!ReadFruit(at, sim ? sim->fruits[k] : scratch))
+            return false;
+    }
+    if (sim)
+    {
+        sim->score = (int)score;
+        memcpy(&sim->speed, &speedBits, sizeof(speedBits));
+        snake->direction = broadcastDirections[flags & 3];
+        snake->addSegment = (flags & 4) != 0;
+        snake->hitTail = false;
+        snake->tailMoved = false;
+    }
+    return true;
+}
+
+/**
+ * BroadcastPlayer::LoadKeyframe
+ * ============================
+ * Objective:
+ *   Put sim in the keyframe state of chunk `index` and the cursor on its deltas.
+ *
+ * Return Value:
+ *   - int → the keyframe's round end code.
+ */
+int BroadcastPlayer::LoadKeyframe(Simulation &sim, size_t index)
+{
+    size_t at = chunks[index].keyframe;
+    int roundEnd;
+    ReadKeyframe(at, &sim, roundEnd); // checked by Load()
+    current = index;
+    pos = chunks[index].deltas;
+    tick = chunks[index].firstTick;
+    runLeft = 0;
+    positioned = true;
+    return roundEnd;
+}
+
+uint32_t BroadcastPlayer::TickCount() const
+{
+    return chunks.empty() ? 0 : chunks.back().firstTick + chunks.back().ticks;
+}
+
+/**
+ * BroadcastPlayer::Seek
+ * ============================
+ * Objective:
+ *   Bring sim to the recorded state `target`.
+ *
+ * Approach:
+ *   Targets up to one interval ahead of the current state are stepped to. Anything
+ *   else loads the last keyframe at or before the target and steps from there, so
+ *   a seek costs at most one keyframe and keyframeInterval deltas wherever it lands.
+ */
+void BroadcastPlayer::Seek(Simulation &sim, uint32_t target)
+{
+    if (chunks.empty())
+        return;
+    target = std::min(target, TickCount());
+    if (!positioned || target < tick || target - tick > keyframeInterval)
+    {
+        auto after = std::upper_bound(chunks.begin(), chunks.end(), target,
+                                      [](uint32_t t, const ChunkInfo &c) { return t < c.firstTick; });
+        LoadKeyframe(sim, (size_t)(after - chunks.begin()) - 1);
+    }
+    while (tick < target)
+        Step(sim);
+}
+
+/**
+ * BroadcastPlayer::NextDirection
+ * ============================
+ * Objective:
+ *   Decode the direction code of the next delta and how many fruit records follow
+ *   it; -1 when the chunk has no more bytes (a damaged file).
+ */
+int BroadcastPlayer::NextDirection(size_t &fruitCount)
+{
+    fruitCount = 0;
+    if (runLeft > 0)
+    {
+        runLeft--;
+        return runDirection;
+    }
+    if (pos >= chunks[current].end)
+        return -1;
+    uint8_t op = data[pos++];
+    if (op & 0x80)
+    {
+        runDirection = op & 3;
+        runLeft = (op >> 2) & 31; // this tick is the first of the run
+        return runDirection;
+    }
+    fruitCount = (op >> 2) & 3;
+    return op & 3;
+}
+
+/**
+ * BroadcastPlayer::Step
+ * ============================
+ * Objective:
+ *   Advance sim by one recorded tick.
+ *
+ * Approach:
+ *   At the end of a chunk's deltas the next chunk either repeats this state (an
+ *   interval keyframe: carry on with its deltas, nothing is rebuilt) or starts a
+ *   new round (load its keyframe). A delta moves the snake with Snake::Update(), the
+ *   same code the live game runs, then applies the fruits that respawned and the
+ *   score and speed rules for each of them.
+ *
+ * Return Value:
+ *   - TickEvents → fruits eaten, or the reason the round ended.
+ */
+TickEvents BroadcastPlayer::Step(Simulation &sim)
+{
+    TickEvents events;
+    if (!positioned || tick >= TickCount())
+        return events;
+    while (tick == chunks[current].firstTick + chunks[current].ticks)
+    {
+        const ChunkInfo &next = chunks[current + 1]; // exists: tick < TickCount()
+        if (next.firstTick == tick)
+        {
+            current++;
+            pos = next.deltas;
+            runLeft = 0;
+            continue;
+        }
+        int roundEnd = LoadKeyframe(sim, current + 1);
+        events.hitEdge = roundEnd == 1;
+        events.hitTail = roundEnd == 2;
+        events.boardFull = roundEnd == 3;
+        return events;
+    }
+
+    size_t eaten;
+    int direction = NextDirection(eaten);
+    if (direction >= 0)
+        sim.snake.direction = broadcastDirections[direction];
+    sim.snake.Update();
+    const size_t cells = (size_t)boardSize * boardSize;
+    for (size_t i = 0; i < eaten && pos < chunks[current].end; i++)
+    {
+        uint8_t slot = data[pos++];
+        Food fruit;
+        if (slot >= Simulation::fruitCount || !ReadFruit(pos, fruit))
+            break;
+        sim.fruits[slot] = fruit;
+        sim.score++;
+        sim.speed = Simulation::SpeedAfterFruit(sim.speed);
+        if (sim.snake.body.size() < cells)
+            sim.snake.addSegment = true; // grows on the next tick, as after Simulation's own eating
+        events.fruitsEaten++;
+    }
+    tick++;
+    return events;
+}
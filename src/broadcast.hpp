@@ -0,0 +1,153 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "simulation.hpp"
+
+/**
+ * =============================
+ * Broadcast Overview
+ * =============================
+ * A broadcast is a recording of a classic game that can be watched and scrubbed
+ * without re-running it. The session replay (replay.hpp) is smaller, but showing
+ * tick T from it means simulating every tick before T. A broadcast stores what each
+ * tick changed instead: the direction the head moved in, which implies the tail,
+ * and the fruits that respawned. Every keyframe interval it also stores a keyframe
+ * with the whole body, the fruits, the score and the speed. Seeking loads the
+ * keyframe at or before the target and applies at most one interval of deltas.
+ *
+ * The file is a header followed by self-delimiting chunks. A chunk is one keyframe
+ * followed by the deltas after it. A chunk closes when it holds keyframeInterval
+ * deltas, and the next chunk's keyframe is the state its last delta reached. It
+ * also closes when a round ends. The board has already been reset then, so the
+ * next keyframe is the first state of the new round and records why the old round
+ * ended. The recorder hands out finished chunks, and the game appends them while
+ * it plays. A file that is still being written, or was cut off, loads up to its
+ * last complete chunk.
+ *
+ * =============================
+ * File format (little endian)
+ * =============================
+ *   header  : magic "SNKB", version u8 (1), board size u16, keyframe interval u16, seed u64
+ *   chunk   : varint payload bytes, then the payload:
+ *             varint first tick, varint delta count, keyframe, deltas
+ *   keyframe: varint score, speed f64, u8 (direction | addSegment << 2 | round end << 3),
+ *             varint length, varint tail cell, then length - 1 direction codes packed
+ *             four to a byte (low bits first), each the step from one segment to
+ *             the next towards the head; then one fruit per fruit slot
+ *   fruit   : varint (active | textureIndex << 1), then varint cell when active
+ *   delta   : u8 op. Bit 7 set: a run of ((op >> 2) & 31) + 1 ticks in direction op & 3
+ *             with no fruit eaten. Clear: one tick in direction op & 3 that ate
+ *             (op >> 2) & 3 fruits, each followed by u8 slot and a fruit
+ *
+ * Cells are row-major indices (y * size + x). Direction codes are 0 right,
+ * 1 down, 2 left, 3 up. Round end codes are 0 none (an interval keyframe),
+ * 1 edge, 2 tail and 3 board full. State t is the board after t ticks, so a
+ * recording of n ticks holds states 0..n.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **void BroadcastRecorder::Begin(const Simulation &sim, uint32_t interval)**
+ *   - Objective: start a recording at sim's current state; the header and the first
+ *                keyframe go into the pending bytes.
+ *
+ * **void BroadcastRecorder::Record(const Simulation &sim, const TickEvents &events)**
+ *   - Objective: note the tick sim.Step() just ran. Allocation free: buffers are
+ *                reserved by Begin().
+ *
+ * **void BroadcastRecorder::Finish()**
+ *   - Objective: close the open chunk so the pending bytes end on a whole chunk.
+ *
+ * **bool HasPending() const / void TakePending(std::vector<uint8_t> &out)**
+ *   - Objective: whether bytes are ready for the file / move them to the end of
+ *                out. The first take starts the file; later ones are appended to it.
+ *
+ * **bool BroadcastPlayer::Load(const char *path)**
+ *   - Objective: read a recording and index its chunks. Return false on I/O or
+ *                format errors.
+ *
+ * **void BroadcastPlayer::Seek(Simulation &sim, uint32_t tick)**
+ *   - Objective: put sim in the recorded state `tick` (clamped to TickCount()). sim
+ *                must be built for boardSize and only changed by this player.
+ *
+ * **TickEvents BroadcastPlayer::Step(Simulation &sim)**
+ *   - Objective: advance sim one recorded tick; the events report fruits eaten and
+ *                the round end, if any. Does nothing at the end of the recording.
+ */
+
+class BroadcastRecorder
+{
+public:
+    static constexpr uint32_t defaultKeyframeInterval = 256; // deltas per chunk
+
+    void Begin(const Simulation &sim, uint32_t interval = defaultKeyframeInterval);
+    void Record(const Simulation &sim, const TickEvents &events);
+    void Finish();
+    bool HasPending() const { return !pending.empty(); }
+    void TakePending(std::vector<uint8_t> &out);
+    uint32_t Ticks() const { return tick; }
+
+private:
+    void OpenChunk(const Simulation &sim, int roundEnd);
+    void CloseChunk();
+    void FlushRun();
+
+    std::vector<uint8_t> chunk;   // keyframe and deltas of the open chunk
+    std::vector<uint8_t> pending; // finished bytes not yet taken
+    bool open = false;            // a chunk is being filled
+    uint32_t interval = defaultKeyframeInterval;
+    uint32_t tick = 0;            // state the last Record() reached
+    uint32_t chunkFirst = 0;      // state of the open chunk's keyframe
+    uint32_t chunkTicks = 0;      // deltas in the open chunk
+    int runDirection = 0;         // direction code of the run being counted
+    int runLength = 0;            // ticks in the run being counted, not yet written
+    Food fruits[Simulation::fruitCount]; // fruits as of the last state, to spot respawns
+};
+
+class BroadcastPlayer
+{
+public:
+    int boardSize = 0;
+    uint32_t keyframeInterval = 0;
+    uint64_t seed = 0;
+
+    bool Load(const char *path);
+    uint32_t TickCount() const;
+    uint32_t Tick() const { return tick; }
+    size_t Keyframes() const { return chunks.size(); }
+    void Seek(Simulation &sim, uint32_t target);
+    TickEvents Step(Simulation &sim);
+
+private:
+    /*
+     * ChunkInfo struct
+     * Objective: where one chunk lies in the file, found once by Load().
+     * Member variables:
+     *  - firstTick, ticks : state of the keyframe, and the number of deltas after it
+     *  - keyframe, deltas, end : byte offsets of the keyframe, the first delta and the
+     *                            end of the chunk
+     */
+    struct ChunkInfo
+    {
+        uint32_t firstTick;
+        uint32_t ticks;
+        size_t keyframe;
+        size_t deltas;
+        size_t end;
+    };
+
+    bool ReadKeyframe(size_t &pos, Simulation *sim, int &roundEnd) const;
+    bool ReadFruit(size_t &pos, Food &fruit) const;
+    int LoadKeyframe(Simulation &sim, size_t index);
+    int NextDirection(size_t &fruitCount);
+
+    std::vector<uint8_t> data;      // the whole file
+    std::vector<ChunkInfo> chunks;  // in tick order
+    size_t current = 0;             // chunk the cursor is in
+    size_t pos = 0;                 // next delta byte of that chunk
+    uint32_t tick = 0;              // state sim is in
+    int runDirection = 0;           // direction of the run being played
+    int runLeft = 0;                // ticks of that run still to play
+    bool positioned = false;        // the cursor matches the Simulation last seeked
+};
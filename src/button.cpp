@@ -4,67 +4,65 @@
  * Button::Button
  * ============================
  * Objective:
- *   Load an image from disk, scale it, convert it into a texture, and initialize
- *   the button's on-screen position.
+ *   Obtain the button image at the requested scale as a shared texture, and
+ *   initialize the button's on-screen position.
  *
  * Input:
+ *   - ResourceCache& cache → Cache owning the texture; must outlive the button.
  *   - const char* imagePath → File path of the button image.
  *   - Vector2 imagePosition → Screen coordinates where the button will appear.
  *   - float scale → Scaling factor applied to the image before converting to a texture.
+ *   - const AssetBundle* bundle → Optional asset pack holding pre-scaled pixels.
  *
  * Output:
- *   - Loads and assigns a scaled texture to the button.
+ *   - Takes a reference to the scaled texture.
  *   - Stores the drawing position.
  *
  * Return Value:
  *   - None (constructor).
  *
  * Side Effects:
- *   - Loads image and texture into system/GPU memory.
+ *   - Uploads a texture into GPU memory only when no other owner holds the same
+ *     image at the same scale; decodes the image only when the bundle has no
+ *     pre-scaled copy for this path and scale.
  *   - If file path is invalid, texture may fail to load and cause runtime issues.
  */
-Button::Button(const char *imagePath, Vector2 imagePosition, float scale)
+Button::Button(ResourceCache &cache, const char *imagePath, Vector2 imagePosition, float scale,
+               const AssetBundle *bundle)
 {
-    // Load the raw image from the provided file path (stored in RAM).
-    Image image = LoadImage(imagePath);
-
-    // Store the original width and height of the image.
-    int originalWidth = image.width;
-    int originalHeight = image.height;
-
-    // Calculate scaled dimensions using the given scale factor.
-    int newWidth = static_cast<int>(originalWidth * scale);
-    int newHeight = static_cast<int>(originalHeight * scale);
-
-    // Resize the image in RAM before converting it to a texture.
-    ImageResize(&image, newWidth, newHeight);
-
-    // Upload the processed image to VRAM as a texture.
-    texture = LoadTextureFromImage(image);
-
-    // Free image data from RAM—texture is now safely stored in GPU memory.
-    UnloadImage(image);
+    // Resident copy, or pre-scaled pixels from the pack / LoadImage + ImageResize as a fallback.
+    texture = cache.LoadTexture(imagePath, scale, bundle);
 
     // Store the final drawing position of the button.
     position = imagePosition;
 }
 
 /**
- * Button::~Button
- * =============================
+ * Button::Button (deferred texture)
+ * ============================
  * Objective:
- *   Properly unload the texture from GPU memory.
+ *   Create a button at a position without a texture yet.
  *
- * Input: None
- * Output: Frees GPU texture resources.
- * Return Value: None (destructor)
+ * Input:
+ *   - Vector2 imagePosition → Screen coordinates where the button will appear.
  *
  * Side Effects:
- *   - If texture unloading is skipped, program leaks GPU memory.
+ *   - None; the empty handle yields a zero-sized texture, so Draw and isPressed are no-ops.
+ */
+Button::Button(Vector2 imagePosition)
+{
+    position = imagePosition;
+}
+
+/**
+ * Button::SetTexture
+ * ============================
+ * Objective:
+ *   Install the texture once it has been loaded; any previous reference is dropped.
  */
-Button::~Button()
+void Button::SetTexture(TextureHandle loaded)
 {
-    UnloadTexture(texture); // Release VRAM used by the texture.
+    texture = std::move(loaded);
 }
 
 /**
@@ -86,7 +84,7 @@ Button::~Button()
  */
 void Button::Draw()
 {
-    DrawTextureV(texture, position, WHITE); // Draw at given position using original texture colors.
+    DrawTextureV(texture.Get(), position, WHITE); // Draw at given position using original texture colors.
 }
 
 /**
@@ -115,8 +113,8 @@ bool Button::isPressed(Vector2 mousePos, bool mousePressed)
 {
     // Create a bounding rectangle equal to button position and texture dimensions.
     Rectangle rect = {position.x, position.y,
-                      static_cast<float>(texture.width),
-                      static_cast<float>(texture.height)};
+                      static_cast<float>(texture.Get().width),
+                      static_cast<float>(texture.Get().height)};
 
     // Check if mouse is inside rectangle AND click occurred.
     if (CheckCollisionPointRec(mousePos, rect) && mousePressed)
@@ -1,6 +1,10 @@
 #pragma once
 #include <raylib.h>
 
+#include "resource_cache.hpp"
+
+class AssetBundle;
+
 /**
  * =============================
  * Class Overview
@@ -9,27 +13,39 @@
  * texture. It supports loading an image, scaling it, drawing it, and detecting
  * mouse click interactions.
  *
+ * The texture is a shared reference from the ResourceCache, so buttons using the
+ * same image and scale share one upload. Buttons are move-only: a copy would
+ * otherwise need a second reference to the same texture.
+ *
  * =============================
  * Member Variables (private)
  * =============================
- * - **Texture2D texture** : Stores the image used for the visual appearance of the button.
+ * - **TextureHandle texture** : Cache reference to the image used for the visual appearance of the button.
  * - **Vector2 position**  : Screen coordinates where the button is drawn.
  *
  * =============================
  * Member Functions (public)
  * =============================
- * **Button(const char *imagePath, Vector2 imagePosition, float scale)**
+ * **Button(ResourceCache &cache, const char *imagePath, Vector2 imagePosition, float scale, const AssetBundle *bundle)**
  *   - Objective: Load and scale a button image, convert it into a usable texture,
  *                and set its drawing position.
- *   - Input: imagePath → File path of the image.
+ *   - Input: cache → Cache the texture is shared through.
+ *            imagePath → File path of the image.
  *            imagePosition → Screen coordinates.
  *            scale → Scale factor.
+ *            bundle → Optional asset pack; its pre-scaled copy skips decode and resize.
  *   - Output: Initializes internal texture and position.
- *   - Side Effects: Allocates GPU memory when loading texture.
+ *   - Side Effects: Allocates GPU memory when the texture is not resident yet.
+ *
+ * **Button(Vector2 imagePosition)**
+ *   - Objective: Place a button whose texture arrives later through SetTexture
+ *                (asynchronous loading). Until then it draws nothing and is never pressed.
+ *
+ * **void SetTexture(TextureHandle loaded)**
+ *   - Objective: Take over a reference to the (already scaled) button texture.
  *
  * **~Button()**
- *   - Objective: Free GPU memory used by the texture.
- *   - Side Effects: If texture is not unloaded, memory leaks occur.
+ *   - Objective: Drop the texture reference; the cache unloads it with the last one.
  *
  * **void Draw()**
  *   - Objective: Render the button on the screen.
@@ -43,12 +59,19 @@
 class Button
 {
 public:
-    Button(const char *imagePath, Vector2 imagePosition, float scale);
-    ~Button();
+    Button(ResourceCache &cache, const char *imagePath, Vector2 imagePosition, float scale,
+           const AssetBundle *bundle = nullptr);
+    explicit Button(Vector2 imagePosition);
+    Button(Button &&) = default;
+    Button &operator=(Button &&) = default;
+    Button(const Button &) = delete; // would share the texture without a reference
+    Button &operator=(const Button &) = delete;
+    ~Button() = default;
+    void SetTexture(TextureHandle loaded);
     void Draw();
     bool isPressed(Vector2 mousePos, bool mousePressed);
 
 private:
-    Texture2D texture; ///< Texture used to visually represent the button.
-    Vector2 position;  ///< Screen coordinates where the button is drawn.
+    TextureHandle texture; ///< Shared texture used to visually represent the button.
+    Vector2 position;      ///< Screen coordinates where the button is drawn.
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "cached_layer.hpp"
+
+/**
+ * CachedLayer::CachedLayer
+ * ============================
+ * Objective:
+ *   Allocate the render texture that caches the layer.
+ *
+ * Input:
+ *   - int width, height → size of the layer in screen pixels.
+ *
+ * Side Effects:
+ *   - Allocates a framebuffer and texture on the GPU.
+ */
+CachedLayer::CachedLayer(int width, int height)
+{
+    target = LoadRenderTexture(width, height);
+}
+
+/**
+ * CachedLayer::~CachedLayer
+ * ============================
+ * Objective:
+ *   Release the render texture.
+ */
+CachedLayer::~CachedLayer()
+{
+    UnloadRenderTexture(target);
+}
+
+/**
+ * CachedLayer::Blit
+ * ============================
+ * Objective:
+ *   Draw the cached pixels 1:1 at `position`.
+ *
+ * Approach:
+ *   Render textures are stored bottom-up, so the source rectangle uses a negative
+ *   height to flip the image back.
+ */
+void CachedLayer::Blit(Vector2 position)
+{
+    Rectangle source = {0, 0, (float)target.texture.width, -(float)target.texture.height};
+    DrawTextureRec(target.texture, source, position, WHITE);
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <raylib.h>
+
+/**
+ * =============================
+ * Class Overview
+ * =============================
+ * The **CachedLayer** class keeps a piece of the screen that rarely changes (menu
+ * headlines, the board border, a score label) in a RenderTexture and redraws it
+ * from there with a single textured quad. The expensive drawing (text layout and
+ * glyph quads, outline geometry) runs only when the caller's key changes, e.g.
+ * when the score it shows goes up.
+ *
+ * =============================
+ * Member Variables (private)
+ * =============================
+ * - **RenderTexture2D target** : offscreen copy of the layer.
+ * - **long long key**          : value the cached pixels were painted for.
+ * - **bool valid**             : false until the first paint.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **CachedLayer(int width, int height)**
+ *   - Objective: allocate the offscreen target (requires an open window).
+ *
+ * **~CachedLayer()**
+ *   - Objective: free the offscreen target.
+ *
+ * **template <typename Paint> void Draw(Vector2 position, long long key, Paint paint)**
+ *   - Objective: repaint the layer when `key` differs from the cached one, then draw
+ *                it with its top-left corner at `position`.
+ *   - Input: paint → callable that draws the layer contents in layer coordinates
+ *                    ((0,0) is the layer's top-left corner). It must clear the
+ *                    background itself (opaque colour, or BLANK for an overlay).
+ *   - Side Effects: may switch the render target while painting; must be called
+ *                   inside BeginDrawing/EndDrawing.
+ *
+ * **void Invalidate()**
+ *   - Objective: force a repaint on the next Draw (e.g. after a layout change).
+ */
+class CachedLayer
+{
+public:
+    CachedLayer(int width, int height);
+    ~CachedLayer();
+    CachedLayer(const CachedLayer &) = delete; // owns a GPU render target
+    CachedLayer &operator=(const CachedLayer &) = delete;
+
+    template <typename Paint>
+    void Draw(Vector2 position, long long layerKey, Paint paint)
+    {
+        if (!valid || layerKey != key)
+        {
+            BeginTextureMode(target);
+            paint();
+            EndTextureMode();
+            key = layerKey;
+            valid = true;
+        }
+        Blit(position);
+    }
+
+    void Invalidate() { valid = false; }
+
+private:
+    void Blit(Vector2 position);
+
+    RenderTexture2D target; ///< Offscreen pixels of the layer.
+    long long key = 0;      ///< Key the pixels were painted for.
+    bool valid = false;     ///< Whether target holds a painted layer yet.
+};
@@ -0,0 +1,124 @@
+#include "file_writer.hpp"
+
+#include <cstdio>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * SyncAndClose
+ * ============================
+ * Objective:
+ *   Flush `file` through the C library and the OS to the disk, then close it.
+ *
+ * Return Value:
+ *   - bool → false when any step failed.
+ */
+static bool SyncAndClose(FILE *file)
+{
+    bool ok = fflush(file) == 0;
+#ifdef _WIN32
+    ok = _commit(_fileno(file)) == 0 && ok;
+#else
+    ok = fsync(fileno(file)) == 0 && ok;
+#endif
+    return fclose(file) == 0 && ok;
+}
+
+/**
+ * ReplaceFile
+ * ============================
+ * Objective:
+ *   Rename `from` over `to` in one step. POSIX rename() replaces atomically;
+ *   Windows needs MoveFileEx for the same.
+ */
+static bool ReplaceFile(const std::string &from, const std::string &to)
+{
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+FileWriter::FileWriter()
+    : worker(&FileWriter::Work, this)
+{
+}
+
+FileWriter::~FileWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wake.notify_one();
+    worker.join(); // the worker empties the queue before it honours stop
+}
+
+void FileWriter::Queue(bool replace, const char *path, std::vector<uint8_t> bytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(Job{replace, path, std::move(bytes)});
+    }
+    wake.notify_one();
+}
+
+void FileWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return jobs.empty() && !busy; });
+}
+
+/**
+ * FileWriter::Work
+ * ============================
+ * Objective:
+ *   Worker thread body: perform queued writes in order until stopped.
+ *
+ * Approach:
+ *   A job is taken out of the queue under the lock and written without it, so
+ *   Queue() never waits for the disk. Replacements write the temporary file in
+ *   full and sync it before the rename; a crash before the rename leaves the old
+ *   file untouched and only a stale .tmp behind.
+ */
+void FileWriter::Work()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+        wake.wait(lock, [this]() { return stop || !jobs.empty(); });
+        if (jobs.empty())
+            return; // stop, with nothing left to write
+
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        busy = true;
+        lock.unlock();
+
+        std::string target = job.replace ? job.path + ".tmp" : job.path;
+        FILE *file = fopen(target.c_str(), job.replace ? "wb" : "ab");
+        bool ok = file != nullptr;
+        if (file)
+        {
+            ok = fwrite(job.bytes.data(), 1, job.bytes.size(), file) == job.bytes.size();
+            ok = SyncAndClose(file) && ok;
+        }
+        if (ok && job.replace)
+            ok = ReplaceFile(target, job.path);
+        if (!ok)
+            failures.fetch_add(1, std::memory_order_relaxed);
+
+        lock.lock();
+        busy = false;
+        if (jobs.empty())
+            idle.notify_all();
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * =============================
+ * Class Overview
+ * =============================
+ * The **FileWriter** class takes file writes off the frame. The main thread hands
+ * over finished bytes and returns at once; one worker thread performs the writes
+ * in the order they were queued, so an append queued after a rewrite of the same
+ * file lands in the new file.
+ *
+ * Both kinds of write reach the disk (fsync) before the next job starts:
+ * - an append adds bytes to the end of a file, so a crash can at worst leave a
+ *   partial last record, which readers of append logs must tolerate;
+ * - a replace writes `path.tmp` and renames it over `path`, so the file is always
+ *   either entirely old or entirely new.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **void Append(const char *path, std::vector<uint8_t> bytes)**
+ * **void Replace(const char *path, std::vector<uint8_t> bytes)**
+ *   - Objective: queue a write; never blocks on I/O.
+ *
+ * **void Flush()**
+ *   - Objective: wait until every queued write has finished.
+ *
+ * **int Failures() const**
+ *   - Return: writes that failed so far (the data of a failed write is dropped).
+ *
+ * **~FileWriter()**
+ *   - Objective: finish every queued write, then join the worker.
+ */
+class FileWriter
+{
+public:
+    FileWriter();
+    ~FileWriter();
+    FileWriter(const FileWriter &) = delete; // owns a thread
+    FileWriter &operator=(const FileWriter &) = delete;
+
+    void Append(const char *path, std::vector<uint8_t> bytes) { Queue(false, path, std::move(bytes)); }
+    void Replace(const char *path, std::vector<uint8_t> bytes) { Queue(true, path, std::move(bytes)); }
+    void Flush();
+    int Failures() const { return failures.load(std::memory_order_relaxed); }
+
+private:
+    struct Job
+    {
+        bool replace; // false: append
+        std::string path;
+        std::vector<uint8_t> bytes;
+    };
+
+    void Queue(bool replace, const char *path, std::vector<uint8_t> bytes);
+    void Work();
+
+    std::mutex mutex;                  // guards jobs, busy and stop
+    std::condition_variable wake;      // a job was queued, or stop was set
+    std::condition_variable idle;      // the queue ran empty
+    std::deque<Job> jobs;
+    bool busy = false;                 // the worker is inside a job
+    bool stop = false;
+    std::atomic<int> failures{0};
+    std::thread worker;                // started last, after everything it reads
+};
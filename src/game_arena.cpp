@@ -0,0 +1,67 @@
+#include "game_arena.hpp"
+
+/**
+ * GameArena::GameArena
+ * ============================
+ * Objective:
+ *   Allocate a buffer of `bytes` bytes and start bumping from its beginning.
+ */
+GameArena::GameArena(size_t bytes)
+    : buffer(bytes)
+{
+    bump.emplace(buffer.data(), buffer.size(), &spill);
+}
+
+/**
+ * GameArena::Reset
+ * ============================
+ * Objective:
+ *   Make the whole buffer available again.
+ *
+ * Side Effects:
+ *   - Frees any spill to the heap; after a spill, reallocates the buffer.
+ *
+ * Approach:
+ *   monotonic_buffer_resource::release() rewinds to the start of the initial
+ *   buffer, which is O(1) when nothing spilled. After a spill the buffer grows to
+ *   hold the old size plus the spill, so the next game of the same shape fits.
+ */
+void GameArena::Reset()
+{
+    bump->release();
+    if (spill.bytes == 0)
+        return;
+    size_t grown = buffer.size() + spill.bytes;
+    spill.bytes = 0;
+    bump.reset(); // nothing refers to the old buffer any more
+    buffer.assign(grown, std::byte{0});
+    bump.emplace(buffer.data(), buffer.size(), &spill);
+}
+
+void *GameArena::Spill::do_allocate(size_t size, size_t alignment)
+{
+    bytes += size;
+    return std::pmr::new_delete_resource()->allocate(size, alignment);
+}
+
+void GameArena::Spill::do_deallocate(void *p, size_t size, size_t alignment)
+{
+    std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+}
+
+bool GameArena::Spill::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+/**
+ * ThreadGameArena
+ * ============================
+ * Objective:
+ *   Return the calling thread's arena, so workers never share one.
+ */
+GameArena &ThreadGameArena()
+{
+    thread_local GameArena arena;
+    return arena;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+/**
+ * =============================
+ * Game Arena Overview
+ * =============================
+ * A bump allocator for objects that live exactly as long as one game, such as a
+ * Simulation built for a short bot game. Allocations carve the next bytes out of
+ * one buffer, frees are no-ops, and Reset() rewinds the buffer in O(1) once the
+ * game's objects are destroyed. Thousands of games per second therefore cost no
+ * heap traffic after the first one.
+ *
+ * The arena is a std::pmr::memory_resource, so any std::pmr container (and
+ * Simulation, which takes one at construction) can use it unchanged. A game that
+ * does not fit spills into the heap; the next Reset() then frees the spill and
+ * grows the buffer, so the arena settles at the size its games need.
+ *
+ * It is not thread-safe: each thread uses its own, see ThreadGameArena().
+ *
+ * =============================
+ * GameArena (public API)
+ * =============================
+ * **GameArena(size_t bytes)**
+ *   - Objective: allocate the initial buffer.
+ *
+ * **std::pmr::memory_resource *Resource()**
+ *   - Return: the resource to pass to Simulation and std::pmr containers.
+ *
+ * **void Reset()**
+ *   - Objective: release everything allocated since the last Reset(). Every object
+ *                using the arena must already be destroyed.
+ *
+ * **size_t Capacity()**
+ *   - Return: current buffer size in bytes.
+ *
+ * =============================
+ * Functions
+ * =============================
+ * **GameArena &ThreadGameArena()**
+ *   - Return: the calling thread's arena, created on first use.
+ */
+
+class GameArena
+{
+public:
+    static constexpr size_t defaultBytes = 64 * 1024; // a 25x25 Simulation needs about 10 KB
+
+    explicit GameArena(size_t bytes = defaultBytes);
+    GameArena(const GameArena &) = delete;
+    GameArena &operator=(const GameArena &) = delete;
+
+    std::pmr::memory_resource *Resource() { return &*bump; }
+    void Reset();
+    size_t Capacity() const { return buffer.size(); }
+
+private:
+    /*
+     * Spill
+     * Objective: upstream of the bump resource; forwards to the heap and remembers
+     *            how many bytes did not fit the buffer since the last Reset().
+     */
+    class Spill : public std::pmr::memory_resource
+    {
+    public:
+        size_t bytes = 0;
+
+    private:
+        void *do_allocate(size_t size, size_t alignment) override;
+        void do_deallocate(void *p, size_t size, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+    };
+
+    std::vector<std::byte> buffer;                             // allocated once, regrown only after a spill
+    Spill spill;                                               // must outlive bump
+    std::optional<std::pmr::monotonic_buffer_resource> bump;   // rebuilt when the buffer grows
+};
+
+GameArena &ThreadGameArena();
@@ -0,0 +1,283 @@
+#include "hamilton.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * HamiltonCycle::Build
+ * ============================
+ * Objective:
+ *   Generate the cycle for a size x size board (size >= 5).
+ *
+ * Approach:
+ *   From (0,0), serpentine along the rows over columns 1..size-1, then return up
+ *   column 0. On even boards the last row ends at column 1, next to the return
+ *   column. On odd boards the last two rows are walked column by column instead,
+ *   right to left, leaving out the bottom-right corner: this also ends at column 1
+ *   and passes a = (N-1, N-2), x = (N-2, N-2), b = (N-2, N-1) in a row.
+ */
+void HamiltonCycle::Build(int size)
+{
+    const int n = size;
+    cellAt.clear();
+    cellAt.reserve((size_t)n * n);
+    auto add = [&](int x, int y) { cellAt.push_back((uint32_t)(y * n + x)); };
+
+    bool odd = n % 2 == 1;
+    int serpentineRows = odd ? n - 2 : n;
+    add(0, 0);
+    for (int y = 0; y < serpentineRows; y++)
+    {
+        for (int i = 1; i < n; i++)
+            add(y % 2 == 0 ? i : n - i, y);
+    }
+    if (odd)
+    {
+        add(n - 1, n - 2); // a
+        for (int x = n - 2; x >= 1; x--)
+        {
+            bool down = (n - 2 - x) % 2 == 0;
+            add(x, down ? n - 2 : n - 1);
+            add(x, down ? n - 1 : n - 2);
+        }
+    }
+    for (int y = n - 1; y >= 1; y--)
+        add(0, y);
+
+    detourFrom = detourSkip = detourCell = detourTo = -1;
+    if (odd)
+    {
+        detourFrom = (n - 2) * n + (n - 1);
+        detourSkip = (n - 2) * n + (n - 2);
+        detourCell = (n - 1) * n + (n - 1);
+        detourTo = (n - 1) * n + (n - 2);
+    }
+    Index(size);
+}
+
+/**
+ * HamiltonCycle::Index
+ * ============================
+ * Objective:
+ *   Fill `position` from `cellAt`; the corner of an odd board takes x's position.
+ */
+void HamiltonCycle::Index(int size)
+{
+    boardSize = size;
+    length = (uint32_t)cellAt.size();
+    position.assign((size_t)size * size, 0);
+    for (uint32_t p = 0; p < length; p++)
+        position[cellAt[p]] = p;
+    if (detourCell >= 0)
+        position[detourCell] = position[detourSkip];
+}
+
+void HamiltonCycle::Encode(std::vector<uint8_t> &out) const
+{
+    out.assign({'S', 'N', 'K', 'H', 1});
+    out.push_back((uint8_t)(boardSize & 0xff));
+    out.push_back((uint8_t)(boardSize >> 8));
+    for (uint32_t p : position)
+        for (int i = 0; i < 4; i++)
+            out.push_back((uint8_t)(p >> (8 * i)));
+}
+
+/**
+ * HamiltonCycle::Load
+ * ============================
+ * Objective:
+ *   Read a table written from Encode() for a size x size board.
+ *
+ * Return Value:
+ *   - bool → false when the file is missing, for another size, or not a valid
+ *            cycle; the table is then left empty, ready for Build().
+ *
+ * Approach:
+ *   The cache is trusted only as far as it can be checked: every position must be
+ *   used exactly once (the odd-board corner aside), consecutive positions must be
+ *   neighbouring cells, and the corner must be a detour from a to b.
+ */
+bool HamiltonCycle::Load(const char *path, int size)
+{
+    boardSize = 0;
+    length = 0;
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return false;
+    const size_t cells = (size_t)size * size;
+    std::vector<uint8_t> in(7 + 4 * cells);
+    bool complete = fread(in.data(), 1, in.size(), file) == in.size() && fgetc(file) == EOF;
+    fclose(file);
+    if (!complete || in[0] != 'S' || in[1] != 'N' || in[2] != 'K' || in[3] != 'H' || in[4] != 1 ||
+        (in[5] | (in[6] << 8)) != size)
+        return false;
+
+    bool odd = size % 2 == 1;
+    int n = size;
+    detourFrom = odd ? (n - 2) * n + (n - 1) : -1;
+    detourSkip = odd ? (n - 2) * n + (n - 2) : -1;
+    detourCell = odd ? (n - 1) * n + (n - 1) : -1;
+    detourTo = odd ? (n - 1) * n + (n - 2) : -1;
+
+    uint32_t cycleLength = (uint32_t)(odd ? cells - 1 : cells);
+    cellAt.assign(cycleLength, UINT32_MAX);
+    for (size_t cell = 0; cell < cells; cell++)
+    {
+        const uint8_t *p = &in[7 + 4 * cell];
+        uint32_t at = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+        if ((int)cell == detourCell)
+            continue; // checked below, once x is known
+        if (at >= cycleLength || cellAt[at] != UINT32_MAX)
+            return false;
+        cellAt[at] = (uint32_t)cell;
+    }
+    auto neighbours = [n](uint32_t a, uint32_t b)
+    {
+        int dx = std::abs((int)(a % n) - (int)(b % n));
+        int dy = std::abs((int)(a / n) - (int)(b / n));
+        return dx + dy == 1;
+    };
+    for (uint32_t p = 0; p < cycleLength; p++)
+    {
+        if (!neighbours(cellAt[p], cellAt[(p + 1) % cycleLength]))
+            return false;
+    }
+    if (odd)
+    {
+        const uint8_t *p = &in[7 + 4 * (size_t)detourCell];
+        uint32_t cornerAt = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+        if (cornerAt >= cycleLength || cellAt[cornerAt] != (uint32_t)detourSkip ||
+            cellAt[(cornerAt + cycleLength - 1) % cycleLength] != (uint32_t)detourFrom ||
+            cellAt[(cornerAt + 1) % cycleLength] != (uint32_t)detourTo)
+            return false;
+    }
+    Index(size);
+    return true;
+}
+
+uint32_t HamiltonSolver::Ahead(int from, int to) const
+{
+    int64_t steps = ((int64_t)cycle.position[to] - cycle.position[from]) * walk;
+    return (uint32_t)((steps % cycle.length + cycle.length) % cycle.length);
+}
+
+/**
+ * HamiltonSolver::Decide
+ * ============================
+ * Objective:
+ *   Choose this tick's direction: the next cell on the cycle, or a safe shortcut.
+ *
+ * Approach:
+ *   - When the head is not where the last decision led or the body got shorter (a
+ *     new round; the starting head may well be where the old round's last move
+ *     led), the walking direction is taken from the neck, so the snake continues
+ *     the way it faces. If the starting body is not a run of consecutive cycle
+ *     positions behind the head, its segments after the head are counted in
+ *     `unordered`; each tick the tail moved takes one off, and shortcuts wait
+ *     until none is left, since until then cells ahead of the head may be body.
+ *   - The cycle's next cell; at a on odd boards this is the corner when a fruit
+ *     waits there, x otherwise, and the corner always continues to b.
+ *   - Shortcut: among the free neighbours, the one furthest along the cycle that
+ *     is not past the nearest fruit ahead (a fruit on the corner counts as being on
+ *     the detour's entry) and still leaves a free run to the tail for `growth`:
+ *     the pending segment, the fruits on that run, and 2 * length + growthMargin
+ *     for respawns while the tail passes the skipped cells. Everything between
+ *     the head and the tail is free, so this can never run into the body, and
+ *     the body stays in cycle order behind the tail. When even the next cell on
+ *     the cycle leaves too little room, the neighbours are not looked at.
+ *
+ * Variable definition and use:
+ *   head, next - cell indices; best, toTail, toFruit, fruitAhead - positions ahead
+ *   of the head; growth, room - free positions a shortcut must leave before the tail;
+ *   inOrder - every starting segment is one cycle position behind the one before it
+ */
+Cell HamiltonSolver::Decide(const Simulation &sim)
+{
+    const Snake &snake = sim.snake;
+    const int n = cycle.boardSize;
+    auto indexOf = [n](Cell cell) { return cell.y * n + cell.x; };
+    int head = indexOf(snake.body[0]);
+    bool newRound = head != expectedHead || snake.body.size() < lastLength;
+    lastLength = snake.body.size();
+    if (newRound && snake.body.size() >= 2)
+    {
+        int neck = indexOf(snake.body[1]);
+        walk = cycle.position[head] == (cycle.position[neck] + cycle.length - 1) % cycle.length ? -1 : 1;
+    }
+    if (newRound)
+    {
+        bool inOrder = true; // a few cells: only runs at the start of a round
+        for (unsigned int i = 1; i < snake.body.size() && inOrder; i++)
+            inOrder = Ahead(indexOf(snake.body[i]), indexOf(snake.body[i - 1])) == 1;
+        unordered = inOrder ? 0 : snake.body.size() - 1;
+    }
+    else if (unordered > 0 && snake.tailMoved)
+        unordered--; // the oldest starting segment left the board
+
+    bool fruitOnCorner = false;
+    for (const Food &f : sim.fruits)
+        fruitOnCorner = fruitOnCorner || (f.active && indexOf(f.position) == cycle.detourCell);
+    int detourEntry = walk > 0 ? cycle.detourFrom : cycle.detourTo;
+    int detourExit = walk > 0 ? cycle.detourTo : cycle.detourFrom;
+    int next;
+    if (head == cycle.detourCell)
+        next = detourExit;
+    else if (head == detourEntry)
+    {
+        // the corner only when its fruit is not lying on the body (fruits can land under a
+        // growing snake), and always when x is still covered from the last pass
+        Cell corner = Cell{(int16_t)(cycle.detourCell % n), (int16_t)(cycle.detourCell / n)};
+        Cell skip = Cell{(int16_t)(cycle.detourSkip % n), (int16_t)(cycle.detourSkip / n)};
+        bool cornerFree = !snake.IsOccupied(corner);
+        next = cornerFree && (fruitOnCorner || snake.IsOccupied(skip)) ? cycle.detourCell : cycle.detourSkip;
+    }
+    else
+        next = (int)cycle.cellAt[(cycle.position[head] + cycle.length + walk) % cycle.length];
+
+    // growth the free run from a shortcut to the tail has to absorb before the tail has
+    // passed the skipped cells (see above); fruits on that run are added per candidate
+    uint32_t growth = (snake.addSegment ? 1 : 0) + 2 * snake.body.size() + growthMargin;
+    uint32_t best = Ahead(head, next);
+    uint32_t toTail = Ahead(head, indexOf(snake.body.back()));
+    if (shortcuts && unordered == 0 && best + growth < toTail)
+    {
+        uint32_t fruitAhead[Simulation::fruitCount];
+        unsigned int fruitsAhead = 0;
+        uint32_t toFruit = UINT32_MAX;
+        for (const Food &f : sim.fruits)
+        {
+            int fruit = indexOf(f.position);
+            if (fruit == cycle.detourCell)
+                fruit = detourEntry; // x shares the corner's position, but only a leads into it
+            if (!f.active || fruit == head)
+                continue;
+            uint32_t at = Ahead(head, fruit);
+            fruitAhead[fruitsAhead++] = at;
+            toFruit = at < toFruit ? at : toFruit;
+        }
+        static const Cell steps[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+        for (const Cell &step : steps)
+        {
+            Cell cell = snake.body[0] + step;
+            if (!snake.occupancy.InBounds(cell) || snake.IsOccupied(cell))
+                continue;
+            int candidate = indexOf(cell);
+            if (candidate == cycle.detourCell)
+                continue; // entered only through the detour, so a and b stay in order
+            uint32_t ahead = Ahead(head, candidate);
+            if (ahead <= best || ahead > toFruit)
+                continue;
+            uint32_t room = growth;
+            for (unsigned int i = 0; i < fruitsAhead; i++)
+                room += fruitAhead[i] >= ahead && fruitAhead[i] < toTail ? 1 : 0;
+            if (ahead + room < toTail)
+            {
+                best = ahead;
+                next = candidate;
+            }
+        }
+    }
+
+    expectedHead = next;
+    return Cell{(int16_t)(next % n - head % n), (int16_t)(next / n - head / n)};
+}
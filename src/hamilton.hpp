@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "simulation.hpp"
+
+/**
+ * =============================
+ * Hamiltonian Solver Overview
+ * =============================
+ * "Perfect play" on even boards: the snake follows a fixed cycle through every cell,
+ * so its body always lies on the cycle behind the head and it can never trap
+ * itself. On an N x N board with N even it fills the board completely.
+ *
+ * **HamiltonCycle** is the lookup table: the position of every cell on the cycle
+ * and the cell at every position, so the next cell is two array reads. Even boards
+ * use a serpentine over columns 1..N-1 that returns up column 0. Odd boards have
+ * no Hamiltonian cycle (the grid is bipartite with an odd cell count), so the
+ * cycle leaves out the corner (N-1, N-1) and passes its neighbours a -> x -> b
+ * with x diagonal to the corner; a fruit on the corner is collected through the
+ * detour a -> corner -> b, which is the same cycle with the corner in place of x.
+ * Odd boards are not played perfectly: the snake reaches N*N - 1 cells, but the
+ * last one can only be taken by eating the last two fruits back to back next to it,
+ * and where those respawn is up to chance. Nearly every round (so far every one on the
+ * 25 x 25 default board) ends in a tail collision there, with nowhere left to grow.
+ *
+ * **HamiltonSolver** drives a Simulation along the cycle and takes shortcuts
+ * towards the nearest fruit ahead. Measured along the cycle from the head, every
+ * body cell lies behind the tail, so any neighbour closer than the tail is free
+ * and moving there keeps that true. The cells a shortcut skips stay free inside the
+ * body until the tail has passed them, about one body length later; if the snake
+ * grows over the whole free run up to its tail before then, it runs into the tail.
+ * A shortcut is therefore taken only to a free neighbour that does not pass the
+ * fruit and leaves a free run to the tail that covers the pending growth, the
+ * fruits already on that run, and twice the body length plus growthMargin for
+ * fruits respawning onto it while the tail catches up (see Decide()). Respawns are
+ * random, so that allowance is measured rather than proven: 5000 rounds on every
+ * even board from 4 to 26, and 400,000 on 4 x 4 and 6 x 6, all filled the board.
+ * Late in a round the run is too short for any shortcut and the snake follows the
+ * cycle.
+ * Which way round the cycle is walked follows the neck at the start of a round,
+ * so the starting snake never has to reverse. The starting body need not lie on the
+ * cycle in order (on small boards Snake::Reset puts the tail on another column of
+ * the cycle), and the rule above needs it to; a round starting that way follows the
+ * cycle strictly until the tail has passed every starting segment.
+ *
+ * Tables are built in O(N^2) and cached per board size in a small binary file
+ * (magic "SNKH", version u8, board u16, then position u32 per cell, row-major).
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **void HamiltonCycle::Build(int size)**
+ *   - Objective: generate the cycle for a size x size board.
+ *
+ * **bool HamiltonCycle::Load(const char *path, int size) / void Encode(std::vector<uint8_t> &out)**
+ *   - Objective: read a cached table (false when missing, damaged or for another
+ *                size) / produce the bytes of one.
+ *
+ * **Cell HamiltonSolver::Decide(const Simulation &sim)**
+ *   - Objective: the direction for this tick; `cycle` must match sim.boardSize.
+ */
+class HamiltonCycle
+{
+public:
+    int boardSize = 0;
+    uint32_t length = 0;              // positions on the cycle: N*N, or N*N - 1 on odd boards
+    std::vector<uint32_t> position;   // per cell (row-major): its position; the corner shares x's
+    std::vector<uint32_t> cellAt;     // per position: the cell index on it
+    int detourFrom = -1;              // odd boards: a, x, corner and b as cell indices
+    int detourSkip = -1;
+    int detourCell = -1;
+    int detourTo = -1;
+
+    void Build(int size);
+    bool Load(const char *path, int size);
+    void Encode(std::vector<uint8_t> &out) const;
+
+private:
+    void Index(int size);
+};
+
+class HamiltonSolver
+{
+public:
+    static constexpr int growthMargin = 3; // spare cells a shortcut keeps before the tail on top of the expected growth
+
+    HamiltonCycle cycle;
+    bool shortcuts = true; // false: follow the cycle strictly
+
+    Cell Decide(const Simulation &sim);
+
+private:
+    uint32_t Ahead(int from, int to) const; ///< positions from `from` to `to` in walking order
+
+    int walk = 1;               // +1 or -1: direction the cycle is walked in this round
+    int expectedHead = -1;      // cell the head should be on if the last decision was followed
+    unsigned int lastLength = 0; // body length at the last decision; it only shrinks on a reset
+    unsigned int unordered = 0;  // starting segments out of cycle order the tail has yet to leave
+};
@@ -0,0 +1,45 @@
+#include "input.hpp"
+
+#include <chrono>
+
+#include <raylib.h>
+
+int64_t InputSystem::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * InputSystem::Poll
+ * ============================
+ * Objective:
+ *   Collect this frame's direction presses (arrows and WASD) in press order.
+ *
+ * Approach:
+ *   GetKeyPressed() returns the frame's presses one at a time until it gives 0.
+ *   Every press gets the same stamp: raylib read them all in the same poll. Keys
+ *   other than the direction keys are skipped; Enter, F3 and F4 are still seen by
+ *   IsKeyPressed(), which reads the key state rather than this queue.
+ */
+void InputSystem::Poll()
+{
+    const int64_t now = Now();
+    count = 0;
+    for (int key = GetKeyPressed(); key != 0; key = GetKeyPressed())
+    {
+        Cell direction;
+        if (key == KEY_UP || key == KEY_W)
+            direction = Cell{0, -1};
+        else if (key == KEY_DOWN || key == KEY_S)
+            direction = Cell{0, 1};
+        else if (key == KEY_LEFT || key == KEY_A)
+            direction = Cell{-1, 0};
+        else if (key == KEY_RIGHT || key == KEY_D)
+            direction = Cell{1, 0};
+        else
+            continue;
+        if (count < maxEvents)
+            events[count++] = InputEvent{direction, now};
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+
+#include "simulation.hpp"
+
+/**
+ * =============================
+ * Input Overview
+ * =============================
+ * Reads the game's direction keys once per frame and stamps every press with the
+ * time it was read, so the game can tell how long a turn waited: the tick that
+ * applies it, and the frame that first shows that tick on screen.
+ *
+ * raylib collects input events inside EndDrawing, right after presenting the frame.
+ * Poll() runs first thing in the next frame, before the simulation, so the stamp is
+ * taken within microseconds of the point raylib saw the key. Presses are drained
+ * from GetKeyPressed() in the order they happened (several turns in one frame keep
+ * their order, unlike a fixed series of IsKeyPressed checks), mapped to directions
+ * and kept in a fixed array until the next Poll().
+ *
+ * Polling on a thread of its own is not possible with raylib: GLFW only delivers
+ * events on the thread that owns the window. The latency that remains is the wait
+ * for the next tick, which the fixed timestep sets, and one frame.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **static int64_t Now()**
+ *   - Return: monotonic nanoseconds; the clock every stamp is taken from.
+ *
+ * **void Poll()**
+ *   - Objective: replace the events with the direction presses of this frame.
+ *
+ * **int Count() const / const InputEvent &operator[](int i) const**
+ *   - Return: the events of the last Poll(), oldest first.
+ */
+
+/*
+ * InputEvent struct
+ * Objective: one direction press.
+ * Member variables:
+ *  - direction : unit step the key asks for
+ *  - polledAt : InputSystem::Now() when the press was read
+ */
+struct InputEvent
+{
+    Cell direction;
+    int64_t polledAt;
+};
+
+class InputSystem
+{
+public:
+    static constexpr int maxEvents = 16; // presses kept per frame; more in one frame are dropped
+
+    static int64_t Now();
+    void Poll();
+    int Count() const { return count; }
+    const InputEvent &operator[](int i) const { return events[i]; }
+
+private:
+    InputEvent events[maxEvents];
+    int count = 0;
+};
@@ -1,9 +1,33 @@
 #include <iostream> // for debug printing if needed
 #include <raylib.h>  // core raylib API (windowing, drawing, input, textures, sounds)
-#include <deque>     // double-ended queue used to store snake body segments
-#include <raymath.h> // raymath provides Vector2 helpers like Vector2Add and equality
 #include "button.hpp" // custom button helper (assumed to exist)
-#include <vector>    // dynamic array used for fruits
+#include "alloc_counter.hpp" // debug heap counter used to check that ticks do not allocate
+#include "simulation.hpp" // headless game rules: snake, food, score and speed
+#include "arena.hpp" // many snakes on one board sharing an owner-id grid
+#include "autopilot.hpp" // --autopilot: path to the nearest fruit that keeps the tail in reach
+#include "hamilton.hpp"  // --hamilton: play along a cached Hamiltonian cycle (perfect on even boards)
+#include "net_client.hpp" // --connect: mirror of a snake_server room, fed by tick deltas
+#include "replay.hpp" // seed + turn log of the session, replayable headless
+#include "broadcast.hpp" // --broadcast / --watch: seekable tick recordings for spectators
+#include "file_writer.hpp" // background thread for every file the game writes
+#include "score_store.hpp" // per-profile, per-board, per-mode leaderboards in an append log
+#include "telemetry.hpp" // --telemetry: gameplay event stream written by a background thread
+#include "board_renderer.hpp" // batched snake/fruit drawing from a baked sprite and a food atlas
+#include "board_camera.hpp" // scrollable, zoomable view of boards larger than the window
+#include "cached_layer.hpp" // render-texture cache for menus, chrome and score labels
+#include "asset_bundle.hpp" // memory-mapped assets.pak with pre-decoded textures and sounds
+#include "async_loader.hpp" // decodes assets on a worker, uploads a few per frame
+#include "resource_cache.hpp" // ref-counted owner of every texture and sound
+#include "audio_mixer.hpp" // voice-pooled effect mixer on one low-latency stream
+#include "profiler.hpp" // scoped frame timers, F3 overlay and F4 Chrome trace (SNAKE_PROFILE builds)
+#include "input.hpp" // direction presses stamped at the poll point, for input latency
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
 
 using namespace std;
 
@@ -14,517 +38,825 @@ using namespace std;
  */
 Color green = {173, 204, 96, 255};     // background color used for the main playing area
 Color darkGreen = {43, 51, 24, 255};  // used for borders, snake segments and text
+Color arenaColors[] = {                // arena snakes: the player first, then the bots in turn
+    {43, 51, 24, 255}, {122, 45, 33, 255}, {36, 66, 110, 255}, {110, 80, 24, 255}, {86, 40, 96, 255}, {24, 92, 84, 255},
+};
 
 /*
  * Layout and timing globals
  * Objective: control the grid size, speed and offsets for drawing.
- * Side effects: these values affect drawing scale and game behavior globally.
+ * Side effects: these values affect drawing scale and game behavior globally; cellcount
+ *               is set from --board before the Game is created. The window and the board
+ *               view have a fixed size, larger boards are scrolled and zoomed instead.
  */
-int cellsize = 30;    // size in pixels of a single grid cell
-int cellcount = 25;   // number of cells per row/column (square grid)
-double lastUpdateTime = 0; // timestamp of the last automatic update; used for throttling movement
+int cellsize = 30;    // size in pixels of a single grid cell at zoom 1
+int cellcount = 25;   // number of cells per row/column (square grid), see --board
 int offset = 75;      // pixel offset from the window edge to the top-left corner of the grid
+const int viewSize = 750;    // on-screen width and height of the board view
+const int visibleCells = 25; // cells across the view at the starting zoom (fewer on small boards)
+const int minBoardSize = 5;
+const int maxBoardSize = 4096; // Cell coordinates are 16-bit; this keeps the grid near 140 MB
+int arenaBots = 0;    // --arena N: bots sharing the board with the player (0 = classic game)
+bool autopilotMode = false; // --autopilot: the classic game steers itself (attract mode, demos)
+bool hamiltonMode = false;  // --hamilton: the same, along a Hamiltonian cycle (fills even-sized boards)
+const char *serverHost = nullptr;   // --connect HOST[:PORT]: play in a snake_server room
+uint16_t serverPort = netDefaultPort;
+uint16_t serverRoom = 0;            // --room N
+const double connectSeconds = 3.0; // how long to wait for the server before playing locally
+int frameCap = 0;     // --fps N: frame rate limit; 0 leaves the pace to VSync (or none with --no-vsync)
+bool vsync = true;    // --no-vsync: present frames as soon as they are drawn
 int temp_score;       // temporary holder for last game score (set on game over)
-int high_score = 0;   // persisted high score for the current program run
+int high_score = 0;   // best score on the current leaderboard (profile, board size and mode)
+const char *replayPath = "last_replay.snkr"; // session replay, rewritten after each round
+const char *scoresPath = "scores.log";       // leaderboards of every profile, board and mode
+const char *profileName = "player";          // --profile NAME: whose leaderboard this session uses
+const char *telemetryPath = nullptr;         // --telemetry FILE: append gameplay events (off by default)
+const char *broadcastPath = nullptr;         // --broadcast FILE: record the classic game for spectators
+const char *watchPath = nullptr;             // --watch FILE: spectate a recorded broadcast instead of playing
+const double fastForwardRate = 100.0;        // spectator fast-forward (F): recorded ticks per real tick
+const uint32_t seekTicks = 100;              // spectator Left/Right: ticks skipped per press
 
 /*
- * ElementInDeque
- * Objective: Check whether a given Vector2 (cell) exists within a deque of Vector2.
- * Input: Vector2 element - the cell to search for
- *        deque<Vector2> deque - the container to search in (passed by value in original code)
- * Output: none
- * Return value: bool - true if the element exists in the deque, false otherwise
- * Side effects: none (pure query)
- *
- * Approach:
- * Iterate through all elements of the deque and compare each with the target
- * using Vector2Equals from raymath.h. Early return on match.
- *
- * Variable definition and use:
- * i - index used for iteration.
+ * Audio settings
+ * Objective: size of the effect mixer and the priority of each game event's sound.
+ * Side effects: a smaller buffer lowers event-to-sound latency but wakes the audio
+ *               thread more often; too small a buffer can crackle on slow machines.
  */
-bool ElementInDeque(Vector2 element, deque<Vector2> deque)
-{
-    // loop through each element in the supplied deque
-    for (unsigned int i = 0; i < deque.size(); i++)
-    {
-        // compare using raylib's Vector2Equals which checks x and y with float tolerance
-        if (Vector2Equals(deque[i], element))
-        {
-            return true; // found the element
-        }
-    }
-    return false; // not found after checking all entries
-}
+const int audioVoices = 8;         // simultaneous effects
+const int audioBufferFrames = 256; // mixer stream buffer: 256 frames = 5.8 ms at 44.1 kHz
+const int eatPriority = 1;         // eating may be stolen by a death sound...
+const int wallPriority = 2;        // ...but never the other way round
 
 /*
- * EventTriggered
- * Objective: determine whether the given time interval has elapsed since
- *            the last recorded update (lastUpdateTime) and, if so, update
- *            lastUpdateTime and return true.
- * Input: double interval - minimum seconds between events
- * Output: none
- * Return value: bool - true if enough time has passed; false otherwise
- * Side effects: updates global lastUpdateTime when returning true; affects game timing
- *
- * Approach:
- * Compare the current time (GetTime) against lastUpdateTime. If difference >= interval,
- * set lastUpdateTime to current time and return true; otherwise return false.
- *
- * Variable definition and use:
- * currentTime - fetched from raylib's GetTime() which returns seconds as double.
+ * Startup timing
+ * Objective: reference point for the time-to-first-frame and assets-ready metrics.
+ * Side effects: initialized during static initialization, just before main() runs
+ */
+const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+
+/*
+ * MillisecondsSinceStart
+ * Return value: double - wall-clock milliseconds since processStart
  */
-bool EventTriggered(double interval)
+double MillisecondsSinceStart()
 {
-    double currentTime = GetTime(); // get current time in seconds since initialization
-    if (currentTime - lastUpdateTime >= interval)
-    {
-        lastUpdateTime = currentTime; // update the last triggered timestamp
-        return true;                 // signal that the event should be processed
-    }
-    return false; // not enough time has passed yet
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - processStart).count();
 }
 
 /*
- * Snake class
- * Objective: encapsulates the snake's state and operations (draw, update, reset).
+ * Game class
+ * Objective: raylib front end for one Simulation: owns audio and textures, buffers
+ *            input, runs the fixed timestep and draws the board.
  * Member variables:
- *  - addSegment : when true, the snake will grow by one segment on next update.
- *  - body       : deque of Vector2 representing the grid cells occupied by the snake.
- *  - direction  : unit Vector2 indicating the current movement direction (e.g., {1,0}).
+ *  - running : whether the simulation is currently running
+ *  - game_over : whether the last round ended
+ *  - game_won : whether the last round ended because the snake filled the board
+ *  - sim : headless game state (snake, fruits, score, speed, random generator)
+ *  - arena, botRng, arenaMoves : arena mode only: the shared board (the player is snake 0),
+ *                                the bots' generator and the per-tick direction of every snake
+ *  - autopilot : steers the classic game when --autopilot is given; keyboard turns are ignored
+ *  - hamilton : steers it instead when --hamilton is given, through the same input queue
+ *  - net, steered : online mode only: the server room's mirror, and whether a turn was sent
+ *                   since the last server tick was applied
+ *  - replay : seed and direction changes of this session, saved after every round
+ *  - broadcast : tick deltas and keyframes of the classic game (when --broadcast is given),
+ *                appended to the file as chunks complete
+ *  - playback, paused, fastForward : spectator mode only: the broadcast being watched (sim
+ *                                    then mirrors it instead of playing), its pause and 100x
+ *  - scores, files, scoreKey : the leaderboards, the background writer that saves them and
+ *                              the replay, and which leaderboard this session plays for
+ *  - renderer : baked segment sprite, food atlas and chunk tiles; draws what the camera sees
+ *  - camera : viewport onto the board; follows the head, wheel zooms, right drag pans
+ *  - wall, eat : cache handles of the sound clips for audio feedback
+ *  - mixer : plays them on pooled voices with wallPriority above eatPriority
+ *  - ticks, tickAllocations : debug counters; ticks simulated and heap allocations they made
+ *  - telemetry, rounds : gameplay event stream (when --telemetry is given), rounds finished
+ *  - accumulator : unsimulated time carried between frames by the fixed-timestep loop
+ *  - inputQueue, inputCount : direction changes buffered until the next tick
+ *  - inputTime : when each queued turn was polled (0 for turns not from a key)
+ *  - pendingPhoton : poll time of the oldest turn applied since the last present, or 0
+ *
  * Member functions:
- *  - Draw()     : draws all segments of the snake.
- *  - Update()   : advances the snake by one cell in the current direction.
- *  - Reset()    : restores initial position and direction.
+ *  - constructor: queues its sounds and the food atlas on the loader and starts the replay
+ *  - destructor: releases its sounds and closes audio device
+ *  - Draw: draws the visible snake cells and fruits
+ *  - Motion: how far the display is between the last two ticks, for smooth movement
+ *  - NetMotion: the same for one snake of the online board
+ *  - Heading, Score: the player's current direction and score in either mode
+ *  - UpdateCamera: camera input and head following for this frame
+ *  - LoadHamiltonCycle: read the --hamilton cycle from its cache file, or build and save it
+ *  - Update: perform one game tick and react to its events (sounds, game over)
+ *  - EmitTickEvents: report the tick's outcome to the telemetry stream
+ *  - Advance: run as many fixed ticks as the elapsed frame time allows
+ *  - AdvanceOnline: the same for online mode, where the server runs the ticks
+ *  - AdvancePlayback: the same for spectator mode, stepping the broadcast instead
+ *  - SpectatorInput, DrawPlaybackStatus: spectator pause, fast-forward and seeking, and its status
+ *  - FlushBroadcast: hand finished broadcast chunks to the file writer
+ *  - QueueDirection: buffer a direction change for an upcoming tick
+ *  - PopInput: take the oldest buffered turn off the queue
+ *  - GameOver: handle end-of-round screen state and high score
  */
-class Snake
+class Game
 {
 public:
-    bool addSegment = false; // when true, do not pop back on next Update() so snake grows
-    deque<Vector2> body = {{6, 9}, {5, 9}, {4, 9}}; // initial 3-segment snake placed on grid
-    Vector2 direction = {1, 0}; // initial movement direction = right
+    bool running = false; // whether the simulation is active
+    bool game_over = false; // whether we are currently in a game-over state
+    bool game_won = false;  // whether the last round ended with the board full
+    Simulation sim = Simulation(cellcount, RandomSeed()); // snake, fruits, score and speed
+    std::unique_ptr<Arena> arena; // set in arena mode; sim then only supplies seed and speed
+    SimRandom botRng;             // bot decisions, separate from the arena's spawns
+    std::vector<Cell> arenaMoves; // direction of every arena snake for the next tick
+    Autopilot autopilot;          // used when autopilotMode is set (classic game only)
+    HamiltonSolver hamilton;      // used when hamiltonMode is set (classic game only)
+    std::unique_ptr<NetClient> net; // set in online mode; the server then owns the board
+    bool steered = false;         // a turn went out since the last applied server tick
+    std::vector<SnakeMotion> netMotions; // online: every snake between its last two server ticks
+    std::unique_ptr<BroadcastPlayer> playback; // set in spectator mode; sim then mirrors the recording
+    bool paused = false;          // spectator: playback stopped on the current tick
+    bool fastForward = false;     // spectator: playing at fastForwardRate
+    Replay replay;         // everything needed to re-run this session headless
+    BroadcastRecorder broadcast; // idle unless started from --broadcast
+    ScoreStore &scores;    // leaderboards; updated in memory, logged by files
+    FileWriter &files;     // performs every write of the game off the frame
+    ScoreKey scoreKey;     // profile, board size and mode of this session
+    BoardRenderer renderer; // needs the window, which main opens first
+    BoardCamera camera;     // board view inside the window frame
+    SoundHandle wall;      // sound to play on collision (silent until loaded)
+    SoundHandle eat;       // sound to play when eating food (silent until loaded)
+    AudioMixer mixer{audioVoices, audioBufferFrames}; // opened once the loader has the audio device up
+    size_t ticks = 0;            // simulation ticks run this session
+    size_t tickAllocations = 0;  // heap allocations made inside those ticks (debug builds only)
+    Telemetry telemetry;         // idle unless started from --telemetry
+    int rounds = 0;              // rounds finished this session
+    double accumulator = 0;      // frame time not yet consumed by ticks, in seconds
+    static constexpr int maxQueuedInputs = 3; // turns remembered between ticks
+    Cell inputQueue[maxQueuedInputs];     // pending directions, oldest first
+    int inputCount = 0;                   // number of pending directions
+    int64_t inputTime[maxQueuedInputs];   // InputSystem::Now() of each pending direction
+    int64_t pendingPhoton = 0;            // input-to-photon sample waiting for EndDrawing
 
     /*
-     * Draw
-     * Objective: render each segment of the snake onto the screen.
-     * Input: none (uses member variables and global drawing context)
-     * Output: draws rectangles to the active RenderTexture/Screen
-     * Return value: void
-     * Side effects: performs drawing operations which depend on raylib BeginDrawing/EndDrawing
-     *
-     * Approach:
-     * Iterate through body deque and draw a rounded rectangle for each cell.
+     * Constructor
+     * Objective: bake the board sprite, request this game's assets and start recording the
+     *            session replay. Returns without waiting for any file or the audio device.
+     * Input: AsyncLoader &loader - loader the sounds and the food atlas are queued on
+     *        ScoreStore &scoreStore, FileWriter &writer - leaderboards and the writer for files
+     *        std::unique_ptr<NetClient> client - a connected client for online mode, or null
+     *        std::unique_ptr<BroadcastPlayer> recording - a loaded broadcast to spectate, or null
+     * Side effects: the loader opens the audio device and delivers wall, eat and the atlas
+     *               in later frames; the game must not start before loader.Done()
      *
-     * Variable definition and use:
-     * x, y - coordinates of segment
-     * segment - Rectangle used for DrawRectangleRounded
+     * Approach: log the seed (so a session can be reproduced even without its replay file),
+     * then queue the atlas and the sounds; the callbacks store them into this object when
+     * the loader hands them over on the main thread. The camera starts with visibleCells
+     * cells across the view, or the whole board when it is smaller than that. In arena mode
+     * the player shares a new Arena with arenaBots bots and one fruit per snake; the
+     * replay format covers a single snake, so arena sessions are not recorded. Online, the
+     * board comes from the server (cellcount was set to its size) and nothing is recorded.
+     * A spectator's board is the recording's (cellcount again), shown from its first tick.
+     * With --broadcast the classic game's broadcast file is started with its first keyframe.
      */
-    void Draw()
+    Game(AsyncLoader &loader, ScoreStore &scoreStore, FileWriter &writer, std::unique_ptr<NetClient> client = nullptr,
+         std::unique_ptr<BroadcastPlayer> recording = nullptr)
+        : botRng(sim.seed ^ 0x9e3779b9u),
+          net(std::move(client)),
+          playback(std::move(recording)),
+          scores(scoreStore),
+          files(writer),
+          renderer(cellsize, sim.boardSize),
+          camera(Rectangle{(float)offset, (float)offset, (float)viewSize, (float)viewSize}, (float)cellsize * sim.boardSize,
+                 (float)viewSize / (cellsize * std::min(sim.boardSize, visibleCells)))
     {
-        for (unsigned int i = 0; i < body.size(); i++)
+        replay.Begin(sim.boardSize, sim.seed);
+        TraceLog(LOG_INFO, "SIM: seed %llu", (unsigned long long)sim.seed);
+        if (net)
+            TraceLog(LOG_INFO, "NET: room on a %i board, %s", net->World().boardSize,
+                     net->World().player >= 0 ? "playing" : "full, spectating");
+        else if (playback)
+        {
+            playback->Seek(sim, 0);
+            accumulator = sim.speed; // still frames show the exact recorded state
+            TraceLog(LOG_INFO, "BROADCAST: watching %u ticks, %zu keyframes", playback->TickCount(), playback->Keyframes());
+        }
+        else if (arenaBots > 0)
+        {
+            arena.reset(new Arena(sim.boardSize, arenaBots + 1, arenaBots + 1, sim.seed));
+            arenaMoves.resize(arena->snakes.size());
+            TraceLog(LOG_INFO, "SIM: arena with %i bots", (int)arena->snakes.size() - 1);
+        }
+        if (autopilotMode && !arena && !net)
+            autopilot.Reserve(sim.boardSize);
+        if (hamiltonMode && !arena && !net)
+            LoadHamiltonCycle();
+        if (broadcastPath && !arena && !net && !playback)
         {
-            float x = body[i].x; // grid x coordinate of this segment
-            float y = body[i].y; // grid y coordinate of this segment
+            broadcast.Begin(sim);
+            std::vector<uint8_t> bytes;
+            broadcast.TakePending(bytes);
+            files.Replace(broadcastPath, std::move(bytes)); // header and first keyframe; chunks are appended
+        }
+        scoreKey.profile = hamiltonMode ? "hamilton" : autopilotMode ? "autopilot" : profileName;
+        scoreKey.boardSize = (uint16_t)sim.boardSize;
+        scoreKey.mode = net ? ScoreMode::Online : arena ? ScoreMode::Arena : ScoreMode::Classic;
+        high_score = scores.Best(scoreKey);
+        if (telemetryPath && !telemetry.Start(telemetryPath))
+            TraceLog(LOG_WARNING, "TELEMETRY: could not open %s", telemetryPath);
+        telemetry.Emit(TelemetryKind::SessionStart, 0, sim.boardSize, (float)sim.speed);
 
-            // compute pixel-space rectangle to draw for this segment using global offset & cellsize
-            Rectangle segment = Rectangle{offset + x * cellsize, offset + y * cellsize, (float)cellsize, (float)cellsize};
+        loader.AddFoodAtlas([this](TextureHandle atlas) { renderer.SetFoodAtlas(std::move(atlas)); });
+        // sound files for wall collision and eating; paths are relative to executable
+        loader.AddSound("sounds/wall.mp3", [this](SoundHandle sound) { wall = std::move(sound); });
+        loader.AddSound("sounds/eat.mp3", [this](SoundHandle sound) { eat = std::move(sound); });
+    }
 
-            // draw a rounded rectangle for the segment with a fixed roundness and corner segments
-            DrawRectangleRounded(segment, 0.5, 6, darkGreen);
-        }
+    /*
+     * Destructor
+     * Objective: release audio resources when Game object is destroyed; renderer drops
+     *            its own textures afterwards.
+     * Side effects: closing audio device affects other audio code
+     *
+     * Approach: close the mixer first so no voice reads a clip any more, then release the
+     * sound handles (the cache frees them with the last reference) and close audio.
+     */
+    ~Game()
+    {
+        if (AllocationCountingEnabled())
+            TraceLog(LOG_INFO, "SIM: %zu heap allocations over %zu ticks", tickAllocations, ticks);
+        telemetry.Emit(TelemetryKind::SessionEnd, (uint32_t)ticks, rounds, (float)sim.speed);
+        telemetry.Stop(); // writes what is still queued
+        broadcast.Finish(); // the last chunk, up to the final tick
+        FlushBroadcast();
+        if (telemetry.Dropped() > 0)
+            TraceLog(LOG_WARNING, "TELEMETRY: %u events dropped", telemetry.Dropped());
+
+        mixer.Close(); // stop the stream that reads the clips
+        eat.Reset();   // free sound resources (no-op for sounds that never loaded)
+        wall.Reset();
+        CloseAudioDevice(); // shutdown audio (the loader opened it)
     }
 
     /*
-     * Update
-     * Objective: move the snake one cell in the current direction, and optionally grow.
-     * Input: none (uses member variables)
-     * Output: modifies the body deque
+     * Draw
+     * Objective: draw the part of the snake and the fruits the camera shows.
+     * Input: none
+     * Output: draws objects via raylib
      * Return value: void
-     * Side effects: mutates snake.body and addSegment
+     * Side effects: renders to screen, clipped to the board view
      *
      * Approach:
-     * Push a new head position equal to head + direction; if addSegment is true, leave the
-     * tail so the snake grows; otherwise pop the tail to keep length constant.
-     *
-     * Variable definition and use:
-     * (no extra locals)
+     * The renderer works in board space inside the camera's 2D mode and only touches the
+     * grid chunks in view: zoomed in, the pre-baked rounded sprite tinted darkGreen per
+     * covered cell; zoomed far out, one texel tile per chunk. Fruits are one more batch
+     * from the food atlas. The classic snake's head and tail are drawn in between ticks
+     * (see Motion), and so is every online snake, between the server ticks the client
+     * last applied (see NetMotion), so movement is smooth at any refresh rate; local
+     * arena boards still move a cell at a time.
      */
-    void Update()
+    void Draw()
     {
-        // add a new head at the current head position plus the direction vector
-        body.push_front(Vector2Add(body[0], direction));
-
-        if (addSegment)
+        PROFILE_SCOPE(ProfileGameDraw);
+        Rectangle view = camera.VisibleArea();
+        camera.Begin();
+        if (net)
+        {
+            const NetWorld &world = net->World();
+            netMotions.resize(world.snakes.size()); // keeps its capacity; grows only with the room
+            for (size_t i = 0; i < world.snakes.size(); i++)
+                if (!NetMotion(world.snakes[i], netMotions[i]))
+                    netMotions[i].headTo = Cell{-1, -1}; // dead: nothing of it to draw
+            renderer.DrawArena(world.grid, view, camera.Zoom(), arenaColors, sizeof(arenaColors) / sizeof(arenaColors[0]),
+                               std::max(world.player, 0), netMotions.data(), (int)netMotions.size());
+            renderer.DrawFruits(world.fruits.data(), world.fruits.size(), view, camera.Zoom());
+        }
+        else if (arena)
         {
-            addSegment = false; // growth applied; reset flag so growth happens only once per food
+            renderer.DrawArena(arena->grid, view, camera.Zoom(), arenaColors, sizeof(arenaColors) / sizeof(arenaColors[0]));
+            renderer.DrawFruits(arena->fruits.data(), arena->fruits.size(), view, camera.Zoom());
         }
         else
         {
-            body.pop_back(); // remove last element to keep the snake the same length
+            SnakeMotion motion;
+            renderer.DrawSnake(sim.snake.occupancy, view, camera.Zoom(), darkGreen, Motion(motion) ? &motion : nullptr);
+            renderer.DrawFruits(sim.fruits.data(), sim.fruits.size(), view, camera.Zoom());
         }
+        camera.End();
     }
 
     /*
-     * Reset
-     * Objective: restore the snake to its initial starting configuration.
-     * Input: none
-     * Output: resets member variables body and direction
-     * Return value: void
-     * Side effects: mutates snake state used by game loop
+     * Motion
+     * Objective: describe the classic snake between its previous and current tick.
+     * Output: SnakeMotion &motion - filled when the result is true
+     * Return value: bool - false when there is nothing to interpolate (not running, or
+     *               local arena mode); online, the player's snake (see NetMotion)
      *
-     * Approach: assign initial literal values for body and direction.
+     * Approach: the fixed-timestep loop leaves `accumulator` seconds of the current tick
+     * interval unsimulated, so accumulator / sim.speed is how far the display should be
+     * from the last tick towards the next one. Drawing the last tick at that fraction of
+     * the way from the one before keeps the picture exactly one tick behind the
+     * simulation, and the previous state is just body[1] and the popped tail cell.
      */
-    void Reset()
+    bool Motion(SnakeMotion &motion) const
     {
-        // set the snake to the original three cells and facing right
-        body = {Vector2{6, 9}, Vector2{5, 9}, Vector2{4, 9}};
-        direction = {1, 0};
+        if (net)
+            return running && net->World().player >= 0 && NetMotion(net->World().snakes[net->World().player], motion);
+        const Snake &snake = sim.snake;
+        if (!running || arena || snake.body.size() < 2)
+            return false;
+        motion.headFrom = snake.body[1];
+        motion.headTo = snake.body[0];
+        motion.tailFrom = snake.previousTail;
+        motion.tailTo = snake.body.back();
+        motion.tailMoving = snake.tailMoved;
+        motion.fraction = (float)std::clamp(accumulator / sim.speed, 0.0, 1.0);
+        return true;
     }
-};
-
-/*
- * Food class
- * Objective: represent a food item that the snake can eat. Manages textures for different
- *            food visuals and generates positions that do not collide with the snake.
- *
- * Static members:
- *  - textures[] : array of 4 textures shared by all Food instances to avoid reloading.
- *  - loaded     : flag indicating static textures have been loaded.
- *
- * Instance members:
- *  - position   : grid cell where this food is located
- *  - textureIndex : which texture to draw from textures[]
- */
-class Food
-{
-public:
-    static Texture2D textures[4]; // shared textures for all Food objects
-    static bool loaded;           // whether textures[] are loaded
-    Vector2 position;             // current grid cell for this fruit
-    int textureIndex;             // index into textures[] to select visual
 
     /*
-     * Constructor
-     * Objective: initialize the food instance, load static textures if needed and
-     *            pick a random free position not occupied by the snake.
-     * Input: deque<Vector2> snakeBody - current snake body to avoid placing food on it
-     * Output: sets position and textureIndex. On first call may load textures from disk.
-     * Return value: none
-     * Side effects: loads and stores static textures; uses raylib file IO so failures affect program
+     * NetMotion
+     * Objective: describe one online snake between the last two server ticks applied.
+     * Output: SnakeMotion &motion - filled when the result is true
+     * Return value: bool - false for a snake that is dead
      *
-     * Approach:
-     * If textures are not yet loaded, load four images from disk and convert to textures.
-     * Choose a random texture index (0..3) and generate a random valid position.
-     *
-     * Variable definition and use:
-     * img1..img4 - temporary Image objects used to create textures. They must be Unloaded after conversion.
+     * Approach: NetWorld keeps each snake's previous head and popped tail, the same
+     * state Motion reads from the classic snake. The client's playback clock gives the
+     * fraction. A snake that did not move (just spawned) is drawn still at its head.
      */
-    Food(deque<Vector2> snakeBody)
+    bool NetMotion(const NetSnake &snake, SnakeMotion &motion) const
     {
-        if (!loaded)
-        {
-            // load images and convert to textures only once to save memory and IO
-            Image img1 = LoadImage("graphics/food1.png");
-            Image img2 = LoadImage("graphics/food2.png");
-            Image img3 = LoadImage("graphics/food3.png");
-            Image img4 = LoadImage("graphics/food4.png");
-
-            textures[0] = LoadTextureFromImage(img1);
-            textures[1] = LoadTextureFromImage(img2);
-            textures[2] = LoadTextureFromImage(img3);
-            textures[3] = LoadTextureFromImage(img4);
-
-            // free temporary image memory; textures remain in GPU memory
-            UnloadImage(img1);
-            UnloadImage(img2);
-            UnloadImage(img3);
-            UnloadImage(img4);
-
-            loaded = true; // mark static textures as ready
-        }
+        if (!snake.alive || snake.body.size() == 0)
+            return false;
+        motion.headTo = snake.body[0];
+        motion.headFrom = snake.moved ? snake.previousHead : snake.body[0];
+        motion.tailFrom = snake.previousTail;
+        motion.tailTo = snake.body.back();
+        motion.tailMoving = snake.moved && snake.tailMoved;
+        motion.fraction = net->TickFraction();
+        return true;
+    }
 
-        // pick a random visual for this food instance
-        textureIndex = GetRandomValue(0, 3);
+    /*
+     * Heading / Score
+     * Return value: the player's current direction and score (snake 0 in arena mode, our
+     *               server snake online, where the heading is the one last sent)
+     */
+    Cell Heading() const
+    {
+        if (net)
+            return net->Heading();
+        return arena ? arena->snakes[0].direction : sim.snake.direction;
+    }
 
-        // find a grid cell not occupied by the snake
-        position = GenerateRandomPos(snakeBody);
+    int Score() const
+    {
+        if (net)
+            return net->World().player >= 0 ? net->World().snakes[net->World().player].score : 0;
+        return arena ? arena->snakes[0].score : sim.score;
     }
 
     /*
-     * GenerateRandomCell
-     * Objective: return a single random cell coordinate inside the grid bounds.
-     * Input: none
-     * Output: none
-     * Return value: Vector2 containing x and y integers represented as floats
-     * Side effects: none
-     *
-     * Approach: call GetRandomValue for both x and y within [0, cellcount-1]
+     * UpdateCamera
+     * Objective: apply this frame's zoom/pan input and keep the head in view while following.
+     * Side effects: reads mouse and keyboard state
      */
-    Vector2 GenerateRandomCell()
+    void UpdateCamera()
     {
-        float x = GetRandomValue(0, cellcount - 1); // integer-like float
-        float y = GetRandomValue(0, cellcount - 1);
-        return Vector2{x, y}; // return new Vector2
+        if (net && net->World().player < 0)
+        {
+            float centre = 0.5f * cellsize * net->World().boardSize;
+            camera.Update(Vector2{centre, centre}); // spectator: the board centre, pan and zoom still work
+            return;
+        }
+        const SnakeBody &body = net ? net->World().snakes[net->World().player].body
+                                    : arena ? arena->snakes[0].body : sim.snake.body;
+        if (body.size() == 0)
+            return; // arena player waiting for a free cell to respawn on
+        Cell head = body[0];
+        Vector2 focus = {(head.x + 0.5f) * cellsize, (head.y + 0.5f) * cellsize};
+        SnakeMotion motion;
+        if (Motion(motion)) // follow the drawn head rather than jumping a cell per tick
+        {
+            focus.x -= (1.0f - motion.fraction) * (motion.headTo.x - motion.headFrom.x) * cellsize;
+            focus.y -= (1.0f - motion.fraction) * (motion.headTo.y - motion.headFrom.y) * cellsize;
+        }
+        camera.Update(focus);
     }
 
     /*
-     * GenerateRandomPos
-     * Objective: pick a random cell that is not part of snakeBody.
-     * Input: deque<Vector2> snakeBody - cells to avoid
-     * Output: none
-     * Return value: Vector2 valid cell for food
-     * Side effects: none
+     * Update
+     * Objective: advance the game by one tick if running and react to what happened.
+     * Input: none
+     * Output: updates the simulation and the screen state
+     * Return value: void
+     * Side effects: consumes one queued direction; plays sounds; in debug builds adds the
+     *               number of heap allocations made by the tick to tickAllocations
      *
-     * Approach: repeatedly call GenerateRandomCell until the chosen cell is not
-     * present in snakeBody using ElementInDeque.
+     * Approach: hand the oldest queued turn (or the current heading, or the autopilot's
+     * choice) to Simulation::Step; the Hamiltonian solver queues its turn first, as a
+     * key press would, then play the eat/wall sounds and switch to the
+     * game-over screen as reported. The same events, plus speed-ups, go to the telemetry
+     * stream; the reset at the end of a round is not reported as a speed change.
+     * In arena mode every bot picks its move, the whole arena steps once and the player's
+     * outcome is reported like a single-snake tick: the round ends when the player dies,
+     * while the arena carries on (the player respawns straight away).
+     * A turn from a key records its poll-to-tick latency and leaves its poll time in
+     * pendingPhoton for main to close once the frame showing it is presented.
      *
      * Variable definition and use:
-     * newPos - candidate position which is regenerated while it collides with snake.
+     * direction - heading for this tick; events - what the tick did (for the player)
      */
-    Vector2 GenerateRandomPos(deque<Vector2> snakeBody)
+    void Update()
     {
-        Vector2 newPos = GenerateRandomCell();
-        while (ElementInDeque(newPos, snakeBody))
+        PROFILE_SCOPE(ProfileGameUpdate);
+        if (running)
         {
-            newPos = GenerateRandomCell(); // try again until free cell found
+            size_t allocationsBefore = AllocationCount(); // sampled to prove the tick is allocation free
+            double speedBefore = sim.speed;
+            Cell direction = Heading();
+            if (hamiltonMode && !arena)
+            {
+                inputCount = 0; // the solver's turn goes through the queue like a key press
+                QueueDirection(hamilton.Decide(sim));
+            }
+            if (autopilotMode && !hamiltonMode && !arena)
+            {
+                direction = autopilot.Decide(sim); // reuses its search buffers, no allocation
+                inputCount = 0;
+            }
+            else if (inputCount > 0)
+            {
+                int64_t polledAt = inputTime[0];
+                direction = PopInput(); // apply the oldest buffered turn
+                if (polledAt != 0)
+                {
+#ifdef SNAKE_PROFILE
+                    profiler.RecordLatency(LatencyInputToTick, InputSystem::Now() - polledAt);
+#endif
+                    if (pendingPhoton == 0)
+                        pendingPhoton = polledAt; // the frame presented next shows this turn
+                }
+            }
+            TickEvents events;
+            if (arena)
+            {
+                arenaMoves[0] = direction;
+                for (size_t i = 1; i < arenaMoves.size(); i++)
+                    arenaMoves[i] = arena->BotDirection((int)i, botRng);
+                arena->Step(arenaMoves.data()); // every snake moves once
+                events.fruitsEaten = arena->snakes[0].ate;
+                events.hitEdge = arena->snakes[0].died && arena->snakes[0].cause == ArenaDeath::Edge;
+                events.hitTail = arena->snakes[0].died && arena->snakes[0].cause != ArenaDeath::Edge;
+            }
+            else
+            {
+                replay.Record(sim, direction); // before the step, while the old heading is still set
+                events = sim.Step(direction); // move, eat and collide
+                broadcast.Record(sim, events); // no-op unless --broadcast started it
+            }
+            tickAllocations += AllocationCount() - allocationsBefore;
+            ticks++;
+            EmitTickEvents(events, speedBefore);
+
+            if (events.fruitsEaten > 0)
+                mixer.Play(eat.Get(), eatPriority); // play eating sound
+            if (events.Died())
+                mixer.Play(wall.Get(), wallPriority); // play collision sound
+            if (events.RoundOver())
+                GameOver(events.boardFull);
         }
-        return newPos;
     }
 
     /*
-     * Draw
-     * Objective: draw the food texture at its grid position.
-     * Input: none
-     * Output: draws texture to the current render target
-     * Return value: void
-     * Side effects: uses raylib DrawTexture which requires a valid texture
+     * LoadHamiltonCycle
+     * Objective: give the solver the cycle for this board size.
+     * Side effects: may queue hamilton_<N>.cyc on the file writer
      *
-     * Approach: convert grid position to pixel coordinates using offset and cellsize
+     * Approach: the table is read from hamilton_<N>.cyc in the working directory; when that
+     * is missing or fails its checks, it is built (O(N^2), under a millisecond even at the
+     * largest boards that fit the view) and the file is rewritten off the frame.
      */
-    void Draw()
+    void LoadHamiltonCycle()
     {
-        DrawTexture(
-            textures[textureIndex], // selected texture
-            offset + position.x * cellsize, // compute x pixel
-            offset + position.y * cellsize, // compute y pixel
-            WHITE); // tint color white => original texture colors
+        std::string path = "hamilton_" + std::to_string(sim.boardSize) + ".cyc";
+        if (hamilton.cycle.Load(path.c_str(), sim.boardSize))
+            return;
+        hamilton.cycle.Build(sim.boardSize);
+        std::vector<uint8_t> bytes;
+        hamilton.cycle.Encode(bytes);
+        files.Replace(path.c_str(), std::move(bytes)); // copies the path
+        TraceLog(LOG_INFO, "HAMILTON: built the cycle for a %i board", sim.boardSize);
     }
-};
-
-// initialize static members for Food
-Texture2D Food::textures[4] = {0};
-bool Food::loaded = false;
 
-/*
- * Game class
- * Objective: manage the overall game state, input handling, collisions, scoring and audio.
- * Member variables:
- *  - score : current score for the active round
- *  - speed : interval (in seconds) between automatic game updates (snake movements)
- *  - running : whether the game simulation is currently running
- *  - game_over : whether the last round ended
- *  - snake : Snake instance tracking snake body and movement
- *  - fruits : vector of Food objects present on the board
- *  - wall, eat : Sound objects for audio feedback
- *
- * Member functions:
- *  - constructor: loads sounds, initializes fruits and audio device
- *  - destructor: unloads textures & sounds and closes audio device
- *  - Draw: delegates drawing to snake and all fruits
- *  - CheckCollisionWithFood: test and handle snake eating fruit
- *  - CheckCollisionWithEdges: handle when snake crosses outside bounds
- *  - CheckCollisionsWithTail: handle self-collision
- *  - Update: perform one game tick (move snake and run collision checks)
- *  - GameOver: handle end-of-round cleanup and score reset
- */
-class Game
-{
-public:
-    int score = 0;      // running score for the current play
-    double speed = 0.2; // initial movement interval in seconds
-    bool running = false; // whether the simulation is active
-    bool game_over = false; // whether we are currently in a game-over state
-    Snake snake = Snake(); // the player's snake instance
-    vector<Food> fruits;   // currently active food objects on the board
-    Sound wall;            // sound to play on collision
-    Sound eat;             // sound to play when eating food
+    /*
+     * EmitTickEvents
+     * Objective: report one tick's outcome for the player to the telemetry stream.
+     * Input: TickEvents events - what the tick did; double speedBefore - interval before it
+     */
+    void EmitTickEvents(const TickEvents &events, double speedBefore)
+    {
+        uint32_t tick = (uint32_t)ticks;
+        int lastScore = arena ? arena->snakes[0].lastScore : sim.lastScore;
+        if (events.fruitsEaten > 0)
+            telemetry.Emit(TelemetryKind::FruitEaten, tick, events.RoundOver() ? lastScore : Score(), (float)sim.speed);
+        if (!events.RoundOver() && sim.speed != speedBefore)
+            telemetry.Emit(TelemetryKind::SpeedChange, tick, Score(), (float)sim.speed);
+        if (events.hitEdge)
+            telemetry.Emit(TelemetryKind::DeathEdge, tick, lastScore, (float)speedBefore);
+        else if (events.hitTail)
+            telemetry.Emit(TelemetryKind::DeathTail, tick, lastScore, (float)speedBefore);
+        else if (events.boardFull)
+            telemetry.Emit(TelemetryKind::BoardFull, tick, lastScore, (float)speedBefore);
+    }
 
     /*
-     * Constructor
-     * Objective: initialize audio subsystem, load sounds and populate initial fruits.
-     * Side effects: allocates audio resources and loads files from disk (may fail on missing files)
+     * Advance
+     * Objective: fixed-timestep driver; run every tick whose time has come since the last frame.
+     * Input: double frameTime - seconds elapsed since the previous frame
+     * Output: runs zero or more Update() ticks
+     * Return value: void
+     * Side effects: mutates accumulator and the game state
      *
-     * Approach: call InitAudioDevice, load sound files and create N Food objects while avoiding the snake.
+     * Approach:
+     * Add the frame time to the accumulator and consume it in steps of `sim.speed` seconds, one
+     * Update() per step, so movement speed no longer depends on the render rate. After a long
+     * stall (window drag, breakpoint) at most maxCatchUp ticks run and the backlog is
+     * dropped rather than fast-forwarding the snake into a wall. While the game is not
+     * running no time accumulates.
+     *
+     * Variable definition and use:
+     * maxCatchUp - upper bound on ticks per frame; steps - ticks run this frame
      */
-    Game()
+    void Advance(double frameTime)
     {
-        InitAudioDevice(); // start audio system for playback
-
-        // load sound files for wall collision and eating; paths are relative to executable
-        wall = LoadSound("sounds/wall.mp3");
-        eat = LoadSound("sounds/eat.mp3");
+        if (net)
+        {
+            AdvanceOnline(frameTime);
+            return;
+        }
+        if (playback)
+        {
+            AdvancePlayback(frameTime);
+            return;
+        }
+        const int maxCatchUp = 5;
+        if (!running)
+        {
+            accumulator = 0; // menus and game over do not bank time
+            return;
+        }
 
-        int fruitCount = 3; // number of fruits to maintain concurrently
-        for (int i = 0; i < fruitCount; i++)
+        accumulator += frameTime;
+        int steps = 0;
+        while (running && accumulator >= sim.speed && steps < maxCatchUp)
         {
-            fruits.push_back(Food(snake.body)); // spawn fruit avoiding current snake body
+            accumulator -= sim.speed; // speed may change inside Update(), so read it every step
+            Update();
+            steps++;
         }
+        if (steps == maxCatchUp || !running)
+            accumulator = 0;
+        FlushBroadcast();
     }
 
     /*
-     * Destructor
-     * Objective: release GPU textures and audio resources when Game object is destroyed.
-     * Side effects: unloading textures and closing audio device affects other audio code
-     *
-     * Approach: unload each of the shared Food textures (4), unload sounds and close audio.
+     * FlushBroadcast
+     * Objective: append the broadcast chunks finished since the last call to its file.
+     * Side effects: queues a write on the file writer when a chunk is ready
      */
-    ~Game()
+    void FlushBroadcast()
     {
-        for (int i = 0; i < 4; i++)
-            UnloadTexture(Food::textures[i]); // free GPU texture memory
-        UnloadSound(eat); // free sound resources
-        UnloadSound(wall);
-        CloseAudioDevice(); // shutdown audio
+        if (!broadcast.HasPending())
+            return;
+        std::vector<uint8_t> bytes;
+        broadcast.TakePending(bytes);
+        files.Append(broadcastPath, std::move(bytes));
     }
 
     /*
-     * Draw
-     * Objective: draw the snake and all fruits to the screen.
-     * Input: none
-     * Output: draws objects via raylib
-     * Return value: void
-     * Side effects: renders to screen
+     * AdvancePlayback
+     * Objective: spectator counterpart of Advance(): step the broadcast at its recorded pace.
+     * Input: double frameTime - seconds elapsed since the previous frame
+     * Side effects: mutates accumulator and sim; plays sounds at normal speed
+     *
+     * Approach:
+     * Time banks as in Advance(), multiplied by fastForwardRate while fast-forwarding, and
+     * each recorded tick costs its recorded interval (sim.speed, restored from the file),
+     * so playback follows the original game's speed-ups. At 100x a frame plays a few
+     * dozen deltas, each a Snake::Update() and no rule checks, so there is no catch-up
+     * limit beyond maxPlaybackTicks against stalls. Sounds are skipped while fast-
+     * forwarding. At the end of the recording the last state is held.
+     *
+     * Variable definition and use:
+     * maxPlaybackTicks - upper bound on ticks per frame; steps - ticks played this frame
      */
-    void Draw()
+    void AdvancePlayback(double frameTime)
     {
-        snake.Draw(); // draw the player's snake
-        for (auto &f : fruits)
-            f.Draw(); // draw each fruit
+        const int maxPlaybackTicks = 4096;
+        if (!running || paused)
+            return; // accumulator kept, so a paused frame stays where it was drawn
+        accumulator += frameTime * (fastForward ? fastForwardRate : 1.0);
+        int steps = 0;
+        while (accumulator >= sim.speed && playback->Tick() < playback->TickCount() && steps < maxPlaybackTicks)
+        {
+            accumulator -= sim.speed;
+            TickEvents events = playback->Step(sim);
+            steps++;
+            if (fastForward)
+                continue;
+            if (events.fruitsEaten > 0)
+                mixer.Play(eat.Get(), eatPriority);
+            if (events.Died())
+                mixer.Play(wall.Get(), wallPriority);
+        }
+        if (playback->Tick() >= playback->TickCount())
+            accumulator = sim.speed; // hold the final state, fully drawn
+        else if (steps == maxPlaybackTicks)
+            accumulator = 0;
     }
 
     /*
-     * CheckCollisionWithFood
-     * Objective: detect when the snake head occupies the same cell as a fruit,
-     *            handle eating (increase score, grow snake, respawn fruit, play sound).
-     * Input: none (uses members)
-     * Output: updates score, snake.addSegment, fruit position and textureIndex
-     * Return value: void
-     * Side effects: mutates fruits and snake state, plays sound, adjusts speed
+     * SpectatorInput
+     * Objective: apply this frame's spectator keys: Space pauses, F toggles fast-forward,
+     *            Left/Right seek seekTicks back/ahead, Home/End and 0-9 jump to the start,
+     *            the end or that tenth of the recording.
+     * Side effects: may seek sim to another recorded tick
      *
-     * Approach: iterate over fruits; if head equals fruit.position, move the fruit
-     * to a new valid location, mark snake to grow, increment score and optionally speed up.
+     * Approach: a seek costs one keyframe plus at most one keyframe interval of deltas
+     * (see BroadcastPlayer::Seek), so it finishes inside the frame wherever it lands.
      */
-    void CheckCollisionWithFood()
+    void SpectatorInput()
     {
-        for (auto &f : fruits)
+        uint32_t tick = playback->Tick();
+        uint32_t last = playback->TickCount();
+        uint32_t target = tick;
+        if (IsKeyPressed(KEY_SPACE))
+            paused = !paused;
+        if (IsKeyPressed(KEY_F))
+            fastForward = !fastForward;
+        if (IsKeyPressed(KEY_RIGHT))
+            target = tick + std::min(seekTicks, last - tick);
+        if (IsKeyPressed(KEY_LEFT))
+            target = tick - std::min(seekTicks, tick);
+        if (IsKeyPressed(KEY_HOME))
+            target = 0;
+        if (IsKeyPressed(KEY_END))
+            target = last;
+        for (int digit = 0; digit <= 9; digit++)
         {
-            if (Vector2Equals(snake.body[0], f.position)) // head equals fruit
-            {
-                f.position = f.GenerateRandomPos(snake.body); // respawn fruit
-                f.textureIndex = GetRandomValue(0, 3); // randomize appearance
-                snake.addSegment = true; // cause growth on next update
-                score++; // increase score
-                if(speed>=0.07)
-                    speed *= 0.98; // slightly increase speed by reducing interval
-                PlaySound(eat); // play eating sound
-            }
+            if (IsKeyPressed(KEY_ZERO + digit))
+                target = (uint32_t)((uint64_t)last * digit / 10);
+        }
+        if (target != tick)
+        {
+            playback->Seek(sim, target);
+            accumulator = sim.speed; // show the state sought, not the tick before it
         }
     }
 
     /*
-     * CheckCollisionWithEdges
-     * Objective: detect when the snake head moves beyond the grid and trigger game over.
-     * Input: none
-     * Output: may set game_over true and call GameOver()
-     * Return value: void
-     * Side effects: can reset game state and play sound
+     * DrawPlaybackStatus
+     * Objective: draw the spectator's position in the recording and its playback speed.
+     */
+    void DrawPlaybackStatus(int x, int y) const
+    {
+        if (paused)
+            DrawText(TextFormat("tick %u / %u  paused", playback->Tick(), playback->TickCount()), x, y, 20, darkGreen);
+        else
+            DrawText(TextFormat("tick %u / %u  %ix", playback->Tick(), playback->TickCount(),
+                                fastForward ? (int)fastForwardRate : 1), x, y, 20, darkGreen);
+    }
+
+    /*
+     * AdvanceOnline
+     * Objective: online counterpart of Advance(): the server runs the ticks, the client
+     *            applies them and this reacts to what happened to our snake.
+     * Input: double frameTime - seconds elapsed since the previous frame
+     * Side effects: sends queued turns; plays sounds; may end the round
      *
-     * Approach: compare head x/y against grid bounds [0, cellcount-1]; if outside trigger GameOver
+     * Approach:
+     * The client is pumped every frame, menus included, so the connection stays alive and
+     * the board keeps moving (the room does not pause; our snake goes straight on). The
+     * server keeps only the newest heading per tick, so queued turns go out one per
+     * applied server tick: up+left inside one tick still becomes two consecutive turns.
+     * A death ends the round like a local one; the server respawns the snake at once.
      */
-    void CheckCollisionWithEdges()
+    void AdvanceOnline(double frameTime)
     {
-        // check horizontal bounds (if head's x equals cellcount it's beyond right edge; -1 is beyond left)
-        if (snake.body[0].x == cellcount || snake.body[0].x == -1)
+        NetEvents events = net->Advance(frameTime);
+        if (events.ticks > 0)
+            steered = false;
+        if (!running)
+        {
+            inputCount = 0;
+            return;
+        }
+        if (inputCount > 0 && !steered)
+        {
+            net->Steer(PopInput());
+            steered = true;
+        }
+
+        uint32_t tick = net->World().tick;
+        float interval = net->World().tickMilliseconds / 1000.0f; // the server's tick, not the idle local sim's
+        if (events.fruitsEaten > 0)
         {
-            GameOver(); // handle game over state
-            PlaySound(wall); // play collision sound
+            mixer.Play(eat.Get(), eatPriority);
+            telemetry.Emit(TelemetryKind::FruitEaten, tick, Score(), interval);
         }
-        // check vertical bounds (beyond bottom or top)
-        if (snake.body[0].y == cellcount || snake.body[0].y == -1)
+        if (events.died)
         {
-            GameOver();
-            PlaySound(wall);
+            mixer.Play(wall.Get(), wallPriority);
+            telemetry.Emit(events.cause == ArenaDeath::Edge ? TelemetryKind::DeathEdge : TelemetryKind::DeathTail, tick,
+                           net->World().snakes[net->World().player].lastScore, interval);
+            GameOver(false);
         }
     }
 
     /*
-     * CheckCollisionsWithTail
-     * Objective: detect self-collision when head overlaps any other body segment and trigger game over.
-     * Input: none
-     * Output: may set game_over true and call GameOver()
-     * Return value: void
-     * Side effects: resets game state and plays collision sound
+     * QueueDirection
+     * Objective: buffer a direction change so it is applied on an upcoming tick instead of
+     *            overwriting the direction immediately.
+     * Input: Cell direction - requested unit step
+     *        int64_t polledAt - InputSystem::Now() when the key was read; 0 for turns that
+     *                           do not come from a key and are not measured
+     * Output: may append to inputQueue and inputTime
+     * Return value: bool - true if the turn was queued
+     * Side effects: none besides the queue
      *
-     * Approach: copy body to temporary 'headless' deque, remove the head and check if head equals any element.
-     * This avoids comparing the head with itself.
+     * Approach:
+     * Compare against the most recently queued direction (or the snake's current one when the
+     * queue is empty). Repeats and 180 degree reversals are rejected, so quick presses such as
+     * up+left inside one tick become two consecutive turns rather than the snake reversing
+     * into itself.
+     *
+     * Variable definition and use:
+     * last - direction the snake will have once every queued turn is applied
      */
-    void CheckCollisionsWithTail()
+    bool QueueDirection(Cell direction, int64_t polledAt = 0)
     {
-        deque<Vector2> headless = snake.body; // make a copy of the body
-        headless.pop_front(); // remove head so we only check against tail segments
-        if (ElementInDeque(snake.body[0], headless))
-        {
-            GameOver(); // collided with tail
-            PlaySound(wall);
-        }
+        Cell last = inputCount > 0 ? inputQueue[inputCount - 1] : Heading();
+        if (direction == last || (direction.x == -last.x && direction.y == -last.y))
+            return false; // same heading or a reversal
+        if (inputCount == maxQueuedInputs)
+            return false; // queue full; further presses this tick are dropped
+        inputTime[inputCount] = polledAt;
+        inputQueue[inputCount++] = direction;
+        return true;
     }
 
     /*
-     * Update
-     * Objective: advance game simulation by one tick if running: move snake and run collision checks.
-     * Input: none
-     * Output: updates snake and game state
-     * Return value: void
-     * Side effects: calls snake.Update which mutates its body
+     * PopInput
+     * Objective: remove the oldest buffered turn, keeping inputTime in step with the queue.
+     * Return value: Cell - the turn; the queue must not be empty
      */
-    void Update()
+    Cell PopInput()
     {
-        if (running)
+        Cell direction = inputQueue[0];
+        for (int i = 1; i < inputCount; i++)
         {
-            snake.Update(); // move the snake forward
-            CheckCollisionWithFood(); // handle eating
-            CheckCollisionWithEdges(); // handle boundary collision
-            CheckCollisionsWithTail(); // handle self collision
+            inputQueue[i - 1] = inputQueue[i];
+            inputTime[i - 1] = inputTime[i];
         }
+        inputCount--;
+        return direction;
     }
 
     /*
      * GameOver
-     * Objective: perform end-of-round tasks: reset snake and fruits, adjust speed and track high score.
-     * Input: none
+     * Objective: perform end-of-round tasks for the front end: show the game-over screen
+     *            and track the high score. The simulation has already reset the board.
+     * Input: bool won - true when the round ended because the snake filled the board
      * Output: resets game members
      * Return value: void
-     * Side effects: modifies global high_score and temp_score; resets game to waiting state
+     * Side effects: modifies global high_score and temp_score; resets game to waiting state;
+     *               queues the leaderboard record and the replay on the file writer
      *
-     * Approach: set game_over flag and reset snake; clear and repopulate fruits; update high_score logic.
+     * Approach: the leaderboard is updated in memory at once, and both files are handed to
+     * the writer thread as finished bytes, so the round ends without waiting for the disk.
      */
-    void GameOver()
+    void GameOver(bool won)
     {
+        int lastScore = arena ? arena->snakes[0].lastScore : sim.lastScore;
+        if (net)
+            lastScore = net->World().player >= 0 ? net->World().snakes[net->World().player].lastScore : 0;
         game_over = true; // enter game over state
-        snake.Reset(); // reset snake to starting position
-        fruits.clear(); // remove all fruits
-        for (int i = 0; i < 3; i++)
-        {
-            fruits.push_back(Food(snake.body)); // respawn three fruits at safe positions
-        }
-        speed = 0.2; // restore initial speed
+        game_won = won; // report a win instead of a crash
         running = false; // stop simulation
-        if (score >= high_score)
+        int rank = scores.Submit(scoreKey, lastScore, (int64_t)time(nullptr));
+        if (rank > 0)
+            TraceLog(LOG_INFO, "SCORES: %i is #%i of %i for %s", lastScore, rank, (int)scores.Top(scoreKey).size(),
+                     scoreKey.profile.c_str());
+        high_score = scores.Best(scoreKey); // update high score if needed
+        rounds++;
+        telemetry.Emit(TelemetryKind::RoundEnd, net ? net->World().tick : (uint32_t)ticks, lastScore, (float)sim.speed);
+        temp_score = lastScore; // copy last score for display on game over screen
+        inputCount = 0; // turns queued for the old round do not carry over
+        accumulator = 0;
+        if (!arena && !net)
         {
-            high_score = score; // update high score if needed
+            std::vector<uint8_t> bytes;
+            replay.Encode(bytes);
+            files.Replace(replayPath, std::move(bytes));
         }
-        temp_score = score; // copy last score for display on game over screen
-        score = 0; // reset current score
     }
 };
 
@@ -532,135 +864,321 @@ public:
  * main
  * Objective: initialize the window, create UI buttons and run the main game loop handling input,
  *            drawing and game state transitions.
- * Input: none
+ * Input: int argc, char **argv - `--board N` plays on an N x N board (default 25);
+ *        `--arena N` adds N bots on the same board; `--connect HOST[:PORT]` plays in
+ *        room `--room N` (default 0) of a snake_server instead; `--profile NAME` picks
+ *        whose leaderboard the session counts for; `--autopilot` lets the classic game play
+ *        itself (its scores go to the "autopilot" profile); `--hamilton` does the same along
+ *        a Hamiltonian cycle ("hamilton" profile); `--telemetry FILE` appends gameplay events;
+ *        `--fps N` caps the frame rate and `--no-vsync` stops waiting for the display;
+ *        `--broadcast FILE` records the classic game for spectators and `--watch FILE`
+ *        plays such a recording back (Space, F, Left/Right, Home/End and 0-9 to scrub)
  * Output: runs the application window until closed
  * Return value: int - 0 on normal exit
  * Side effects: opens window and audio device; loads assets via Game and Button constructors
  *
  * Approach:
- * - Initialize window and target FPS
- * - Create Button objects for start/exit/restart
- * - Create Game object which loads audio and textures
- * - Run rendering loop until window close or exit button pressed
+ * - Read the board size, or join the server room and take its board size (falling back to
+ *   a local game when it does not answer), then open the window; frames follow the
+ *   display through VSync instead of a fixed 60 FPS cap. The window is the same size
+ *   for every board, and the board view scrolls and zooms when it does not fit
+ * - Create Button objects for start/exit/restart and the Game object; their textures and
+ *   sounds are queued on an AsyncLoader, decoded on a worker thread and uploaded at most
+ *   uploadsPerFrame per frame, so the menu is drawn on the very first frame
+ * - While loading, the menu shows progress and the game cannot be started; time to the
+ *   first frame and to fully loaded assets are logged, followed by the cache's memory use
+ * - Every texture and sound is owned by one ResourceCache declared before its users, so
+ *   it outlives every handle and shares anything requested twice
+ * - Run the loop until window close or exit button pressed: read input, advance the
+ *   simulation with a fixed timestep, then render
  * - Handle three UI states: game over screen, main menu (not running), and active game
+ * - Static screen content lives in CachedLayers: each screen's background, headlines and
+ *   border are painted once, the game-over scores once per round, and each in-game score
+ *   label only when its value changes; every other frame they are one textured quad each
+ * - In SNAKE_PROFILE builds, F3 toggles the profiler overlay and F4 captures a Chrome trace
+ * - Load the leaderboards before the Game; their writer is declared first, so it outlives
+ *   the Game and finishes every queued write before the program exits
+ * - A --watch broadcast is loaded before the window, like a server room, for its board
+ *   size; the game then plays it back and the arrow keys scrub instead of steering
  * - Clean up via destructors and CloseWindow
  */
-int main()
+int main(int argc, char **argv)
 {
-    // Initialize a raylib window sized to fit the grid plus offsets
-    InitWindow(2 * offset + cellsize * cellcount, 2 * offset + cellsize * cellcount, "Snake's world");
-    SetTargetFPS(60); // cap framerate to 60 frames per second
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--board") && i + 1 < argc)
+            cellcount = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--arena") && i + 1 < argc)
+            arenaBots = std::clamp(atoi(argv[++i]), 0, OwnerGrid::maxSnakes - 1);
+        else if (!strcmp(argv[i], "--connect") && i + 1 < argc)
+            serverHost = argv[++i];
+        else if (!strcmp(argv[i], "--room") && i + 1 < argc)
+            serverRoom = (uint16_t)std::clamp(atoi(argv[++i]), 0, 0xFFFF);
+        else if (!strcmp(argv[i], "--profile") && i + 1 < argc)
+            profileName = argv[++i];
+        else if (!strcmp(argv[i], "--telemetry") && i + 1 < argc)
+            telemetryPath = argv[++i];
+        else if (!strcmp(argv[i], "--autopilot"))
+            autopilotMode = true;
+        else if (!strcmp(argv[i], "--hamilton"))
+            hamiltonMode = true;
+        else if (!strcmp(argv[i], "--fps") && i + 1 < argc)
+            frameCap = std::max(0, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--no-vsync"))
+            vsync = false;
+        else if (!strcmp(argv[i], "--broadcast") && i + 1 < argc)
+            broadcastPath = argv[++i];
+        else if (!strcmp(argv[i], "--watch") && i + 1 < argc)
+            watchPath = argv[++i];
+    }
+
+    std::unique_ptr<NetClient> net;
+    if (serverHost)
+    {
+        std::string host = serverHost; // HOST or HOST:PORT
+        size_t colon = host.rfind(':');
+        if (colon != std::string::npos)
+        {
+            serverPort = (uint16_t)atoi(host.c_str() + colon + 1);
+            host.resize(colon);
+        }
+        net.reset(new NetClient());
+        if (net->Connect(host.c_str(), serverPort, serverRoom, connectSeconds))
+            cellcount = net->World().boardSize;
+        else
+        {
+            TraceLog(LOG_WARNING, "NET: no answer from %s:%i, playing locally", host.c_str(), (int)serverPort);
+            net.reset();
+        }
+    }
+    std::unique_ptr<BroadcastPlayer> playback;
+    if (watchPath && !net)
+    {
+        playback.reset(new BroadcastPlayer());
+        if (playback->Load(watchPath))
+            cellcount = playback->boardSize;
+        else
+        {
+            TraceLog(LOG_WARNING, "BROADCAST: %s is not a broadcast, playing instead", watchPath);
+            playback.reset();
+        }
+    }
+    if (cellcount < minBoardSize || cellcount > maxBoardSize)
+    {
+        int requested = cellcount;
+        cellcount = std::clamp(cellcount, minBoardSize, maxBoardSize);
+        TraceLog(LOG_WARNING, "SIM: board size %i out of range, using %i", requested, cellcount);
+    }
 
+    // Initialize a raylib window sized to fit the board view plus offsets
+    const int screenSize = 2 * offset + viewSize;
+    if (vsync)
+        SetConfigFlags(FLAG_VSYNC_HINT); // one frame per display refresh, 144-240 Hz included
+    InitWindow(screenSize, screenSize, "Snake's world");
+    SetTargetFPS(frameCap); // 0 = no software cap; the snake interpolates between ticks at any rate
+
+    FileWriter files; // writes leaderboards and replays on its own thread; outlives the game
+    ScoreStore scores;
+    scores.Open(scoresPath, files); // queues a compacted copy when the log has dead records
     {
-        // instantiate UI buttons; Button takes path, position and scale
-        Button startButton{"graphics/start_button.png", {350, 300}, 0.65};
-        Button exitButton{"graphics/exit_button.png", {350, 450}, 0.65};
-        Button restartButton{"graphics/restart.png", {350, 500}, 1.5};
+        ResourceCache cache; // owns every texture and sound; declared first so it is destroyed last
+
+        // pre-decoded assets written by the asset_packer prebuild step; when the pack is
+        // missing every asset is decoded from its source file instead
+        AssetBundle assets;
+        if (!assets.Open("assets.pak"))
+            TraceLog(LOG_WARNING, "ASSETS: assets.pak not found, decoding source files");
+
+        // instantiate UI buttons at their positions; textures arrive through the loader
+        Button startButton{Vector2{350, 300}};
+        Button exitButton{Vector2{350, 450}};
+        Button restartButton{Vector2{350, 500}};
 
         bool exit = false; // control flag to break out of main loop when true
-        Game game = Game(); // create and initialize game (loads sounds & fruits)
+        bool firstFrame = true; // whether the first frame is still to be presented
+
+        // callbacks run only inside Pump(), so they never outlive the objects they write to
+        AsyncLoader loader(cache);
+        const int uploadsPerFrame = 2; // texture/sound uploads allowed per frame while loading
+
+        // menu buttons first so the first screen completes soonest; scales match packedImages
+        loader.AddImage("graphics/start_button.png", 0.65f, [&](TextureHandle t) { startButton.SetTexture(std::move(t)); });
+        loader.AddImage("graphics/exit_button.png", 0.65f, [&](TextureHandle t) { exitButton.SetTexture(std::move(t)); });
+        loader.AddImage("graphics/restart.png", 1.5f, [&](TextureHandle t) { restartButton.SetTexture(std::move(t)); });
+        Game game = Game(loader, scores, files, std::move(net), std::move(playback)); // queues sounds & fruits, returns immediately
+        loader.Start(&assets);
+
+        // cached screen layers; full-screen ones are opaque and replace ClearBackground,
+        // the score labels are transparent overlays positioned below the grid
+        const int labelY = offset + viewSize + 10;
+        const int scoreX = offset - 10;
+        const int highScoreX = viewSize - 185;
+        CachedLayer menuLayer(screenSize, screenSize);
+        CachedLayer gameOverLayer(screenSize, screenSize);
+        CachedLayer playLayer(screenSize, screenSize);
+        CachedLayer scoreLabel(screenSize - scoreX, 40);
+        CachedLayer highScoreLabel(screenSize - highScoreX, 40);
+
+        InputSystem input; // direction presses of the current frame
 
         // main loop: keep running while window is open and exit flag is false
         while (!WindowShouldClose() && exit == false)
         {
-            BeginDrawing(); // start drawing frame
-            ClearBackground(green); // clear with background color
+            // first thing in the frame, so the stamps sit right after raylib's event poll
+            input.Poll();
 
-            // allow Enter key to start the game when not already running
-            if (IsKeyPressed(KEY_ENTER) && game.running == false)
+            // hand finished decodes to their owners; once everything is in, drop the mapping
+            bool loaded = loader.Done();
+            if (!loaded)
+            {
+                loader.Pump(uploadsPerFrame);
+                if (loader.Done())
+                {
+                    assets.Close(); // uploads copied everything they needed out of the mapping
+                    TraceLog(LOG_INFO, "STARTUP: assets ready after %.1f ms", MillisecondsSinceStart());
+                    cache.LogUsage();
+                    game.mixer.Open(); // the loader opened the audio device before its first decode
+                }
+            }
+
+            // allow Enter key to start the game when not already running (and fully loaded)
+            if (IsKeyPressed(KEY_ENTER) && game.running == false && loaded)
             {
                 game.running = true; // start/resume simulation
                 game.game_over = false; // ensure game over flag cleared
             }
 
-            if (game.game_over == true)
+#ifdef SNAKE_PROFILE
+            if (IsKeyPressed(KEY_F3))
+                profiler.visible = !profiler.visible; // toggle the timing overlay
+            if (IsKeyPressed(KEY_F4))
+                profiler.StartCapture("profile_trace.json"); // Chrome trace of the next frames
+#endif
+
+            // gameplay input is read before simulating so a turn pressed this frame can
+            // apply on a tick that runs this frame; turns are queued, never slept on
+            if (game.running && game.game_over == false && game.playback)
+                game.SpectatorInput(); // the arrows seek instead of steering
+            else if (game.running && game.game_over == false)
             {
-                // render game over screen
-                ClearBackground(green);
-                DrawText("Game Over!", 220, 150, 90, darkGreen); // large headline
+                for (int i = 0; i < input.Count(); i++)
+                    game.QueueDirection(input[i].direction, input[i].polledAt); // in press order
+            }
 
-                Vector2 mousePosition = GetMousePosition(); // current mouse coords
-                bool mousePressed = IsMouseButtonPressed(MOUSE_BUTTON_LEFT); // check click
+            // fixed-timestep simulation, independent of how long the frame took to draw
+            game.Advance(GetFrameTime());
 
-                // show last score and high score
-                DrawText(TextFormat("Score: %i", temp_score), 350, 300, 60, darkGreen);
-                DrawText(TextFormat("High Score: %i", high_score), 280, 400, 60, darkGreen);
+            BeginDrawing(); // start drawing frame; every screen starts with an opaque cached layer
 
-                restartButton.Draw(); // draw restart button
-                if (restartButton.isPressed(mousePosition, mousePressed))
-                {
-                    // if pressed, resume the game by clearing game_over and starting running
-                    game.game_over = false;
-                    game.running = true;
-                }
-            }
-            else if ((!game.running) && (game.game_over == false))
             {
-                // main menu state (not running and not game over)
-                DrawText("Snake's World", 180, 150, 80, darkGreen);
-                Vector2 mousePosition = GetMousePosition();
-                bool mousePressed = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
-                startButton.Draw(); // draw start button
-                exitButton.Draw(); // draw exit button
-                if (exitButton.isPressed(mousePosition, mousePressed))
-                {
-                    exit = true; // signal to exit outer loop
-                }
-                else if (startButton.isPressed(mousePosition, mousePressed))
+                PROFILE_SCOPE(ProfileUi); // everything drawn for the current screen
+                if (game.game_over == true)
                 {
-                    game.running = true; // start the game when start button pressed
-                }
-            }
-            else
-            {
-                // active gameplay state
-                game.Draw(); // draw snake and fruits
-
-                // title and border for the playing grid
-                DrawText("Snake's World", offset - 5, 20, 40, darkGreen);
-                DrawRectangleLinesEx(Rectangle{(float)offset - 5, (float)offset - 5, (float)cellsize * cellcount + 10, (float)cellsize * cellcount + 10}, 5, darkGreen);
+                    // render game over screen: headline and scores only change once per round
+                    long long key = ((long long)high_score << 32) | ((long long)temp_score << 1) | game.game_won;
+                    bool won = game.game_won;
+                    gameOverLayer.Draw(Vector2{0, 0}, key, [won]()
+                    {
+                        ClearBackground(green);
+                        DrawText(won ? "You Win!" : "Game Over!", 220, 150, 90, darkGreen); // large headline
 
-                // display score and high score below the grid
-                DrawText(TextFormat("Score: %i", game.score), offset - 10, offset + cellsize * cellcount + 10, 40, darkGreen);
-                DrawText(TextFormat("High Score: %i", high_score), cellcount * cellsize - 185, offset + cellsize * cellcount + 10, 40, darkGreen);
+                        // show last score and high score
+                        DrawText(TextFormat("Score: %i", temp_score), 350, 300, 60, darkGreen);
+                        DrawText(TextFormat("High Score: %i", high_score), 280, 400, 60, darkGreen);
+                    });
 
-                // trigger game update at intervals determined by game.speed
-                if (EventTriggered(game.speed))
-                {
-                    game.Update(); // advance snake and perform collision checks
-                }
+                    Vector2 mousePosition = GetMousePosition(); // current mouse coords
+                    bool mousePressed = IsMouseButtonPressed(MOUSE_BUTTON_LEFT); // check click
 
-                // input handling for direction changes: prevent reversal by checking current direction
-                if ((IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W)) && game.snake.direction.y != 1)
-                {
-                    game.snake.direction = {0, -1}; // move up
-                    WaitTime(0.15); // small debounce to avoid accidental multiple direction changes
-                    game.running = true; // ensure simulation is active once a direction is pressed
-                }
-                if ((IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S)) && game.snake.direction.y != -1)
-                {
-                    game.snake.direction = {0, 1}; // move down
-                    WaitTime(0.15);
-                    game.running = true;
+                    restartButton.Draw(); // draw restart button
+                    if (restartButton.isPressed(mousePosition, mousePressed))
+                    {
+                        // if pressed, resume the game by clearing game_over and starting running
+                        game.game_over = false;
+                        game.running = true;
+                    }
                 }
-                if ((IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A)) && game.snake.direction.x != 1)
+                else if ((!game.running) && (game.game_over == false))
                 {
-                    game.snake.direction = {-1, 0}; // move left
-                    WaitTime(0.15);
-                    game.running = true;
+                    // main menu state (not running and not game over); the headline never changes
+                    menuLayer.Draw(Vector2{0, 0}, 0, []()
+                    {
+                        ClearBackground(green);
+                        DrawText("Snake's World", 180, 150, 80, darkGreen);
+                    });
+                    if (!loaded)
+                        DrawText(TextFormat("Loading %i%%", (int)(loader.Progress() * 100)), 350, 320, 30, darkGreen);
+                    Vector2 mousePosition = GetMousePosition();
+                    bool mousePressed = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+                    startButton.Draw(); // draw start button
+                    exitButton.Draw(); // draw exit button
+                    if (exitButton.isPressed(mousePosition, mousePressed))
+                    {
+                        exit = true; // signal to exit outer loop
+                    }
+                    else if (loaded && startButton.isPressed(mousePosition, mousePressed))
+                    {
+                        game.running = true; // start the game when start button pressed
+                    }
                 }
-                if ((IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D)) && game.snake.direction.x != -1)
+                else
                 {
-                    game.snake.direction = {1, 0}; // move right
-                    WaitTime(0.15);
-                    game.running = true;
+                    // active gameplay state: title and border for the playing grid are static
+                    playLayer.Draw(Vector2{0, 0}, 0, []()
+                    {
+                        ClearBackground(green);
+                        DrawText("Snake's World", offset - 5, 20, 40, darkGreen);
+                        DrawRectangleLinesEx(Rectangle{(float)offset - 5, (float)offset - 5, (float)viewSize + 10, (float)viewSize + 10}, 5, darkGreen);
+                    });
+                    game.UpdateCamera(); // zoom, pan or follow the head as moved by this frame's ticks
+                    game.Draw(); // draw snake and fruits
+                    if (game.playback)
+                        game.DrawPlaybackStatus(offset + viewSize - 330, 30);
+
+                    // display score and high score below the grid, re-rasterised only when they change
+                    int score = game.Score();
+                    scoreLabel.Draw(Vector2{(float)scoreX, (float)labelY}, score, [score]()
+                    {
+                        ClearBackground(BLANK);
+                        DrawText(TextFormat("Score: %i", score), 0, 0, 40, darkGreen);
+                    });
+                    highScoreLabel.Draw(Vector2{(float)highScoreX, (float)labelY}, high_score, []()
+                    {
+                        ClearBackground(BLANK);
+                        DrawText(TextFormat("High Score: %i", high_score), 0, 0, 40, darkGreen);
+                    });
                 }
             }
+#ifdef SNAKE_PROFILE
+            if (profiler.visible)
+                profiler.DrawOverlay(10, 10);
+#endif
 
-            EndDrawing(); // finish drawing frame
+            {
+                PROFILE_SCOPE(ProfilePresent);
+                EndDrawing(); // finish drawing frame
+            }
+#ifdef SNAKE_PROFILE
+            if (game.pendingPhoton != 0)
+            {
+                // the buffer swap has returned: the applied turn is on its way to the screen
+                profiler.RecordLatency(LatencyInputToPhoton, InputSystem::Now() - game.pendingPhoton);
+                game.pendingPhoton = 0;
+            }
+            profiler.EndFrame();
+#endif
+            if (firstFrame)
+            {
+                firstFrame = false;
+                TraceLog(LOG_INFO, "STARTUP: first frame after %.1f ms", MillisecondsSinceStart());
+            }
         }
+        loader.Cancel(); // join the worker before game closes the audio device it may be opening
     }
 
+    files.Flush(); // the last round's score and replay
+    if (files.Failures() > 0)
+        TraceLog(LOG_WARNING, "FILES: %i writes failed (%s, %s)", files.Failures(), scoresPath, replayPath);
     CloseWindow(); // close the raylib window and free resources
     return 0; // normal exit
 }
@@ -0,0 +1,259 @@
+#include "net_client.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+NetClient::NetClient()
+    : packet(UdpSocket::maxDatagram)
+{
+}
+
+/**
+ * NetClient::~NetClient
+ * ============================
+ * Objective:
+ *   Tell the server we left, so our snake goes back to a bot straight away
+ *   instead of after the server's timeout.
+ */
+NetClient::~NetClient()
+{
+    if (!socket.IsOpen())
+        return;
+    packet.clear();
+    PacketWriter out(packet);
+    out.Header(NetMessage::Leave);
+    socket.Send(server, packet.data(), packet.size());
+}
+
+/**
+ * NetClient::Connect
+ * ============================
+ * Objective:
+ *   Resolve the server, open a local port and join `room`.
+ *
+ * Approach:
+ *   UDP has no handshake, so Join is repeated every joinInterval until the first
+ *   keyframe arrives or `waitSeconds` pass. The keyframe also says which snake is
+ *   ours (none when the room is full and we only spectate).
+ */
+bool NetClient::Connect(const char *host, uint16_t port, uint16_t roomId, double waitSeconds)
+{
+    room = roomId;
+    if (!ResolveAddress(host, port, server) || !socket.Open(0))
+        return false;
+
+    auto start = std::chrono::steady_clock::now();
+    double lastJoin = -joinInterval;
+    for (;;)
+    {
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed >= waitSeconds)
+            return false;
+        if (elapsed - lastJoin >= joinInterval)
+        {
+            SendJoin();
+            lastJoin = elapsed;
+        }
+        socket.Wait(20);
+        Receive();
+        if (world.boardSize > 0)
+        {
+            if (world.player >= 0)
+                heading = world.snakes[world.player].direction;
+            SendInput(); // first acknowledgement, so deltas start flowing
+            return true;
+        }
+    }
+}
+
+/**
+ * NetClient::Steer
+ * ============================
+ * Objective:
+ *   Predict the new heading locally and send it at once.
+ */
+void NetClient::Steer(Cell direction)
+{
+    heading = direction;
+    inputSequence++;
+    SendInput();
+}
+
+/**
+ * NetClient::Advance
+ * ============================
+ * Objective:
+ *   Drain the socket and apply the buffered tick records that are due.
+ *
+ * Approach:
+ *   One record is due per server tick of elapsed time. When the buffer runs dry
+ *   the clock stops at a full interval, so the board rests on the newest tick.
+ *   Playback resumes once bufferTicks records are queued beyond the one then due
+ *   at once, which is what rebuilds the safety margin after a late packet. A buffer
+ *   beyond twice the target is cut back at once rather than replayed slowly.
+ *
+ * Variable definition and use:
+ *   interval - seconds per server tick; received - records buffered this frame
+ */
+NetEvents NetClient::Advance(double frameTime)
+{
+    NetEvents events;
+    silence += frameTime;
+    sinceInput += frameTime;
+    uint32_t newestBefore = NewestTick();
+    Receive();
+    bool received = NewestTick() != newestBefore;
+
+    auto applyNext = [&]()
+    {
+        std::vector<uint8_t> &record = pending[pendingFirst];
+        pendingFirst = (pendingFirst + 1) % pendingCapacity;
+        pendingCount--;
+        if (!world.ApplyTick(record.data(), record.size()))
+        {
+            pendingCount = 0; // out of step; the server resends from our acknowledged tick
+            return;
+        }
+        events.ticks++;
+        if (world.player >= 0)
+        {
+            const NetSnake &me = world.snakes[world.player];
+            events.fruitsEaten += me.ate;
+            if (me.died)
+            {
+                events.died = true;
+                events.cause = me.cause;
+            }
+        }
+    };
+
+    const double interval = world.tickMilliseconds / 1000.0;
+    if (waiting && pendingCount > bufferTicks)
+        waiting = false;
+    if (!waiting)
+    {
+        clock += frameTime;
+        while (pendingCount > 2 * bufferTicks)
+            applyNext();
+        while (clock >= interval && pendingCount > 0)
+        {
+            clock -= interval;
+            applyNext();
+        }
+        if (pendingCount == 0 && clock >= interval)
+        {
+            waiting = true; // starved: rebuild the buffer before moving on
+            clock = interval; // the next record is due as soon as playback resumes
+        }
+    }
+
+    if (received || sinceInput >= interval)
+        SendInput();
+    return events;
+}
+
+/**
+ * NetClient::TickFraction
+ * ============================
+ * Objective:
+ *   How far the display is between the last applied record and the next one.
+ */
+float NetClient::TickFraction() const
+{
+    const double interval = world.tickMilliseconds / 1000.0;
+    if (waiting || interval <= 0)
+        return 1.0f;
+    return (float)std::clamp(clock / interval, 0.0, 1.0);
+}
+
+/**
+ * NetClient::Receive
+ * ============================
+ * Objective:
+ *   Read every waiting datagram from the server.
+ *
+ * Approach:
+ *   A keyframe replaces the world only when it is newer than everything held,
+ *   which drops the buffer; otherwise it is stale and ignored. Delta packets hand
+ *   each record to Buffer(), which keeps only the ones that extend the sequence.
+ */
+void NetClient::Receive()
+{
+    NetAddress from;
+    int size;
+    while ((size = socket.Receive(from, packet.data(), packet.size())) >= 0)
+    {
+        if (from != server)
+            continue;
+        PacketReader reader(packet.data(), size);
+        NetMessage type;
+        if (!reader.Header(type))
+            continue;
+        silence = 0;
+
+        if (type == NetMessage::Keyframe)
+        {
+            PacketReader peek = reader;
+            uint32_t keyTick = peek.U32();
+            if (world.boardSize > 0 && keyTick <= NewestTick())
+                continue;
+            pendingCount = 0;
+            waiting = true;
+            if (!world.ReadKeyframe(reader))
+                world.boardSize = 0; // unusable; the server sends another while we do not acknowledge
+            clock = world.tickMilliseconds / 1000.0; // as when starved: the first record applies at once
+        }
+        else if (type == NetMessage::Delta && world.boardSize > 0)
+        {
+            int records = reader.U8();
+            for (int r = 0; r < records; r++)
+            {
+                size_t length = reader.U16();
+                const uint8_t *record = reader.Here();
+                if (!reader.Skip(length))
+                    break;
+                Buffer(record, length);
+            }
+        }
+    }
+}
+
+/**
+ * NetClient::Buffer
+ * ============================
+ * Objective:
+ *   Queue a tick record if it is the one right after the newest held.
+ */
+void NetClient::Buffer(const uint8_t *record, size_t size)
+{
+    if (size < 4 || pendingCount == pendingCapacity)
+        return;
+    uint32_t recordTick = record[0] | (record[1] << 8) | (record[2] << 16) | ((uint32_t)record[3] << 24);
+    if (recordTick != NewestTick() + 1)
+        return; // a resend we already hold, or beyond a gap
+    pending[(pendingFirst + pendingCount) % pendingCapacity].assign(record, record + size);
+    pendingCount++;
+}
+
+void NetClient::SendJoin()
+{
+    packet.clear();
+    PacketWriter out(packet);
+    out.Header(NetMessage::Join);
+    out.U16(room);
+    socket.Send(server, packet.data(), packet.size());
+    packet.resize(UdpSocket::maxDatagram);
+}
+
+void NetClient::SendInput()
+{
+    packet.clear();
+    PacketWriter out(packet);
+    out.Header(NetMessage::Input);
+    out.U32(inputSequence);
+    out.U8((uint8_t)NetDirectionCode(heading));
+    out.U32(NewestTick());
+    socket.Send(server, packet.data(), packet.size());
+    packet.resize(UdpSocket::maxDatagram);
+    sinceInput = 0;
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "net_protocol.hpp"
+#include "net_socket.hpp"
+
+/**
+ * =============================
+ * NetClient Overview
+ * =============================
+ * Client side of a multiplayer room (protocol in net_protocol.hpp): joins, sends
+ * the player's heading, and keeps a NetWorld mirror of the server's board.
+ *
+ * Tick records are buffered on arrival and applied on the client's own clock, one
+ * per server tick, about bufferTicks behind the newest one received. A late packet
+ * then only shrinks the buffer instead of freezing the board, and a burst is spread
+ * back out to the server's pace. When the buffer runs past twice its target, extra
+ * records are applied in the same frame to catch up.
+ *
+ * Between records the board is interpolated: TickFraction() is how far the client's
+ * clock has got towards the next record, and each NetSnake keeps its head and tail of
+ * the previous tick, which is all a renderer needs to draw heads and tails sliding
+ * from one cell to the next. While the buffer is starved the fraction stays at 1, and
+ * the first record after it is applied at once, so the picture never steps back.
+ *
+ * Input is predicted: Steer() sends the heading right away and Heading() reports
+ * it immediately, so turn validation and queued turns never wait a round trip. The
+ * server keeps the newest heading by sequence number, so lost or reordered inputs
+ * are harmless; every Input packet also acknowledges the newest record received.
+ *
+ * =============================
+ * NetClient (public API)
+ * =============================
+ * **bool Connect(const char *host, uint16_t port, uint16_t room, double waitSeconds)**
+ *   - Objective: join `room`, retrying, until the first keyframe arrives.
+ *   - Return: false when nothing arrived in time (no server, or the port is blocked).
+ *
+ * **void Steer(Cell direction)**
+ *   - Objective: request a new heading for our snake.
+ *
+ * **NetEvents Advance(double frameTime)**
+ *   - Objective: receive packets, apply the tick records that are due and keep the
+ *                connection alive.
+ *   - Return: what happened to our snake in the applied ticks.
+ *
+ * **float TickFraction()**
+ *   - Return: 0 when the last record was just applied, up to 1 when the next one is due;
+ *             the display shows the last tick that far from the one before.
+ *
+ * **const NetWorld &World()** / **Cell Heading()** / **bool Connected()**
+ */
+
+/*
+ * NetEvents struct
+ * Objective: our snake's outcome over the tick records applied by one Advance().
+ */
+struct NetEvents
+{
+    int fruitsEaten = 0;
+    bool died = false;
+    ArenaDeath cause = ArenaDeath::None; // why it died, when it did
+    int ticks = 0; // records applied
+};
+
+class NetClient
+{
+public:
+    static constexpr int bufferTicks = 2;          // target delay behind the newest record
+    static constexpr double joinInterval = 0.25;   // seconds between Join retries
+    static constexpr double timeoutSeconds = 5.0;  // silence after which Connected() is false
+
+    NetClient();
+    ~NetClient();
+    NetClient(const NetClient &) = delete;
+    NetClient &operator=(const NetClient &) = delete;
+
+    bool Connect(const char *host, uint16_t port, uint16_t room, double waitSeconds);
+    void Steer(Cell direction);
+    NetEvents Advance(double frameTime);
+
+    const NetWorld &World() const { return world; }
+    Cell Heading() const { return heading; }
+    bool Connected() const { return silence < timeoutSeconds && world.boardSize > 0; }
+    float TickFraction() const;
+
+private:
+    void Receive();
+    void Buffer(const uint8_t *record, size_t size);
+    void SendJoin();
+    void SendInput();
+    uint32_t NewestTick() const { return world.tick + pendingCount; } ///< newest record held in order
+
+    static constexpr int pendingCapacity = (int)historyTicks; // records held before they are applied
+
+    UdpSocket socket;
+    NetAddress server;
+    uint16_t room = 0;
+    NetWorld world;                   // the board as currently shown
+    std::vector<uint8_t> pending[pendingCapacity]; // ring of buffered records; keep their capacity
+    int pendingFirst = 0;
+    int pendingCount = 0;
+    std::vector<uint8_t> packet;      // receive and send buffer
+    Cell heading = {1, 0};            // predicted: the last heading we asked for
+    uint32_t inputSequence = 0;
+    double clock = 0;                 // time banked towards the next record
+    bool waiting = true;              // buffer ran dry; hold until bufferTicks more records are queued
+    double sinceInput = 0;            // time since the last Input packet
+    double silence = 0;               // time since the last packet from the server
+};
@@ -0,0 +1,405 @@
+#include "net_protocol.hpp"
+
+#include <utility>
+
+static const Cell netDirections[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}; // right, down, left, up
+
+// tick record snake code: bits 0-1 direction of the entered head, then flags
+static constexpr uint8_t codeTail = 1 << 2;    // tail cell left this tick
+static constexpr uint8_t codeEntered = 1 << 3; // head entered a cell (direction in bits 0-1, also set on death)
+static constexpr uint8_t codeAte = 1 << 4;     // that cell held a fruit
+static constexpr uint8_t codeDied = 1 << 5;    // removed at the end of the tick
+static constexpr uint8_t codeSpawn = 1 << 6;   // respawned; followed by cell and heading
+
+int NetDirectionCode(Cell direction)
+{
+    for (int code = 0; code < 4; code++)
+        if (netDirections[code] == direction)
+            return code;
+    return -1;
+}
+
+Cell NetDirection(int code)
+{
+    return netDirections[code & 3];
+}
+
+/**
+ * TickRecorder::Capture
+ * ============================
+ * Objective:
+ *   Remember which snakes are alive and which keep their tail in the coming tick.
+ */
+void TickRecorder::Capture(const Arena &arena)
+{
+    snakes.resize(arena.snakes.size());
+    for (size_t i = 0; i < snakes.size(); i++)
+        snakes[i] = Before{arena.snakes[i].alive, arena.snakes[i].growth > 0};
+}
+
+/**
+ * TickRecorder::Encode
+ * ============================
+ * Objective:
+ *   Write the tick record for the Step that just ran (format in net_protocol.hpp).
+ *
+ * Approach:
+ *   Every snake alive at the start of the tick popped its tail unless it was
+ *   growing; ArenaSnake::entered/ate/died tell the rest. A dying snake that entered
+ *   a cell (a head-on winner of the race) still reports the entry, since the cell
+ *   was briefly its own. The heading comes from `directions` because a respawn
+ *   overwrites ArenaSnake::direction. Fruit entries are exactly the eaten fruits,
+ *   the only ones Step moves.
+ */
+void TickRecorder::Encode(uint32_t tick, const Arena &arena, const Cell *directions, std::vector<uint8_t> &record) const
+{
+    record.clear();
+    PacketWriter out(record);
+    out.U32(tick);
+    for (size_t i = 0; i < arena.snakes.size(); i++)
+    {
+        const ArenaSnake &snake = arena.snakes[i];
+        uint8_t code = 0;
+        if (snakes[i].alive)
+        {
+            if (!snakes[i].growing)
+                code |= codeTail;
+            if (snake.entered)
+                code |= codeEntered;
+            if (snake.ate)
+                code |= codeAte;
+            if (snake.died)
+                code |= codeDied;
+            if (snake.entered || snake.died)
+                code |= (uint8_t)NetDirectionCode(directions[i]); // a death's heading tells edge from body
+        }
+        bool spawned = snake.alive && (!snakes[i].alive || snake.died);
+        if (spawned)
+            code |= codeSpawn;
+        out.U8(code);
+        if (spawned)
+        {
+            out.Position(snake.body[0]);
+            out.U8((uint8_t)NetDirectionCode(snake.direction));
+        }
+    }
+
+    const std::vector<int> &eaten = arena.EatenFruits();
+    out.U16((uint16_t)eaten.size());
+    for (int k : eaten)
+    {
+        const Food &food = arena.fruits[k];
+        out.U16((uint16_t)k);
+        out.Position(food.position);
+        out.U8((uint8_t)food.textureIndex);
+        out.U8(food.active ? 1 : 0);
+    }
+}
+
+/**
+ * EncodeKeyframe
+ * ============================
+ * Objective:
+ *   Write a full Keyframe packet for `player` (netSpectator for none).
+ *
+ * Approach:
+ *   Bodies are the head cell followed by the step from each segment to the next,
+ *   four steps per byte, so a full 256 x 256 board still fits one datagram.
+ */
+void EncodeKeyframe(const Arena &arena, uint32_t tick, int tickMilliseconds, uint16_t player,
+                    std::vector<uint8_t> &packet)
+{
+    packet.clear();
+    PacketWriter out(packet);
+    out.Header(NetMessage::Keyframe);
+    out.U32(tick);
+    out.U16((uint16_t)tickMilliseconds);
+    out.U16(player);
+    out.U16((uint16_t)arena.boardSize);
+    out.U16((uint16_t)arena.snakes.size());
+    out.U16((uint16_t)arena.fruits.size());
+    for (const Food &food : arena.fruits)
+    {
+        out.Position(food.position);
+        out.U8((uint8_t)food.textureIndex);
+        out.U8(food.active ? 1 : 0);
+    }
+    for (const ArenaSnake &snake : arena.snakes)
+    {
+        out.U8(snake.alive ? 1 : 0);
+        out.U8((uint8_t)NetDirectionCode(snake.direction));
+        out.U16((uint16_t)(snake.score < 0xFFFF ? snake.score : 0xFFFF));
+        out.U32(snake.body.size());
+        if (snake.body.size() == 0)
+            continue;
+        out.Position(snake.body[0]);
+        uint8_t packed = 0;
+        for (unsigned int i = 1; i < snake.body.size(); i++)
+        {
+            Cell step = {(int16_t)(snake.body[i].x - snake.body[i - 1].x), (int16_t)(snake.body[i].y - snake.body[i - 1].y)};
+            packed |= (uint8_t)(NetDirectionCode(step) << (2 * ((i - 1) & 3)));
+            if ((i & 3) == 0 || i + 1 == snake.body.size())
+            {
+                out.U8(packed);
+                packed = 0;
+            }
+        }
+    }
+}
+
+/**
+ * NetWorld::ReadKeyframe
+ * ============================
+ * Objective:
+ *   Rebuild the board from a Keyframe packet.
+ *
+ * Return Value:
+ *   - bool → false on a malformed packet or one that breaks the server's limits;
+ *            the world may then be partly overwritten and must wait for the next one.
+ *
+ * Approach:
+ *   Fruits are written into the grid before the snakes, in the server's
+ *   convention (snake id + 1, fruitTag + fruit). Chunk versions keep counting up
+ *   across keyframes, so cached chunk tiles are always rebuilt. Bodies are unpacked step by step
+ *   and every cell is checked against the board, so a corrupt packet cannot index
+ *   outside the grid.
+ */
+bool NetWorld::ReadKeyframe(PacketReader &reader)
+{
+    uint32_t keyTick = reader.U32();
+    int keyTickMs = reader.U16();
+    uint16_t keyPlayer = reader.U16();
+    int size = reader.U16();
+    int snakeCount = reader.U16();
+    int fruitCount = reader.U16();
+    if (!reader.Ok() || size < 1 || size > netMaxBoard || snakeCount > netMaxSnakes || fruitCount >= OwnerGrid::fruitTag)
+        return false;
+
+    boardSize = size;
+    tick = keyTick;
+    tickMilliseconds = keyTickMs > 0 ? keyTickMs : 100;
+    player = keyPlayer < snakeCount ? keyPlayer : -1;
+    versions.swap(grid.chunkVersion);
+    grid.Resize(size);
+    if (versions.size() == grid.chunkVersion.size())
+        for (size_t c = 0; c < versions.size(); c++)
+            grid.chunkVersion[c] = versions[c] + 1; // renderers must not mistake the new board for the old one
+    fruits.assign(fruitCount, Food());
+    snakes.resize(snakeCount);
+
+    for (int k = 0; k < fruitCount; k++)
+    {
+        Food &food = fruits[k];
+        food.position = reader.Position();
+        food.textureIndex = reader.U8() % Food::textureCount;
+        food.active = reader.U8() != 0 && grid.InBounds(food.position);
+        if (food.active)
+            grid.Set(food.position, (uint16_t)(OwnerGrid::fruitTag + k));
+    }
+    for (int i = 0; i < snakeCount; i++)
+    {
+        NetSnake &snake = snakes[i];
+        snake.alive = reader.U8() != 0;
+        snake.direction = NetDirection(reader.U8());
+        snake.score = reader.U16();
+        snake.ate = false;
+        snake.died = false;
+        snake.moved = false;
+        snake.tailMoved = false;
+        uint32_t length = reader.U32();
+        if (!reader.Ok() || length > (uint32_t)size * size)
+            return false;
+        snake.body.Reserve(length + 1 > Arena::startCapacity ? length + 1 : Arena::startCapacity);
+        if (length == 0)
+            continue;
+        Cell cell = reader.Position();
+        uint8_t packed = 0;
+        for (uint32_t s = 0; s < length; s++)
+        {
+            if (s > 0)
+            {
+                if (((s - 1) & 3) == 0)
+                    packed = reader.U8();
+                cell = cell + NetDirection(packed >> (2 * ((s - 1) & 3)));
+            }
+            if (!reader.Ok() || !grid.InBounds(cell))
+                return false;
+            snake.body.push_front(cell); // tail ends up first; reversed below
+            grid.Set(cell, (uint16_t)(i + 1));
+        }
+        for (uint32_t a = 0, b = length - 1; a < b; a++, b--)
+            std::swap(snake.body[a], snake.body[b]);
+    }
+    return reader.Ok();
+}
+
+/**
+ * NetWorld::ApplyTick
+ * ============================
+ * Objective:
+ *   Advance the mirrored board by one tick record.
+ *
+ * Approach:
+ *   The whole record is decoded and validated into scratch arrays first, so a
+ *   malformed or out-of-order record changes nothing. It is then applied in
+ *   Arena::Step's order: heads are computed before tails pop (a length-1 snake
+ *   still knows where it goes), tails leave, heads enter, the dead are removed,
+ *   eaten fruits move and respawns are placed last.
+ */
+bool NetWorld::ApplyTick(const uint8_t *record, size_t size)
+{
+    PacketReader reader(record, size);
+    if (reader.U32() != tick + 1 || !reader.Ok())
+        return false;
+
+    const size_t count = snakes.size();
+    codes.resize(count);
+    heads.resize(count);
+    spawnCells.resize(count);
+    spawnCodes.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        codes[i] = reader.U8();
+        bool entered = (codes[i] & codeEntered) != 0;
+        if ((codes[i] & (codeTail | codeEntered | codeDied)) && (!snakes[i].alive || snakes[i].body.size() == 0))
+            return false; // only living snakes move or die
+        if (entered || (codes[i] & codeDied))
+        {
+            heads[i] = snakes[i].body[0] + NetDirection(codes[i]); // for a death that did not enter: the cell it hit
+            if (entered && !grid.InBounds(heads[i]))
+                return false;
+        }
+        if (codes[i] & codeSpawn)
+        {
+            spawnCells[i] = reader.Position();
+            spawnCodes[i] = reader.U8();
+            if (!grid.InBounds(spawnCells[i]))
+                return false;
+        }
+    }
+    fruitUpdates.resize(reader.U16());
+    for (FruitUpdate &update : fruitUpdates)
+    {
+        update.index = reader.U16();
+        update.food.position = reader.Position();
+        update.food.textureIndex = reader.U8() % Food::textureCount;
+        update.food.active = reader.U8() != 0;
+        if (update.index >= (int)fruits.size() || (update.food.active && !grid.InBounds(update.food.position)))
+            return false;
+    }
+    if (!reader.Ok())
+        return false;
+
+    tick++;
+    for (size_t i = 0; i < count; i++)
+    {
+        NetSnake &snake = snakes[i];
+        snake.ate = false;
+        snake.died = false;
+        snake.cause = ArenaDeath::None;
+        snake.moved = false;
+        snake.tailMoved = false;
+        if (snake.body.size() > 0)
+            snake.previousHead = snake.body[0];
+        if ((codes[i] & codeTail) && snake.body.size() > 0)
+        {
+            snake.previousTail = snake.body.back(); // kept for interpolated drawing
+            snake.tailMoved = true;
+            grid.Set(snake.body.back(), OwnerGrid::unowned);
+            snake.body.pop_back();
+        }
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!(codes[i] & codeEntered))
+            continue;
+        NetSnake &snake = snakes[i];
+        if (snake.body.size() == snake.body.capacity())
+            snake.body.Grow();
+        snake.body.push_front(heads[i]);
+        grid.Set(heads[i], (uint16_t)(i + 1));
+        snake.direction = NetDirection(codes[i]);
+        snake.moved = true;
+        if (codes[i] & codeAte)
+        {
+            snake.ate = true;
+            snake.score++;
+        }
+    }
+    for (size_t i = 0; i < count; i++)
+        if (codes[i] & codeDied)
+            snakes[i].cause = DeathCause((int)i);
+    for (size_t i = 0; i < count; i++)
+        if (codes[i] & codeDied)
+            Kill((int)i);
+    for (const FruitUpdate &update : fruitUpdates)
+    {
+        fruits[update.index] = update.food;
+        if (update.food.active)
+            grid.Set(update.food.position, (uint16_t)(OwnerGrid::fruitTag + update.index));
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!(codes[i] & codeSpawn))
+            continue;
+        NetSnake &snake = snakes[i];
+        snake.body.clear();
+        snake.body.push_front(spawnCells[i]);
+        grid.Set(spawnCells[i], (uint16_t)(i + 1));
+        snake.direction = NetDirection(spawnCodes[i]);
+        snake.alive = true;
+        snake.moved = false; // appears in place
+        snake.tailMoved = false;
+    }
+    return true;
+}
+
+/**
+ * NetWorld::DeathCause
+ * ============================
+ * Objective:
+ *   Work out why snake `index` died in the tick being applied, as Arena::Enter decided.
+ *
+ * Approach:
+ *   Runs after the heads entered and before anyone is removed. A dying snake that
+ *   entered its cell lost a head-on race it had arrived first in. Otherwise heads[index]
+ *   is the cell it ran into: off the board is an edge death, a cell another head
+ *   entered this tick is head-on, and anything else is a body.
+ *
+ * Variable definition and use:
+ *   hit - the blocked cell; owner - grid value there; other - snake that owns it
+ */
+ArenaDeath NetWorld::DeathCause(int index) const
+{
+    if (codes[index] & codeEntered)
+        return ArenaDeath::HeadOn;
+    Cell hit = heads[index];
+    if (!grid.InBounds(hit))
+        return ArenaDeath::Edge;
+    uint16_t owner = grid.Owner(hit);
+    int other = owner - 1;
+    if (owner != OwnerGrid::unowned && owner < OwnerGrid::fruitTag && other != index &&
+        (codes[other] & codeEntered) && heads[other] == hit)
+        return ArenaDeath::HeadOn;
+    return ArenaDeath::Body;
+}
+
+/**
+ * NetWorld::Kill
+ * ============================
+ * Objective:
+ *   Mirror Arena::Kill: free the body's cells and keep the score in lastScore.
+ */
+void NetWorld::Kill(int index)
+{
+    NetSnake &snake = snakes[index];
+    for (unsigned int i = 0; i < snake.body.size(); i++)
+        grid.Set(snake.body[i], OwnerGrid::unowned);
+    snake.body.clear();
+    snake.lastScore = snake.score;
+    snake.score = 0;
+    snake.alive = false;
+    snake.died = true;
+    snake.moved = false;
+    snake.tailMoved = false;
+}
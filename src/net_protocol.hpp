@@ -0,0 +1,265 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "arena.hpp"
+
+/**
+ * =============================
+ * Multiplayer Protocol Overview
+ * =============================
+ * Wire format between snake_server and the game's --connect mode. The server is
+ * authoritative: it owns one Arena per room and steps it at a fixed tick; clients
+ * only send their heading and mirror the board from what the server reports.
+ *
+ * A tick is reported as a delta, never as whole bodies: per snake one code byte
+ * (tail popped, head entered in direction d, ate, died), plus five bytes when a
+ * snake respawns and eight bytes per fruit eaten. The size of a tick therefore
+ * depends on the number of snakes, not on how long they are. The client replays
+ * the codes in the same order as Arena::Step (tails, heads, deaths, fruits, spawns),
+ * so its OwnerGrid stays a cell-for-cell copy of the server's.
+ *
+ * Deltas only apply in order, so the server keeps the last historyTicks tick records
+ * of each room and sends every record the client has not acknowledged yet, oldest
+ * first. A client that is new, or further behind than the history, gets a keyframe
+ * (every body packed at two bits per segment) and continues from its tick.
+ *
+ * =============================
+ * Packets (little endian)
+ * =============================
+ *   every packet : "SK", version, NetMessage
+ *   Join     c→s : room u16
+ *   Input    c→s : sequence u32, direction u8, ack u32 (newest tick held in order)
+ *   Leave    c→s : -
+ *   Keyframe s→c : tick u32, tick ms u16, player u16 (0xFFFF = spectator),
+ *                  board u16, snakes u16, fruits u16,
+ *                  per fruit (x i16, y i16, visual u8, active u8),
+ *                  per snake (alive u8, direction u8, score u16, length u32,
+ *                             [head x i16, y i16, (length - 1) 2-bit steps])
+ *   Delta    s→c : record count u8, then per record length u16 + tick record
+ *   tick record  : tick u32, per snake code u8 [+ spawn x i16, y i16, direction u8],
+ *                  fruit count u16, per fruit (index u16, x i16, y i16, visual u8, active u8)
+ *
+ * Directions are 0 right, 1 down, 2 left, 3 up, as in replays. A code carries the
+ * heading when the head entered a cell and also when the snake died, so the client
+ * can tell an edge death from a collision.
+ *
+ * =============================
+ * Types
+ * =============================
+ * - **PacketWriter / PacketReader** : little-endian field encoding with bounds checks.
+ * - **TickRecorder** : server side; captures an Arena before Step and encodes the
+ *                      tick record afterwards.
+ * - **NetWorld**     : client side; the mirrored board, built from a keyframe and
+ *                      advanced one tick record at a time.
+ */
+
+static constexpr uint16_t netDefaultPort = 7777;
+static constexpr uint8_t netVersion = 2;   // 2: dying snakes report their heading
+static constexpr int netMaxBoard = 256;     // keeps a full keyframe inside one datagram
+static constexpr int netMaxSnakes = 255;    // per room
+static constexpr uint16_t netSpectator = 0xFFFF;
+static constexpr uint32_t historyTicks = 64; // tick records a room keeps for resends
+
+enum class NetMessage : uint8_t
+{
+    Join = 1,
+    Input = 2,
+    Leave = 3,
+    Keyframe = 4,
+    Delta = 5,
+};
+
+int NetDirectionCode(Cell direction); ///< 0..3 for a unit step, -1 otherwise
+Cell NetDirection(int code);          ///< inverse of NetDirectionCode (code & 3)
+
+/*
+ * PacketWriter class
+ * Objective: append little-endian fields to a byte vector (which keeps its capacity
+ *            between packets).
+ */
+class PacketWriter
+{
+public:
+    explicit PacketWriter(std::vector<uint8_t> &buffer) : out(buffer) {}
+
+    void U8(uint8_t value) { out.push_back(value); }
+    void U16(uint16_t value)
+    {
+        out.push_back((uint8_t)value);
+        out.push_back((uint8_t)(value >> 8));
+    }
+    void U32(uint32_t value)
+    {
+        U16((uint16_t)value);
+        U16((uint16_t)(value >> 16));
+    }
+    void Position(Cell cell)
+    {
+        U16((uint16_t)cell.x);
+        U16((uint16_t)cell.y);
+    }
+    void Header(NetMessage type)
+    {
+        U8('S');
+        U8('K');
+        U8(netVersion);
+        U8((uint8_t)type);
+    }
+    size_t Size() const { return out.size(); }
+
+private:
+    std::vector<uint8_t> &out;
+};
+
+/*
+ * PacketReader class
+ * Objective: read little-endian fields from a received datagram. Reading past the
+ *            end returns zeros and clears Ok(), so decoders check once at the end.
+ */
+class PacketReader
+{
+public:
+    PacketReader(const uint8_t *bytes, size_t length) : data(bytes), size(length) {}
+
+    uint8_t U8()
+    {
+        if (pos + 1 > size)
+        {
+            ok = false;
+            return 0;
+        }
+        return data[pos++];
+    }
+    uint16_t U16()
+    {
+        uint16_t low = U8();
+        return (uint16_t)(low | (U8() << 8));
+    }
+    uint32_t U32()
+    {
+        uint32_t low = U16();
+        return low | ((uint32_t)U16() << 16);
+    }
+    Cell Position()
+    {
+        int16_t x = (int16_t)U16();
+        return Cell{x, (int16_t)U16()};
+    }
+    bool Header(NetMessage &type)
+    {
+        bool valid = U8() == 'S' && U8() == 'K' && U8() == netVersion;
+        type = (NetMessage)U8();
+        return valid && ok;
+    }
+    const uint8_t *Here() const { return data + pos; }
+    bool Skip(size_t bytes)
+    {
+        if (pos + bytes > size)
+            return ok = false;
+        pos += bytes;
+        return true;
+    }
+    size_t Remaining() const { return size - pos; }
+    bool Ok() const { return ok; }
+
+private:
+    const uint8_t *data;
+    size_t size;
+    size_t pos = 0;
+    bool ok = true;
+};
+
+/*
+ * TickRecorder class
+ * Objective: server side of the delta: what every snake looked like before Arena::Step,
+ *            so the record can say what changed; eaten fruits come from the Arena.
+ * Member functions:
+ *  - Capture() : call right before Step.
+ *  - Encode()  : call right after Step with the same directions; replaces `record`.
+ */
+class TickRecorder
+{
+public:
+    void Capture(const Arena &arena);
+    void Encode(uint32_t tick, const Arena &arena, const Cell *directions, std::vector<uint8_t> &record) const;
+
+private:
+    struct Before
+    {
+        bool alive;
+        bool growing; // tail stays this tick
+    };
+    std::vector<Before> snakes;
+};
+
+void EncodeKeyframe(const Arena &arena, uint32_t tick, int tickMilliseconds, uint16_t player,
+                    std::vector<uint8_t> &packet);
+
+/*
+ * NetSnake struct
+ * Objective: a mirrored snake: body, heading and score as last reported, and why it
+ *            died (cause, as ArenaSnake::cause) when it died in the last applied tick.
+ *            previousHead, previousTail, moved and tailMoved describe that tick like
+ *            Snake::previousTail/tailMoved do, so the client can draw in between ticks.
+ */
+struct NetSnake
+{
+    SnakeBody body;
+    Cell direction = {1, 0};
+    int score = 0;
+    int lastScore = 0; // score when it last died
+    bool alive = false;
+    bool ate = false;  // in the last applied tick
+    bool died = false; // in the last applied tick
+    ArenaDeath cause = ArenaDeath::None;
+    Cell previousHead = {0, 0}; // head before the last applied tick (valid when moved)
+    Cell previousTail = {0, 0}; // tail cell that tick popped (valid when tailMoved)
+    bool moved = false;         // the head entered a cell in that tick and the snake lives
+    bool tailMoved = false;     // that tick popped the tail of a snake that lives
+};
+
+/*
+ * NetWorld class
+ * Objective: client copy of one room. Snake i is stored in the grid as i + 1 and
+ *            fruit k as fruitTag + k, exactly like the server's Arena.
+ * Member functions:
+ *  - ReadKeyframe() : replace the whole state (reader positioned after the header).
+ *  - ApplyTick()    : apply one tick record; returns false, leaving the state untouched,
+ *                     unless it is a well-formed record for tick + 1.
+ */
+class NetWorld
+{
+public:
+    int boardSize = 0;
+    uint32_t tick = 0;
+    int tickMilliseconds = 100;
+    int player = -1; // our snake, -1 for a spectator
+    OwnerGrid grid;
+    std::vector<NetSnake> snakes;
+    std::vector<Food> fruits;
+
+    bool ReadKeyframe(PacketReader &reader);
+    bool ApplyTick(const uint8_t *record, size_t size);
+
+private:
+    /*
+     * FruitUpdate
+     * Objective: one fruit entry of the record being applied.
+     */
+    struct FruitUpdate
+    {
+        int index;
+        Food food;
+    };
+
+    ArenaDeath DeathCause(int index) const;
+    void Kill(int index);
+    std::vector<uint8_t> codes;      // per snake code of the record being applied
+    std::vector<Cell> heads;         // per snake, the cell its head enters
+    std::vector<Cell> spawnCells;    // per snake, where it respawns (if the code says so)
+    std::vector<uint8_t> spawnCodes; // per snake, its heading after the respawn
+    std::vector<FruitUpdate> fruitUpdates;
+    std::vector<uint32_t> versions; // chunk versions carried over a keyframe
+};
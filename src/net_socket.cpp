@@ -0,0 +1,187 @@
+#include "net_socket.hpp"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef int SocketLength;
+typedef SOCKET NativeSocket;
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef socklen_t SocketLength;
+typedef int NativeSocket;
+#endif
+
+/**
+ * StartSockets
+ * ============================
+ * Objective:
+ *   Initialise Winsock once per process; nothing to do on other platforms.
+ */
+static bool StartSockets()
+{
+#ifdef _WIN32
+    static const bool started = []()
+    {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return started;
+#else
+    return true;
+#endif
+}
+
+static sockaddr_in ToSockaddr(const NetAddress &address)
+{
+    sockaddr_in native;
+    memset(&native, 0, sizeof(native));
+    native.sin_family = AF_INET;
+    native.sin_addr.s_addr = htonl(address.ip);
+    native.sin_port = htons(address.port);
+    return native;
+}
+
+/**
+ * ResolveAddress
+ * ============================
+ * Objective:
+ *   Turn a host name or dotted IPv4 address into a NetAddress.
+ *
+ * Approach:
+ *   getaddrinfo restricted to IPv4 datagram sockets; the first result wins.
+ */
+bool ResolveAddress(const char *host, uint16_t port, NetAddress &address)
+{
+    if (!StartSockets())
+        return false;
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo *found = nullptr;
+    if (getaddrinfo(host, nullptr, &hints, &found) != 0 || !found)
+        return false;
+    address.ip = ntohl(((const sockaddr_in *)found->ai_addr)->sin_addr.s_addr);
+    address.port = port;
+    freeaddrinfo(found);
+    return true;
+}
+
+UdpSocket::~UdpSocket()
+{
+    Close();
+}
+
+/**
+ * UdpSocket::Open
+ * ============================
+ * Objective:
+ *   Create a non-blocking UDP socket bound to `port` on all interfaces.
+ *
+ * Return Value:
+ *   - bool → false if the socket cannot be created or the port is taken.
+ */
+bool UdpSocket::Open(uint16_t port)
+{
+    Close();
+    if (!StartSockets())
+        return false;
+    NativeSocket fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifdef _WIN32
+    if (fd == INVALID_SOCKET)
+        return false;
+#else
+    if (fd < 0)
+        return false;
+#endif
+    handle = (intptr_t)fd;
+
+    NetAddress any;
+    any.port = port;
+    sockaddr_in local = ToSockaddr(any);
+    bool bound = bind((NativeSocket)handle, (const sockaddr *)&local, sizeof(local)) == 0;
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    bool configured = ioctlsocket((NativeSocket)handle, FIONBIO, &nonBlocking) == 0;
+#else
+    bool configured = fcntl((NativeSocket)handle, F_SETFL, fcntl((NativeSocket)handle, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+    if (!bound || !configured)
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void UdpSocket::Close()
+{
+    if (handle == invalidHandle)
+        return;
+#ifdef _WIN32
+    closesocket((NativeSocket)handle);
+#else
+    close((NativeSocket)handle);
+#endif
+    handle = invalidHandle;
+}
+
+bool UdpSocket::Send(const NetAddress &to, const uint8_t *data, size_t size)
+{
+    if (handle == invalidHandle || size > maxDatagram)
+        return false;
+    sockaddr_in remote = ToSockaddr(to);
+    return sendto((NativeSocket)handle, (const char *)data, (int)size, 0, (const sockaddr *)&remote,
+                  sizeof(remote)) == (int)size;
+}
+
+/**
+ * UdpSocket::Receive
+ * ============================
+ * Objective:
+ *   Read the next waiting datagram without blocking.
+ *
+ * Return Value:
+ *   - int → datagram size, or -1 when nothing is waiting (or on error). Datagrams
+ *           larger than `capacity` are dropped.
+ */
+int UdpSocket::Receive(NetAddress &from, uint8_t *buffer, size_t capacity)
+{
+    if (handle == invalidHandle)
+        return -1;
+    sockaddr_in remote;
+    SocketLength length = sizeof(remote);
+    int size = (int)recvfrom((NativeSocket)handle, (char *)buffer, (int)capacity, 0, (sockaddr *)&remote, &length);
+    if (size < 0)
+        return -1;
+    from.ip = ntohl(remote.sin_addr.s_addr);
+    from.port = ntohs(remote.sin_port);
+    return size;
+}
+
+/**
+ * UdpSocket::Wait
+ * ============================
+ * Objective:
+ *   Sleep until a datagram arrives or `milliseconds` pass.
+ */
+bool UdpSocket::Wait(int milliseconds)
+{
+    if (handle == invalidHandle)
+        return false;
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET((NativeSocket)handle, &readable);
+    timeval timeout;
+    timeout.tv_sec = milliseconds / 1000;
+    timeout.tv_usec = (milliseconds % 1000) * 1000;
+    return select((int)(handle + 1), &readable, nullptr, nullptr, &timeout) > 0;
+}
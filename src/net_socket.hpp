@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * =============================
+ * UDP Socket Overview
+ * =============================
+ * The smallest socket layer the multiplayer code needs: one non-blocking IPv4 UDP
+ * socket per process, datagrams in and out, and a wait with timeout so a server
+ * can sleep until its next tick or the next packet. The platform headers (Winsock
+ * on Windows, BSD sockets elsewhere) stay inside net_socket.cpp; Winsock and
+ * raylib declare clashing names, so they must never meet in one translation unit.
+ *
+ * =============================
+ * Functions
+ * =============================
+ * **bool ResolveAddress(const char *host, uint16_t port, NetAddress &address)**
+ *   - Objective: look up an IPv4 host name or dotted address.
+ *   - Return: false when the name does not resolve.
+ *
+ * =============================
+ * UdpSocket (public API)
+ * =============================
+ * **bool Open(uint16_t port)**
+ *   - Objective: bind to `port` on every interface (0 = any free port, for clients).
+ *
+ * **bool Send(const NetAddress &to, const uint8_t *data, size_t size)**
+ *   - Return: false if the datagram could not be queued; UDP gives no other feedback.
+ *
+ * **int Receive(NetAddress &from, uint8_t *buffer, size_t capacity)**
+ *   - Return: size of the next datagram, or -1 when none is waiting.
+ *
+ * **bool Wait(int milliseconds)**
+ *   - Return: true as soon as a datagram is waiting, false on timeout.
+ *
+ * Send and Receive may be called from different threads at the same time.
+ */
+
+/*
+ * NetAddress struct
+ * Objective: IPv4 endpoint in host byte order, comparable so it can identify a client.
+ */
+struct NetAddress
+{
+    uint32_t ip = 0;
+    uint16_t port = 0;
+};
+
+inline bool operator==(const NetAddress &a, const NetAddress &b) { return a.ip == b.ip && a.port == b.port; }
+inline bool operator!=(const NetAddress &a, const NetAddress &b) { return !(a == b); }
+
+bool ResolveAddress(const char *host, uint16_t port, NetAddress &address);
+
+class UdpSocket
+{
+public:
+    static constexpr size_t maxDatagram = 65507; // largest UDP payload over IPv4
+
+    UdpSocket() = default;
+    ~UdpSocket();
+    UdpSocket(const UdpSocket &) = delete;
+    UdpSocket &operator=(const UdpSocket &) = delete;
+
+    bool Open(uint16_t port);
+    void Close();
+    bool IsOpen() const { return handle != invalidHandle; }
+
+    bool Send(const NetAddress &to, const uint8_t *data, size_t size);
+    int Receive(NetAddress &from, uint8_t *buffer, size_t capacity);
+    bool Wait(int milliseconds);
+
+private:
+    static constexpr intptr_t invalidHandle = -1;
+    intptr_t handle = invalidHandle; // SOCKET on Windows, file descriptor elsewhere
+};
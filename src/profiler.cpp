@@ -0,0 +1,293 @@
+#include "profiler.hpp"
+
+#ifdef SNAKE_PROFILE
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include <raylib.h>
+
+// time origin of every timestamp; defined before the profiler, which reads it when constructed
+static const int64_t processOrigin = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch()).count();
+
+Profiler profiler;
+
+// display names and nesting depth of each zone, in ProfileZone order
+static const char *const zoneNames[ProfileZoneCount] = {
+    "Frame", "Game::Update", "Snake::Update", "CheckCollisionWithFood", "CheckCollisionWithEdges",
+    "CheckCollisionsWithTail", "UI", "Game::Draw", "EndDrawing",
+};
+static const int zoneDepth[ProfileZoneCount] = {0, 1, 2, 2, 2, 2, 1, 2, 1};
+static const char *const latencyNames[LatencyMetricCount] = {"input -> tick", "input -> photon"};
+
+/**
+ * Profiler::Profiler
+ * ============================
+ * Objective:
+ *   Start the first frame now.
+ */
+Profiler::Profiler()
+{
+    frameStart = Now();
+}
+
+/**
+ * Profiler::Now
+ * ============================
+ * Objective:
+ *   Monotonic time in nanoseconds since the program started.
+ */
+int64_t Profiler::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count() - processOrigin;
+}
+
+/**
+ * Profiler::Record
+ * ============================
+ * Objective:
+ *   Add one interval of `zone` to the current frame and, while capturing, to the trace.
+ *
+ * Side Effects:
+ *   - None on the heap: trace storage is reserved by StartCapture and events past
+ *     its capacity are dropped.
+ */
+void Profiler::Record(ProfileZone zone, int64_t start, int64_t end)
+{
+    frameTotal[zone] += end - start;
+    frameCalls[zone]++;
+    if (captureLeft > 0 && trace.size() < trace.capacity())
+        trace.push_back(TraceEvent{start, end - start, zone});
+}
+
+/**
+ * Profiler::EndFrame
+ * ============================
+ * Objective:
+ *   Close the frame: record the Frame zone, move every zone's total into the
+ *   history and reset the per-frame counters.
+ *
+ * Side Effects:
+ *   - Writes the trace file when the capture has reached captureFrames frames.
+ */
+void Profiler::EndFrame()
+{
+    int64_t now = Now();
+    Record(ProfileFrame, frameStart, now);
+    frameStart = now;
+
+    const int slot = frameCount % historyFrames;
+    for (int zone = 0; zone < ProfileZoneCount; zone++)
+    {
+        history[zone][slot] = (float)(frameTotal[zone] / 1e6);
+        lastCalls[zone] = frameCalls[zone];
+        frameTotal[zone] = 0;
+        frameCalls[zone] = 0;
+    }
+    frameCount++;
+
+    if (captureLeft > 0 && --captureLeft == 0)
+    {
+        if (WriteTrace())
+            TraceLog(LOG_INFO, "PROFILE: wrote %zu events to %s", trace.size(), tracePath);
+        else
+            TraceLog(LOG_WARNING, "PROFILE: could not write %s", tracePath);
+        trace.clear();
+    }
+}
+
+/**
+ * Profiler::Stats
+ * ============================
+ * Objective:
+ *   Summarise the history of one zone.
+ *
+ * Approach:
+ *   The p99 is the element at rank 0.99 * n of the frames recorded so far, found
+ *   with nth_element on a stack copy, so the overlay never allocates.
+ */
+ZoneStats Profiler::Stats(ProfileZone zone) const
+{
+    ZoneStats stats = {0, 0, 0, lastCalls[zone]};
+    const int count = std::min(frameCount, historyFrames);
+    if (count == 0)
+        return stats;
+
+    float sorted[historyFrames];
+    double sum = 0;
+    for (int i = 0; i < count; i++)
+    {
+        sorted[i] = history[zone][i];
+        sum += sorted[i];
+    }
+    int rank = (int)(0.99 * (count - 1));
+    std::nth_element(sorted, sorted + rank, sorted + count);
+
+    stats.lastMs = history[zone][(frameCount - 1) % historyFrames];
+    stats.averageMs = sum / count;
+    stats.p99Ms = sorted[rank];
+    return stats;
+}
+
+/**
+ * Profiler::RecordLatency
+ * ============================
+ * Objective:
+ *   Keep one latency sample; the oldest of latencySamples is overwritten.
+ */
+void Profiler::RecordLatency(LatencyMetric metric, int64_t nanoseconds)
+{
+    latency[metric][latencyCount[metric] % latencySamples] = (float)(nanoseconds / 1e6);
+    latencyCount[metric]++;
+}
+
+/**
+ * Profiler::LatencyStats
+ * ============================
+ * Objective:
+ *   Summarise the samples of one latency metric the way Stats() does a zone's
+ *   frames. Latencies are per turn, not per frame, so frames without a turn do not
+ *   dilute the average.
+ */
+ZoneStats Profiler::LatencyStats(LatencyMetric metric) const
+{
+    const int count = std::min(latencyCount[metric], latencySamples);
+    ZoneStats stats = {0, 0, 0, count};
+    if (count == 0)
+        return stats;
+
+    float sorted[latencySamples];
+    double sum = 0;
+    for (int i = 0; i < count; i++)
+    {
+        sorted[i] = latency[metric][i];
+        sum += sorted[i];
+    }
+    int rank = (int)(0.99 * (count - 1));
+    std::nth_element(sorted, sorted + rank, sorted + count);
+
+    stats.lastMs = latency[metric][(latencyCount[metric] - 1) % latencySamples];
+    stats.averageMs = sum / count;
+    stats.p99Ms = sorted[rank];
+    return stats;
+}
+
+/**
+ * Profiler::StartCapture
+ * ============================
+ * Objective:
+ *   Begin recording scopes for the next captureFrames frames; ignored while a
+ *   capture is already running. `path` must outlive the capture (a literal).
+ */
+void Profiler::StartCapture(const char *path)
+{
+    if (captureLeft > 0)
+        return;
+    trace.clear();
+    trace.reserve(maxTraceEvents);
+    tracePath = path;
+    captureLeft = captureFrames;
+    TraceLog(LOG_INFO, "PROFILE: capturing %i frames", captureFrames);
+}
+
+/**
+ * Profiler::WriteTrace
+ * ============================
+ * Objective:
+ *   Write the captured events in the Chrome trace event format.
+ *
+ * Return Value:
+ *   - bool → false when the file could not be written.
+ *
+ * Approach:
+ *   Every scope is a complete ("X") event on one thread; timestamps are in
+ *   microseconds, as the format requires.
+ */
+bool Profiler::WriteTrace() const
+{
+    FILE *file = fopen(tracePath, "w");
+    if (!file)
+        return false;
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        const TraceEvent &event = trace[i];
+        fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+                zoneNames[event.zone], event.start / 1e3, event.duration / 1e3, i + 1 < trace.size() ? "," : "");
+    }
+    fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+    return fclose(file) == 0;
+}
+
+/**
+ * Profiler::DrawOverlay
+ * ============================
+ * Objective:
+ *   Draw one row per zone (average, p99 and calls last frame), one per input
+ *   latency (average, p99 and samples), and a bar graph of the recent frame times
+ *   with 16.7 ms and 33.3 ms guides.
+ *
+ * Side Effects:
+ *   - Requires an active BeginDrawing/EndDrawing block.
+ */
+void Profiler::DrawOverlay(int x, int y) const
+{
+    const int rowHeight = 20;
+    const int width = 2 * historyFrames + 20; // two pixels per graphed frame
+    const int graphHeight = 100;              // 33.3 ms at full height
+    const int height = rowHeight * (ProfileZoneCount + LatencyMetricCount + 2) + graphHeight + 20;
+    DrawRectangle(x, y, width, height, Fade(BLACK, 0.75f));
+
+    int row = y + 10;
+    const int averageX = x + 250; // value columns
+    const int p99X = x + 330;
+    const int callsX = x + 410;
+    DrawText("zone", x + 10, row, 10, LIGHTGRAY);
+    DrawText("avg ms", averageX, row, 10, LIGHTGRAY);
+    DrawText("p99 ms", p99X, row, 10, LIGHTGRAY);
+    DrawText("calls", callsX, row, 10, LIGHTGRAY);
+    row += rowHeight;
+    for (int zone = 0; zone < ProfileZoneCount; zone++)
+    {
+        ZoneStats stats = Stats((ProfileZone)zone);
+        int indent = 10 + 12 * zoneDepth[zone];
+        DrawText(zoneNames[zone], x + indent, row, 10, RAYWHITE);
+        DrawText(TextFormat("%.2f", stats.averageMs), averageX, row, 10, RAYWHITE);
+        DrawText(TextFormat("%.2f", stats.p99Ms), p99X, row, 10, RAYWHITE);
+        DrawText(TextFormat("%i", stats.calls), callsX, row, 10, RAYWHITE);
+        row += rowHeight;
+    }
+    for (int metric = 0; metric < LatencyMetricCount; metric++)
+    {
+        ZoneStats stats = LatencyStats((LatencyMetric)metric);
+        DrawText(latencyNames[metric], x + 10, row, 10, SKYBLUE);
+        DrawText(TextFormat("%.2f", stats.averageMs), averageX, row, 10, SKYBLUE);
+        DrawText(TextFormat("%.2f", stats.p99Ms), p99X, row, 10, SKYBLUE);
+        DrawText(TextFormat("%i", stats.calls), callsX, row, 10, SKYBLUE);
+        row += rowHeight;
+    }
+    if (Capturing())
+        DrawText(TextFormat("capturing trace: %i frames left", captureLeft), x + 10, row, 10, ORANGE);
+    row += rowHeight;
+
+    // frame graph, oldest frame on the left
+    const int graphTop = row;
+    const float pixelsPerMs = graphHeight / 33.3f;
+    const int count = std::min(frameCount, historyFrames);
+    for (int i = 0; i < count; i++)
+    {
+        int frame = frameCount - count + i;
+        float ms = history[ProfileFrame][frame % historyFrames];
+        int bar = std::min(graphHeight, (int)(ms * pixelsPerMs));
+        Color color = ms > 33.3f ? RED : (ms > 16.7f ? ORANGE : LIME);
+        DrawRectangle(x + 10 + 2 * i, graphTop + graphHeight - bar, 2, bar, color);
+    }
+    DrawLine(x + 10, graphTop + graphHeight - (int)(16.7f * pixelsPerMs), x + width - 10,
+             graphTop + graphHeight - (int)(16.7f * pixelsPerMs), GRAY);
+    DrawLine(x + 10, graphTop, x + width - 10, graphTop, GRAY);
+}
+
+#endif
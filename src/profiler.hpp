@@ -0,0 +1,157 @@
+#pragma once
+
+/**
+ * =============================
+ * Profiler Overview
+ * =============================
+ * Frame-time instrumentation for the game. Named zones are timed with scoped
+ * timers, summed per frame, kept for the last historyFrames frames and shown
+ * as an overlay with the rolling average, p99 and a frame-time graph. On request
+ * the next captureFrames frames are also written as a Chrome trace
+ * (chrome://tracing or https://ui.perfetto.dev) with one event per timed scope.
+ *
+ * Everything is compiled in only when **SNAKE_PROFILE** is defined (the game's
+ * Debug configuration, or `premake5 --profile` for Release). Otherwise
+ * PROFILE_SCOPE expands to nothing and the Profiler class does not exist, so
+ * neither the game nor the headless simulation pays anything.
+ * In the game, F3 toggles the overlay and F4 starts a trace capture.
+ *
+ * Zone times are inclusive: a zone nested in another (the collision checks inside
+ * Game::Update, Game::Draw inside UI) is counted in both. The timing uses
+ * steady_clock; scopes never allocate, so ticks stay allocation free.
+ *
+ * =============================
+ * Profiler (public API)
+ * =============================
+ * **PROFILE_SCOPE(zone)**
+ *   - Objective: time the rest of the enclosing block as `zone`.
+ *
+ * **void Record(ProfileZone zone, int64_t start, int64_t end)**
+ *   - Objective: add one timed interval (nanoseconds from Now()) to the frame.
+ *
+ * **void EndFrame()**
+ *   - Objective: close the frame: store its zone totals and the frame time, and
+ *                write the trace once a capture has collected its frames.
+ *
+ * **ZoneStats Stats(ProfileZone zone) const**
+ *   - Return: last, average and p99 per-frame milliseconds, and calls last frame.
+ *
+ * **void RecordLatency(LatencyMetric metric, int64_t nanoseconds) / ZoneStats LatencyStats(LatencyMetric metric) const**
+ *   - Objective: add one input latency sample / summarise the last latencySamples
+ *                of them (`calls` is then the number of samples held).
+ *
+ * **void StartCapture(const char *path)**
+ *   - Objective: record the next captureFrames frames into a trace file at `path`.
+ *
+ * **void DrawOverlay(int x, int y) const**
+ *   - Objective: draw the stats table, the input latencies and the frame graph
+ *                (inside BeginDrawing).
+ */
+
+enum ProfileZone
+{
+    ProfileFrame,        ///< whole frame, EndFrame to EndFrame
+    ProfileGameUpdate,   ///< Game::Update, one simulation tick
+    ProfileSnakeUpdate,  ///< Snake::Update
+    ProfileFoodCheck,    ///< Simulation::CheckCollisionWithFood
+    ProfileEdgeCheck,    ///< Simulation::CheckCollisionWithEdges
+    ProfileTailCheck,    ///< Simulation::CheckCollisionsWithTail
+    ProfileUi,           ///< screen layers, buttons and text in main()
+    ProfileGameDraw,     ///< Game::Draw
+    ProfilePresent,      ///< EndDrawing: buffer swap and frame pacing
+    ProfileZoneCount,
+};
+
+enum LatencyMetric
+{
+    LatencyInputToTick,   ///< key read until the tick that applied the turn
+    LatencyInputToPhoton, ///< key read until EndDrawing returned on the first frame showing it
+    LatencyMetricCount,
+};
+
+#ifdef SNAKE_PROFILE
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(zone) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(zone)
+
+struct ZoneStats
+{
+    double lastMs;    ///< total of the most recent frame
+    double averageMs; ///< mean over the history
+    double p99Ms;     ///< 99th percentile over the history
+    int calls;        ///< scopes recorded in the most recent frame
+};
+
+class Profiler
+{
+public:
+    static constexpr int historyFrames = 240; // four seconds at 60 FPS
+    static constexpr int captureFrames = 300;
+    static constexpr size_t maxTraceEvents = 1 << 16;
+    static constexpr int latencySamples = 128; // turns remembered per latency metric
+
+    bool visible = false; // overlay toggled by the game
+
+    Profiler();
+    static int64_t Now();
+    void Record(ProfileZone zone, int64_t start, int64_t end);
+    void EndFrame();
+    ZoneStats Stats(ProfileZone zone) const;
+    void RecordLatency(LatencyMetric metric, int64_t nanoseconds);
+    ZoneStats LatencyStats(LatencyMetric metric) const;
+    void StartCapture(const char *path);
+    bool Capturing() const { return captureLeft > 0; }
+    void DrawOverlay(int x, int y) const;
+
+private:
+    struct TraceEvent
+    {
+        int64_t start; // ns since program start
+        int64_t duration;
+        ProfileZone zone;
+    };
+
+    bool WriteTrace() const;
+
+    int64_t frameStart;                             // Now() at the previous EndFrame
+    int64_t frameTotal[ProfileZoneCount] = {};      // current frame, ns per zone
+    int frameCalls[ProfileZoneCount] = {};          // current frame, scopes per zone
+    int lastCalls[ProfileZoneCount] = {};           // calls of the most recent complete frame
+    float history[ProfileZoneCount][historyFrames] = {}; // ms per zone, ring over frames
+    int frameCount = 0;                             // frames ended so far
+    float latency[LatencyMetricCount][latencySamples] = {}; // ms per sample, ring
+    int latencyCount[LatencyMetricCount] = {};      // samples recorded so far per metric
+    std::vector<TraceEvent> trace;                  // capacity reserved before capture
+    int captureLeft = 0;                            // frames still to capture
+    const char *tracePath = nullptr;
+};
+
+extern Profiler profiler; // the game's instance
+
+/*
+ * ProfileScope
+ * Objective: RAII timer behind PROFILE_SCOPE; records its zone when destroyed.
+ */
+class ProfileScope
+{
+public:
+    explicit ProfileScope(ProfileZone timed) : zone(timed), start(Profiler::Now()) {}
+    ~ProfileScope() { profiler.Record(zone, start, Profiler::Now()); }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    ProfileZone zone;
+    int64_t start;
+};
+
+#else
+
+#define PROFILE_SCOPE(zone) ((void)0)
+
+#endif
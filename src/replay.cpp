@@ -0,0 +1,225 @@
+#include "replay.hpp"
+
+#include <cstdio>
+
+static const Cell replayDirections[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}; // right, down, left, up
+
+/*
+ * DirectionCode
+ * Objective: 2-bit code of a unit direction (index into replayDirections).
+ */
+static int DirectionCode(Cell direction)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        if (replayDirections[i] == direction)
+            return i;
+    }
+    return 0; // not a unit step; never produced by the game
+}
+
+/*
+ * WriteVarint / ReadVarint
+ * Objective: LEB128 unsigned integers (7 bits per byte, high bit = more bytes follow).
+ * Return value: ReadVarint returns false on end of file or an over-long encoding.
+ */
+static void WriteVarint(std::vector<uint8_t> &out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+static bool ReadVarint(const std::vector<uint8_t> &in, size_t &pos, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (pos >= in.size())
+            return false;
+        uint8_t byte = in[pos++];
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Replay::Begin
+ * ============================
+ * Objective:
+ *   Clear the replay and start recording a session on a fresh Simulation built
+ *   with the same board size and seed.
+ */
+void Replay::Begin(int size, uint64_t rngSeed)
+{
+    boardSize = size;
+    seed = rngSeed;
+    tickCount = 0;
+    turns.clear();
+}
+
+/**
+ * Replay::Record
+ * ============================
+ * Objective:
+ *   Log the direction about to be passed to Simulation::Step. Call before the step.
+ *
+ * Input:
+ *   - const Simulation &sim → the recorded simulation, still in its pre-step state.
+ *   - Cell direction → direction given to this tick's Step().
+ *
+ * Approach:
+ *   Only ticks whose direction differs from the snake's current heading are stored.
+ *   Comparing against the simulation rather than the previous turn also covers the
+ *   reset to "facing right" after each round, so a replay needs no round markers.
+ */
+void Replay::Record(const Simulation &sim, Cell direction)
+{
+    if (direction != sim.snake.direction)
+    {
+        turns.push_back(ReplayTurn{tickCount, direction});
+    }
+    tickCount++;
+}
+
+/**
+ * Replay::Encode
+ * ============================
+ * Objective:
+ *   Produce the file contents (format in replay.hpp) without touching the disk.
+ */
+void Replay::Encode(std::vector<uint8_t> &out) const
+{
+    out.assign({'S', 'N', 'K', 'R', 1});
+    out.push_back((uint8_t)(boardSize & 0xff));
+    out.push_back((uint8_t)(boardSize >> 8));
+    for (int i = 0; i < 8; i++)
+        out.push_back((uint8_t)(seed >> (8 * i)));
+    WriteVarint(out, tickCount);
+    WriteVarint(out, turns.size());
+
+    uint32_t previousTick = 0;
+    for (const ReplayTurn &turn : turns)
+    {
+        WriteVarint(out, ((uint64_t)(turn.tick - previousTick) << 2) | DirectionCode(turn.direction));
+        previousTick = turn.tick;
+    }
+}
+
+/**
+ * Replay::Save
+ * ============================
+ * Objective:
+ *   Encode the replay and write it to `path` in one call.
+ *
+ * Return Value:
+ *   - bool → false when the file cannot be written.
+ */
+bool Replay::Save(const char *path) const
+{
+    std::vector<uint8_t> out;
+    Encode(out);
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return false;
+    bool ok = fwrite(out.data(), 1, out.size(), file) == out.size();
+    ok = fclose(file) == 0 && ok;
+    return ok;
+}
+
+/**
+ * Replay::Load
+ * ============================
+ * Objective:
+ *   Read and validate a replay written by Save().
+ *
+ * Return Value:
+ *   - bool → false on I/O errors, bad magic/version or truncated data.
+ */
+bool Replay::Load(const char *path)
+{
+    Begin(0, 0);
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return false;
+    std::vector<uint8_t> in;
+    uint8_t buffer[4096];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        in.insert(in.end(), buffer, buffer + got);
+    fclose(file);
+
+    if (in.size() < 15 || in[0] != 'S' || in[1] != 'N' || in[2] != 'K' || in[3] != 'R' || in[4] != 1)
+        return false;
+    int size = in[5] | (in[6] << 8);
+    uint64_t rngSeed = 0;
+    for (int i = 0; i < 8; i++)
+        rngSeed |= (uint64_t)in[7 + i] << (8 * i);
+
+    size_t pos = 15;
+    uint64_t ticks, count;
+    if (!ReadVarint(in, pos, ticks) || !ReadVarint(in, pos, count) || count > ticks)
+        return false;
+
+    std::vector<ReplayTurn> loaded;
+    loaded.reserve(count);
+    uint64_t tick = 0;
+    for (uint64_t i = 0; i < count; i++)
+    {
+        uint64_t packed;
+        if (!ReadVarint(in, pos, packed))
+            return false;
+        tick += packed >> 2;
+        if (tick >= ticks)
+            return false;
+        loaded.push_back(ReplayTurn{(uint32_t)tick, replayDirections[packed & 3]});
+    }
+
+    boardSize = size;
+    seed = rngSeed;
+    tickCount = (uint32_t)ticks;
+    turns.swap(loaded);
+    return true;
+}
+
+/**
+ * Replay::Play
+ * ============================
+ * Objective:
+ *   Re-run the recorded session on a fresh Simulation with no rendering or timing,
+ *   applying each turn on its tick.
+ *
+ * Return Value:
+ *   - ReplayResult → ticks, finished rounds and scores of the re-run.
+ */
+ReplayResult Replay::Play() const
+{
+    ReplayResult result = {0, 0, 0, 0, 0};
+    if (boardSize <= 0)
+        return result;
+
+    Simulation sim(boardSize, seed);
+    size_t next = 0;
+    for (uint32_t tick = 0; tick < tickCount; tick++)
+    {
+        Cell direction = sim.snake.direction; // unchanged heading unless a turn is due
+        if (next < turns.size() && turns[next].tick == tick)
+            direction = turns[next++].direction;
+        TickEvents events = sim.Step(direction);
+        if (events.RoundOver())
+        {
+            result.rounds++;
+            result.totalScore += sim.lastScore;
+            if (sim.lastScore > result.bestScore)
+                result.bestScore = sim.lastScore;
+        }
+    }
+    result.ticks = tickCount;
+    result.finalScore = sim.score;
+    return result;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "simulation.hpp"
+
+/**
+ * =============================
+ * Replay Overview
+ * =============================
+ * A replay is everything needed to re-run a session bit for bit: the board size,
+ * the Simulation seed, the number of ticks played and the ticks on which the
+ * direction changed. Given those, Simulation reproduces every fruit, score and
+ * death, so a replay is a few bytes per turn instead of a video.
+ *
+ * =============================
+ * File format (little endian)
+ * =============================
+ *   offset  size  field
+ *   0       4     magic "SNKR"
+ *   4       1     version (1)
+ *   5       2     board size
+ *   7       8     seed
+ *   15      var   tick count (LEB128 varint)
+ *   ..      var   turn count (varint)
+ *   ..      var   turns: varint((tickDelta << 2) | direction)
+ *
+ * tickDelta is the tick of the turn minus the tick of the previous turn (the first
+ * turn counts from tick 0); direction is 0 right, 1 down, 2 left, 3 up. A turn at
+ * tick t is the direction passed to the t-th Step() call of the session.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **void Begin(int boardSize, uint64_t seed)**
+ *   - Objective: start recording a new session.
+ *
+ * **void Record(const Simulation &sim, Cell direction)**
+ *   - Objective: note the direction about to be passed to sim.Step(); only ticks that
+ *                change the heading are kept.
+ *
+ * **void Encode(std::vector<uint8_t> &out)**
+ *   - Objective: the bytes Save() would write, for writing them elsewhere (another thread).
+ *
+ * **bool Save(const char *path) / bool Load(const char *path)**
+ *   - Objective: write/read the binary format above. Return false on I/O or format
+ *                errors (Load leaves the replay empty in that case).
+ *
+ * **ReplayResult Play()**
+ *   - Objective: run the whole replay headless as fast as possible.
+ */
+
+struct ReplayTurn
+{
+    uint32_t tick;  ///< tick index the direction applies to
+    Cell direction; ///< unit step
+};
+
+struct ReplayResult
+{
+    uint32_t ticks;         ///< ticks simulated
+    int rounds;             ///< rounds that ended (death or full board)
+    int bestScore;          ///< highest round score
+    long long totalScore;   ///< sum of finished round scores
+    int finalScore;         ///< score of the round still in progress at the end
+};
+
+class Replay
+{
+public:
+    int boardSize = 0;
+    uint64_t seed = 0;
+    uint32_t tickCount = 0;          // ticks recorded so far
+    std::vector<ReplayTurn> turns;   // direction changes, in tick order
+
+    void Begin(int size, uint64_t rngSeed);
+    void Record(const Simulation &sim, Cell direction);
+    void Encode(std::vector<uint8_t> &out) const;
+    bool Save(const char *path) const;
+    bool Load(const char *path);
+    ReplayResult Play() const;
+};
@@ -0,0 +1,212 @@
+#include "resource_cache.hpp"
+
+#include "assets.hpp"
+
+/**
+ * ResourceCache::~ResourceCache
+ * ============================
+ * Objective:
+ *   Unload whatever is still resident. Entries left here mean a handle outlived
+ *   the cache, which is a bug; they are reported and freed anyway.
+ */
+ResourceCache::~ResourceCache()
+{
+    for (Entry<Texture2D> &entry : textures)
+    {
+        if (entry.key.empty())
+            continue;
+        TraceLog(LOG_WARNING, "CACHE: texture %s still has %i handle(s) at shutdown", entry.key.c_str(), entry.references);
+        UnloadTexture(entry.value);
+    }
+    for (Entry<AudioClip> &entry : sounds)
+    {
+        if (entry.key.empty())
+            continue;
+        TraceLog(LOG_WARNING, "CACHE: sound %s still has %i handle(s) at shutdown", entry.key.c_str(), entry.references);
+        UnloadAudioClip(entry.value);
+    }
+}
+
+/**
+ * ResourceCache::Find
+ * ============================
+ * Objective:
+ *   New reference to the entry with `key`, or an empty handle when it is not resident.
+ */
+template <typename T>
+ResourceHandle<T> ResourceCache::Find(std::vector<Entry<T>> &entries, std::unordered_map<std::string, int> &index,
+                                      const char *key)
+{
+    auto found = index.find(key);
+    if (found == index.end())
+        return ResourceHandle<T>();
+    entries[found->second].references++;
+    return ResourceHandle<T>(this, found->second);
+}
+
+/**
+ * ResourceCache::Adopt
+ * ============================
+ * Objective:
+ *   Take ownership of `value` under `key`, or share the resident entry.
+ *
+ * Return Value:
+ *   - ResourceHandle<T> → first reference to the new entry, or another reference
+ *                         to the resident one (the caller's copy is then unloaded).
+ *
+ * Approach:
+ *   Freed slots are reused before the vector grows, so slot indices held by
+ *   handles stay valid for the lifetime of their entry.
+ */
+template <typename T>
+ResourceHandle<T> ResourceCache::Adopt(std::vector<Entry<T>> &entries, std::unordered_map<std::string, int> &index,
+                                       const char *key, T value)
+{
+    ResourceHandle<T> existing = Find(entries, index, key);
+    if (existing)
+    {
+        TraceLog(LOG_WARNING, "CACHE: %s loaded twice; keeping the first copy", key);
+        Release(value);
+        return existing;
+    }
+
+    int slot = (int)entries.size();
+    for (int i = 0; i < (int)entries.size(); i++)
+    {
+        if (entries[i].key.empty())
+        {
+            slot = i;
+            break;
+        }
+    }
+    if (slot == (int)entries.size())
+        entries.push_back(Entry<T>{});
+    entries[slot] = Entry<T>{key, value, 1};
+    index[key] = slot;
+    return ResourceHandle<T>(this, slot);
+}
+
+/**
+ * ResourceCache::LoadTexture
+ * ============================
+ * Objective:
+ *   Shared texture for `path` drawn at `scale`; the file is read only the first time.
+ */
+TextureHandle ResourceCache::LoadTexture(const char *path, float scale, const AssetBundle *bundle)
+{
+    char key[packNameLength];
+    AssetKey(key, sizeof(key), path, scale);
+    TextureHandle handle = FindTexture(key);
+    if (handle)
+        return handle;
+    return AdoptTexture(key, LoadTextureAsset(bundle, path, scale));
+}
+
+TextureHandle ResourceCache::AdoptTexture(const char *key, Texture2D texture)
+{
+    return Adopt(textures, textureIndex, key, texture);
+}
+
+SoundHandle ResourceCache::AdoptSound(const char *key, AudioClip sound)
+{
+    return Adopt(sounds, soundIndex, key, sound);
+}
+
+TextureHandle ResourceCache::FindTexture(const char *key)
+{
+    return Find(textures, textureIndex, key);
+}
+
+SoundHandle ResourceCache::FindSound(const char *key)
+{
+    return Find(sounds, soundIndex, key);
+}
+
+/**
+ * ResourceCache::Release
+ * ============================
+ * Objective:
+ *   Drop one reference held by `handle` and unload the asset with the last one.
+ *   The overloads taking a bare value unload a duplicate that was never adopted.
+ */
+void ResourceCache::Release(TextureHandle &handle)
+{
+    Entry<Texture2D> &entry = textures[handle.slot];
+    if (--entry.references == 0)
+    {
+        UnloadTexture(entry.value);
+        textureIndex.erase(entry.key);
+        entry = Entry<Texture2D>{};
+    }
+    handle.cache = nullptr;
+    handle.slot = -1;
+}
+
+void ResourceCache::Release(SoundHandle &handle)
+{
+    Entry<AudioClip> &entry = sounds[handle.slot];
+    if (--entry.references == 0)
+    {
+        UnloadAudioClip(entry.value);
+        soundIndex.erase(entry.key);
+        entry = Entry<AudioClip>{};
+    }
+    handle.cache = nullptr;
+    handle.slot = -1;
+}
+
+void ResourceCache::Release(Texture2D texture)
+{
+    UnloadTexture(texture);
+}
+
+void ResourceCache::Release(AudioClip sound)
+{
+    UnloadAudioClip(sound);
+}
+
+/**
+ * ResourceCache::Usage
+ * ============================
+ * Objective:
+ *   Count resident entries and estimate the memory behind them.
+ *
+ * Approach:
+ *   Textures: GetPixelDataSize of the base level, plus a third for a full mip
+ *   chain. Sounds: frames x channels x 4 bytes of float PCM.
+ */
+ResourceUsage ResourceCache::Usage() const
+{
+    ResourceUsage usage = {0, 0, 0, 0};
+    for (const Entry<Texture2D> &entry : textures)
+    {
+        if (entry.key.empty())
+            continue;
+        size_t bytes = (size_t)GetPixelDataSize(entry.value.width, entry.value.height, entry.value.format);
+        if (entry.value.mipmaps > 1)
+            bytes += bytes / 3;
+        usage.textures++;
+        usage.textureBytes += bytes;
+    }
+    for (const Entry<AudioClip> &entry : sounds)
+    {
+        if (entry.key.empty())
+            continue;
+        usage.sounds++;
+        usage.soundBytes += (size_t)entry.value.frameCount * mixerChannels * sizeof(float);
+    }
+    return usage;
+}
+
+/**
+ * ResourceCache::LogUsage
+ * ============================
+ * Objective:
+ *   Print the Usage() figures through raylib's log.
+ */
+void ResourceCache::LogUsage() const
+{
+    ResourceUsage usage = Usage();
+    TraceLog(LOG_INFO, "CACHE: %i textures (%.1f KiB VRAM), %i sounds (%.1f KiB audio RAM)",
+             usage.textures, usage.textureBytes / 1024.0, usage.sounds, usage.soundBytes / 1024.0);
+}
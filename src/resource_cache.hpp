@@ -0,0 +1,161 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <raylib.h>
+
+#include "assets.hpp" // AudioClip
+
+class AssetBundle;
+class ResourceCache;
+
+/**
+ * =============================
+ * Resource Cache Overview
+ * =============================
+ * Every file-backed texture and sound lives in one ResourceCache, keyed by the
+ * same name the asset pack uses (the path, plus "@scale" for pre-scaled images;
+ * see AssetKey). Asking for a key that is already resident shares the loaded
+ * copy instead of loading the file again, so extra skins or fruit types that
+ * reuse an image cost no additional GPU memory.
+ *
+ * Owners hold a **ResourceHandle**: move-only, one reference per handle. When the
+ * last handle for an entry goes away the texture/sound is unloaded immediately.
+ * Because handles cannot be copied, an object that holds one (Button, Game)
+ * cannot be copied by accident and unload the same texture twice.
+ *
+ * Sounds are AudioClips (mixer-format PCM in main memory, see AudioMixer). The
+ * cache must outlive every handle it hands out, and a mixer playing a clip must
+ * be closed before the clip's last handle is released.
+ *
+ * =============================
+ * ResourceCache (public API)
+ * =============================
+ * **TextureHandle LoadTexture(const char *path, float scale, const AssetBundle *bundle)**
+ *   - Objective: shared texture of `path` at `scale`; loaded (synchronously) only
+ *                when not resident.
+ *
+ * **TextureHandle AdoptTexture(const char *key, Texture2D texture)**
+ * **SoundHandle AdoptSound(const char *key, AudioClip sound)**
+ *   - Objective: register an asset loaded elsewhere (AsyncLoader). If the key is
+ *                already resident, the new copy is unloaded and the resident one shared.
+ *
+ * **TextureHandle FindTexture(const char *key) / SoundHandle FindSound(const char *key)**
+ *   - Return: a new reference to a resident entry, or an empty handle.
+ *
+ * **ResourceUsage Usage() const / void LogUsage() const**
+ *   - Objective: entry counts and an estimate of GPU (textures) and audio (PCM) memory.
+ */
+
+struct ResourceUsage
+{
+    int textures;        ///< resident textures
+    size_t textureBytes; ///< their pixel data, including mip levels
+    int sounds;          ///< resident sounds
+    size_t soundBytes;   ///< their PCM in the mixer format
+};
+
+template <typename T>
+class ResourceHandle
+{
+public:
+    ResourceHandle() = default;
+    ResourceHandle(ResourceHandle &&other) noexcept : cache(other.cache), slot(other.slot)
+    {
+        other.cache = nullptr;
+        other.slot = -1;
+    }
+    ResourceHandle &operator=(ResourceHandle &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            cache = other.cache;
+            slot = other.slot;
+            other.cache = nullptr;
+            other.slot = -1;
+        }
+        return *this;
+    }
+    ResourceHandle(const ResourceHandle &) = delete;
+    ResourceHandle &operator=(const ResourceHandle &) = delete;
+    ~ResourceHandle() { Reset(); }
+
+    void Reset(); // drop this reference (unloads the asset if it was the last one)
+    const T &Get() const; // the asset, or a zeroed T for an empty handle
+    explicit operator bool() const { return cache != nullptr; }
+
+private:
+    friend class ResourceCache;
+    ResourceHandle(ResourceCache *owner, int index) : cache(owner), slot(index) {}
+
+    ResourceCache *cache = nullptr; // owning cache, null when empty
+    int slot = -1;                  // entry index inside the cache
+};
+
+typedef ResourceHandle<Texture2D> TextureHandle;
+typedef ResourceHandle<AudioClip> SoundHandle;
+
+class ResourceCache
+{
+public:
+    ResourceCache() = default;
+    ~ResourceCache();
+    ResourceCache(const ResourceCache &) = delete;
+    ResourceCache &operator=(const ResourceCache &) = delete;
+
+    TextureHandle LoadTexture(const char *path, float scale, const AssetBundle *bundle);
+    TextureHandle AdoptTexture(const char *key, Texture2D texture);
+    SoundHandle AdoptSound(const char *key, AudioClip sound);
+    TextureHandle FindTexture(const char *key);
+    SoundHandle FindSound(const char *key);
+    ResourceUsage Usage() const;
+    void LogUsage() const;
+
+private:
+    template <typename T>
+    struct Entry
+    {
+        std::string key; // empty for a free slot
+        T value;
+        int references;
+    };
+
+    template <typename T>
+    friend class ResourceHandle;
+
+    template <typename T>
+    ResourceHandle<T> Adopt(std::vector<Entry<T>> &entries, std::unordered_map<std::string, int> &index,
+                            const char *key, T value);
+    template <typename T>
+    ResourceHandle<T> Find(std::vector<Entry<T>> &entries, std::unordered_map<std::string, int> &index,
+                           const char *key);
+
+    void Release(TextureHandle &handle);
+    void Release(SoundHandle &handle);
+    void Release(Texture2D texture); // duplicates that were never adopted
+    void Release(AudioClip sound);
+    const Texture2D &Value(const TextureHandle &handle) const { return textures[handle.slot].value; }
+    const AudioClip &Value(const SoundHandle &handle) const { return sounds[handle.slot].value; }
+
+    std::vector<Entry<Texture2D>> textures;
+    std::unordered_map<std::string, int> textureIndex; // key -> slot in textures
+    std::vector<Entry<AudioClip>> sounds;
+    std::unordered_map<std::string, int> soundIndex;   // key -> slot in sounds
+};
+
+template <typename T>
+void ResourceHandle<T>::Reset()
+{
+    if (cache)
+        cache->Release(*this); // clears cache and slot
+}
+
+template <typename T>
+const T &ResourceHandle<T>::Get() const
+{
+    static const T empty = {};
+    return cache ? cache->Value(*this) : empty;
+}
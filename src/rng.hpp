@@ -0,0 +1,135 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * =============================
+ * Rng Overview
+ * =============================
+ * Small, fast, seedable pseudo-random generator (xoshiro256**) for the
+ * simulation. Unlike raylib's GetRandomValue it has no global state, so every
+ * game can own one, runs are reproducible from a seed, and many games can run
+ * on many threads at once.
+ *
+ * Independent streams: Jump() advances a generator by 2^128 steps. Copying a
+ * seeded generator and jumping it k times gives stream k, and streams never
+ * overlap in practice. The batch engine gives each game its own stream this
+ * way, so results do not depend on which thread ran which game.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **Rng(uint64_t seed)**
+ *   - Objective: expand a 64-bit seed into the 256-bit state with splitmix64.
+ *
+ * **uint64_t operator()()**
+ *   - Objective: next 64 random bits. Satisfies UniformRandomBitGenerator, so the
+ *                generator also works with <random> distributions.
+ *
+ * **uint32_t Below(uint32_t bound)**
+ *   - Objective: uniform integer in [0, bound) without modulo bias
+ *                (Lemire's multiply-shift method).
+ *
+ * **int Range(int lo, int hi)**
+ *   - Objective: uniform integer in [lo, hi], same contract as GetRandomValue.
+ *
+ * **void Jump()**
+ *   - Objective: skip 2^128 outputs to start a non-overlapping stream.
+ */
+class Rng
+{
+public:
+    typedef uint64_t result_type;
+
+    explicit Rng(uint64_t seed = 0x853c49e6748fea9bULL)
+    {
+        Seed(seed);
+    }
+
+    /*
+     * Seed
+     * Objective: reset the state from a 64-bit seed.
+     * Approach: splitmix64 spreads the seed over four words and never yields all zeros.
+     */
+    void Seed(uint64_t seed)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            state[i] = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~(result_type)0; }
+
+    result_type operator()()
+    {
+        uint64_t result = Rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = Rotl(state[3], 45);
+        return result;
+    }
+
+    uint32_t Below(uint32_t bound)
+    {
+        uint64_t m = (uint64_t)(uint32_t)((*this)() >> 32) * bound;
+        uint32_t low = (uint32_t)m;
+        if (low < bound)
+        {
+            uint32_t threshold = (uint32_t)(-bound) % bound; // rejection zone that causes bias
+            while (low < threshold)
+            {
+                m = (uint64_t)(uint32_t)((*this)() >> 32) * bound;
+                low = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+    int Range(int lo, int hi)
+    {
+        return lo + (int)Below((uint32_t)(hi - lo + 1));
+    }
+
+    /*
+     * Jump
+     * Objective: advance the generator by 2^128 calls to operator().
+     * Approach: the published xoshiro256 jump polynomial.
+     */
+    void Jump()
+    {
+        static const uint64_t jump[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                         0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        uint64_t s[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; i++)
+        {
+            for (int b = 0; b < 64; b++)
+            {
+                if (jump[i] & (1ULL << b))
+                {
+                    for (int k = 0; k < 4; k++)
+                        s[k] ^= state[k];
+                }
+                (*this)();
+            }
+        }
+        for (int k = 0; k < 4; k++)
+            state[k] = s[k];
+    }
+
+    uint64_t state[4]; ///< Generator state; exposed so snapshots can store and restore it.
+
+private:
+    static uint64_t Rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+};
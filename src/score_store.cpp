@@ -0,0 +1,215 @@
+#include "score_store.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "file_writer.hpp"
+
+static const uint8_t scoreMagic[4] = {'S', 'N', 'K', 'S'};
+static const uint8_t scoreVersion = 1;
+static const size_t fixedPayload = 1 + 2 + 4 + 8 + 1; // payload bytes before the profile name
+
+/**
+ * Crc32
+ * ============================
+ * Objective:
+ *   CRC-32 (IEEE, reflected) of a record payload. Records are a few dozen bytes
+ *   and written once per round, so the bitwise form is plenty.
+ */
+static uint32_t Crc32(const uint8_t *data, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
+
+static void PutLittle(std::vector<uint8_t> &out, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+        out.push_back((uint8_t)(value >> (8 * i)));
+}
+
+static uint64_t GetLittle(const uint8_t *in, int bytes)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++)
+        value |= (uint64_t)in[i] << (8 * i);
+    return value;
+}
+
+/**
+ * WriteRecord
+ * ============================
+ * Objective:
+ *   Append one framed record (length, CRC, payload) for `entry` to `out`.
+ */
+static void WriteRecord(std::vector<uint8_t> &out, const ScoreKey &key, const ScoreEntry &entry)
+{
+    std::vector<uint8_t> payload;
+    payload.push_back((uint8_t)key.mode);
+    PutLittle(payload, key.boardSize, 2);
+    PutLittle(payload, entry.score, 4);
+    PutLittle(payload, (uint64_t)entry.time, 8);
+    payload.push_back((uint8_t)key.profile.size());
+    payload.insert(payload.end(), key.profile.begin(), key.profile.end());
+
+    PutLittle(out, payload.size(), 2);
+    PutLittle(out, Crc32(payload.data(), payload.size()), 4);
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+/**
+ * ScoreStore::Open
+ * ============================
+ * Objective:
+ *   Rebuild the tables from the log at `path` and compact it when worthwhile.
+ *
+ * Approach:
+ *   Records are replayed through Insert() in file order, which reproduces the
+ *   tables exactly as they were. Reading stops at the first record that is cut
+ *   short, malformed or fails its CRC: only the last append can be torn, so
+ *   nothing valid follows it. The log is rewritten (via the writer, on its thread)
+ *   when it had no valid header, a damaged tail, or records that no longer made
+ *   their table; otherwise it is left alone and new records are simply appended.
+ *
+ * Variable definition and use:
+ *   records - valid records read; kept - entries in the tables afterwards
+ */
+void ScoreStore::Open(const char *path, FileWriter &writer)
+{
+    tables.clear();
+    logPath = path;
+    output = &writer;
+
+    std::vector<uint8_t> in;
+    if (FILE *file = fopen(path, "rb"))
+    {
+        uint8_t buffer[4096];
+        size_t got;
+        while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0)
+            in.insert(in.end(), buffer, buffer + got);
+        fclose(file);
+    }
+
+    const size_t headerSize = sizeof(scoreMagic) + 1;
+    bool header = in.size() >= headerSize && std::equal(scoreMagic, scoreMagic + 4, in.begin()) &&
+                  in[4] == scoreVersion;
+    size_t pos = headerSize;
+    size_t records = 0;
+    bool damaged = false;
+    while (header && pos < in.size())
+    {
+        if (in.size() - pos < 6)
+        {
+            damaged = true;
+            break;
+        }
+        size_t length = (size_t)GetLittle(&in[pos], 2);
+        uint32_t crc = (uint32_t)GetLittle(&in[pos + 2], 4);
+        const uint8_t *payload = in.data() + pos + 6;
+        if (in.size() - pos - 6 < length || length < fixedPayload || length != fixedPayload + payload[fixedPayload - 1] ||
+            Crc32(payload, length) != crc)
+        {
+            damaged = true;
+            break;
+        }
+
+        ScoreKey key;
+        key.mode = (ScoreMode)payload[0];
+        key.boardSize = (uint16_t)GetLittle(payload + 1, 2);
+        ScoreEntry entry{(uint32_t)GetLittle(payload + 3, 4), (int64_t)GetLittle(payload + 7, 8)};
+        key.profile.assign((const char *)payload + fixedPayload, length - fixedPayload);
+        Insert(key, entry);
+        records++;
+        pos += 6 + length;
+    }
+
+    size_t kept = 0;
+    for (const auto &table : tables)
+        kept += table.second.size();
+    if (header && !damaged && records == kept)
+        return;
+
+    std::vector<uint8_t> compacted(scoreMagic, scoreMagic + 4);
+    compacted.push_back(scoreVersion);
+    for (const auto &table : tables)
+        for (const ScoreEntry &entry : table.second)
+            WriteRecord(compacted, table.first, entry);
+    writer.Replace(path, std::move(compacted));
+}
+
+/**
+ * ScoreStore::Insert
+ * ============================
+ * Objective:
+ *   Place `entry` in its table, best first, and cut the table to topCount.
+ *   Equal scores rank by time, so the one set first stays ahead.
+ *
+ * Return Value:
+ *   - int → the entry's index in the table, or -1 when it did not make the table.
+ */
+int ScoreStore::Insert(const ScoreKey &key, ScoreEntry entry)
+{
+    std::vector<ScoreEntry> &table = tables[key];
+    auto before = [](const ScoreEntry &a, const ScoreEntry &b)
+    {
+        return a.score != b.score ? a.score > b.score : a.time < b.time;
+    };
+    auto at = std::upper_bound(table.begin(), table.end(), entry, before);
+    int index = at - table.begin(); // after every equal score already in the table
+    if (index >= topCount)
+        return -1;
+    table.insert(at, entry);
+    if ((int)table.size() > topCount)
+        table.pop_back();
+    return index;
+}
+
+/**
+ * ScoreStore::Submit
+ * ============================
+ * Objective:
+ *   Record a finished round. Only scores that make their table reach the log.
+ *
+ * Return Value:
+ *   - int → 1-based rank where Insert() placed it, so ties rank behind older
+ *           equal scores; 0 when it did not make the table.
+ */
+int ScoreStore::Submit(const ScoreKey &key, int score, int64_t time)
+{
+    ScoreKey stored = key;
+    if (stored.profile.size() > maxProfile)
+        stored.profile.resize(maxProfile);
+    ScoreEntry entry{(uint32_t)std::max(score, 0), time};
+    int index = score > 0 ? Insert(stored, entry) : -1;
+    if (index < 0)
+        return 0;
+    if (output)
+    {
+        std::vector<uint8_t> record;
+        WriteRecord(record, stored, entry);
+        output->Append(logPath.c_str(), std::move(record));
+    }
+    return index + 1;
+}
+
+const std::vector<ScoreEntry> &ScoreStore::Top(const ScoreKey &key) const
+{
+    static const std::vector<ScoreEntry> none;
+    ScoreKey stored = key;
+    if (stored.profile.size() > maxProfile)
+        stored.profile.resize(maxProfile);
+    auto found = tables.find(stored);
+    return found == tables.end() ? none : found->second;
+}
+
+int ScoreStore::Best(const ScoreKey &key) const
+{
+    const std::vector<ScoreEntry> &table = Top(key);
+    return table.empty() ? 0 : (int)table[0].score;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class FileWriter;
+
+/**
+ * =============================
+ * ScoreStore Overview
+ * =============================
+ * Persistent leaderboards: the best `topCount` scores, with the time they were
+ * set, for every profile, board size and game mode. The tables live in memory,
+ * so reading them never touches the disk; the file is only written through a
+ * FileWriter, off the frame.
+ *
+ * The file is an append-only log of records. A new score that makes its table is
+ * appended as one record; nothing is rewritten in place. Open() reads the log,
+ * keeps what still belongs in the tables and, when anything was dropped, queues a
+ * compacted copy that replaces the file in one rename. A crash can therefore only
+ * tear the last appended record, and every record carries a CRC-32, so loading
+ * stops at the first damaged record and everything before it survives.
+ *
+ * =============================
+ * File format (little endian)
+ * =============================
+ *   header : magic "SNKS", version u8 (1)
+ *   record : payload length u16, CRC-32 of the payload u32, payload
+ *   payload: mode u8, board u16, score u32, time i64 (Unix seconds),
+ *            profile length u8, profile bytes
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **void Open(const char *path, FileWriter &writer)**
+ *   - Objective: load the tables from `path` (a missing file is an empty table) and
+ *                remember where later scores go.
+ *
+ * **int Submit(const ScoreKey &key, int score, int64_t time)**
+ *   - Objective: enter a finished round; appends it to the log if it made the table.
+ *   - Return: its rank in the table (1 for the best), or 0 when it did not make it.
+ *
+ * **const std::vector<ScoreEntry> &Top(const ScoreKey &key) const** / **int Best(...)**
+ *   - Return: the table, best first (empty when nothing was recorded) / its best score.
+ */
+
+enum class ScoreMode : uint8_t
+{
+    Classic = 0,
+    Arena = 1,
+    Online = 2,
+};
+
+/*
+ * ScoreKey struct
+ * Objective: which leaderboard a round belongs to.
+ */
+struct ScoreKey
+{
+    std::string profile;
+    uint16_t boardSize = 0;
+    ScoreMode mode = ScoreMode::Classic;
+
+    bool operator<(const ScoreKey &other) const
+    {
+        if (mode != other.mode)
+            return mode < other.mode;
+        if (boardSize != other.boardSize)
+            return boardSize < other.boardSize;
+        return profile < other.profile;
+    }
+};
+
+struct ScoreEntry
+{
+    uint32_t score;
+    int64_t time; // Unix seconds
+};
+
+class ScoreStore
+{
+public:
+    static constexpr int topCount = 10;      // entries kept per table
+    static constexpr size_t maxProfile = 32; // longer profile names are cut
+
+    void Open(const char *path, FileWriter &writer);
+    int Submit(const ScoreKey &key, int score, int64_t time);
+    const std::vector<ScoreEntry> &Top(const ScoreKey &key) const;
+    int Best(const ScoreKey &key) const;
+
+private:
+    int Insert(const ScoreKey &key, ScoreEntry entry);
+
+    std::map<ScoreKey, std::vector<ScoreEntry>> tables;
+    std::string logPath;
+    FileWriter *output = nullptr; // null until Open()
+};
@@ -0,0 +1,363 @@
+#include "simulation.hpp"
+
+#include <random>
+
+#include "profiler.hpp"
+
+/**
+ * RandomSeed
+ * ============================
+ * Objective:
+ *   Draw a 64-bit seed from the operating system's entropy source, for sessions
+ *   that are not meant to be reproduced from a known seed.
+ */
+uint64_t RandomSeed()
+{
+    std::random_device device;
+    return ((uint64_t)device() << 32) ^ device();
+}
+
+/**
+ * Snake::Snake
+ * ============================
+ * Objective:
+ *   Size the occupancy grid and the body ring for the board and place the
+ *   initial body cells.
+ *
+ * Input:
+ *   - int boardSize → cells per row/column.
+ *   - std::pmr::memory_resource *memory → where the grid and ring storage come from.
+ *
+ * Side Effects:
+ *   - Allocates the grid and ring storage once per Snake.
+ */
+Snake::Snake(int boardSize, std::pmr::memory_resource *memory)
+    : body(memory), occupancy(memory)
+{
+    occupancy.Resize(boardSize);
+    body.Reserve(boardSize * boardSize + 1); // a full board plus the head overlapping on a collision
+    Reset();
+}
+
+/**
+ * Snake::Update
+ * ============================
+ * Objective:
+ *   Move the snake one cell in the current direction, and optionally grow.
+ *
+ * Output:
+ *   - Modifies the body ring and the occupancy grid.
+ *
+ * Side Effects:
+ *   - Mutates body, occupancy, hitTail, addSegment, previousTail and tailMoved.
+ *
+ * Approach:
+ *   Compute the new head as head + direction. If addSegment is true, keep the tail so the
+ *   snake grows; otherwise pop the tail and clear its cell first, so moving into the cell
+ *   the tail just left is not a collision. A single occupancy lookup on the new head then
+ *   tells whether it ran into the body, after which the head is pushed and marked.
+ *   The grid is read and written through `board` (board.hpp); Update() passes the
+ *   run-time size and Simulation::Update passes FixedBoard on the shipped board.
+ */
+void Snake::Update()
+{
+    Update(DynamicBoard(occupancy.size));
+}
+
+template <typename B>
+void Snake::Update(B board)
+{
+    PROFILE_SCOPE(ProfileSnakeUpdate);
+    Cell head = body[0] + direction; // next cell in the current direction
+
+    tailMoved = !addSegment;
+    if (addSegment)
+    {
+        addSegment = false; // growth applied; reset flag so growth happens only once per food
+    }
+    else
+    {
+        previousTail = body.back(); // kept for interpolated drawing
+        occupancy.Set(body.back(), false, board); // tail leaves its cell
+        body.pop_back(); // remove last element to keep the snake the same length
+    }
+
+    hitTail = occupancy.IsOccupied(head, board); // head landing on a covered cell is a self collision
+    body.push_front(head);
+    occupancy.Set(head, true, board);
+}
+
+template void Snake::Update(DynamicBoard board);
+#if SNAKE_FIXED_BOARD > 0
+template void Snake::Update(FixedBoard board);
+#endif
+
+/**
+ * Snake::Reset
+ * ============================
+ * Objective:
+ *   Restore the snake to its initial starting configuration.
+ *
+ * Side Effects:
+ *   - Mutates body, direction, flags and the occupancy grid.
+ *
+ * Approach:
+ *   Place a 3-segment snake facing right. On the default 25x25 board this is the
+ *   original {6,9},{5,9},{4,9}; other sizes scale the same spot, keeping the tail at
+ *   least one cell inside the left edge. The ring is filled tail first so the head
+ *   ends at index 0, then the grid is rebuilt.
+ */
+void Snake::Reset()
+{
+    int size = occupancy.size;
+    int16_t row = (int16_t)(size * 9 / 25);
+    int16_t headColumn = (int16_t)(size * 6 / 25 < 2 ? 2 : size * 6 / 25);
+
+    body.clear();
+    body.push_front(Cell{(int16_t)(headColumn - 2), row});
+    body.push_front(Cell{(int16_t)(headColumn - 1), row});
+    body.push_front(Cell{headColumn, row});
+    direction = {1, 0};
+    addSegment = false;
+    hitTail = false;
+    tailMoved = false;
+
+    occupancy.Clear();
+    for (unsigned int i = 0; i < body.size(); i++)
+        occupancy.Set(body[i], true); // mark the starting cells
+}
+
+/**
+ * Food::Food
+ * ============================
+ * Objective:
+ *   Pick a random visual and a random free position not occupied by the snake.
+ *
+ * Input:
+ *   - const Snake &snake → current snake, whose occupied cells the food must avoid.
+ *   - SimRandom &rng → the simulation's generator.
+ */
+Food::Food(const Snake &snake, SimRandom &rng)
+{
+    Respawn(snake, rng);
+}
+
+/**
+ * Food::GenerateRandomPos
+ * ============================
+ * Objective:
+ *   Pick a uniformly random cell that is not covered by the snake.
+ *
+ * Output:
+ *   - Cell &pos → receives the chosen cell when one exists.
+ *
+ * Return Value:
+ *   - bool → false when the snake covers the whole board (pos is untouched).
+ *
+ * Approach:
+ *   The snake's occupancy grid keeps a dense list of free cells, so one random
+ *   index into that list gives a free cell in O(1) no matter how full the board is.
+ */
+bool Food::GenerateRandomPos(const Snake &snake, SimRandom &rng, Cell &pos) const
+{
+    int freeCount = snake.occupancy.FreeCount();
+    if (freeCount == 0)
+        return false; // board full: nowhere to put the food
+    pos = snake.occupancy.FreeCell(RandomInt(rng, 0, freeCount - 1));
+    return true;
+}
+
+/**
+ * Food::Respawn
+ * ============================
+ * Objective:
+ *   Move the food to a new free cell with a new random visual; mark it inactive
+ *   when the board is full.
+ */
+void Food::Respawn(const Snake &snake, SimRandom &rng)
+{
+    textureIndex = RandomInt(rng, 0, textureCount - 1); // randomize appearance
+    active = GenerateRandomPos(snake, rng, position);
+}
+
+/**
+ * Simulation::Simulation
+ * ============================
+ * Objective:
+ *   Build a board of size x size cells and populate the initial fruits.
+ *
+ * Input:
+ *   - int size → cells per row/column.
+ *   - uint64_t rngSeed → seed for food placement and visuals.
+ *   - std::pmr::memory_resource *memory → source of the grid and ring storage.
+ *
+ * Side Effects:
+ *   - Allocates grid and ring storage from `memory`; fruits live inline. Later
+ *     ticks and resets reuse it.
+ */
+Simulation::Simulation(int size, uint64_t rngSeed, std::pmr::memory_resource *memory)
+    : boardSize(size), seed(rngSeed), snake(size, memory), rng(rngSeed)
+{
+    for (int i = 0; i < fruitCount; i++)
+        fruits.push_back(Food(snake, rng)); // spawn fruit avoiding current snake body
+}
+
+/**
+ * Simulation::Step
+ * ============================
+ * Objective:
+ *   Steer the snake and advance one tick. This is the entry point for bots,
+ *   benchmarks and replays; the direction is applied as given, so a reversal
+ *   runs the head into the body like it would on the board.
+ *
+ * Return Value:
+ *   - TickEvents → see Update().
+ */
+TickEvents Simulation::Step(Cell direction)
+{
+    snake.direction = direction;
+    return Update();
+}
+
+/**
+ * Simulation::Update
+ * ============================
+ * Objective:
+ *   Advance the simulation by one tick: move the snake and run collision checks.
+ *
+ * Return Value:
+ *   - TickEvents → food eaten, deaths and the win condition for this tick. If the
+ *                  round ended, the board is already reset and lastScore is set.
+ *
+ * Approach:
+ *   Same order as the original game loop: move, eat, edges, tail, then the
+ *   board-full check. A round that ended on the edge skips the later checks.
+ *   The tick itself is UpdateOn(), compiled once for FixedBoard and once for
+ *   DynamicBoard; this picks one by the board size, which never changes.
+ */
+TickEvents Simulation::Update()
+{
+#if SNAKE_FIXED_BOARD > 0
+    if (boardSize == SNAKE_FIXED_BOARD)
+        return UpdateOn(FixedBoard());
+#endif
+    return UpdateOn(DynamicBoard(boardSize));
+}
+
+template <typename B>
+TickEvents Simulation::UpdateOn(B board)
+{
+    TickEvents events;
+    snake.Update(board); // move the snake forward
+    CheckCollisionWithFood(events); // handle eating
+    CheckCollisionWithEdges(events, board); // handle boundary collision
+    if (!events.RoundOver())
+        CheckCollisionsWithTail(events); // handle self collision
+    if (!events.RoundOver())
+        CheckBoardFull(events); // handle the win condition
+    if (events.RoundOver())
+        GameOver();
+    return events;
+}
+
+/**
+ * Simulation::CheckCollisionWithFood
+ * ============================
+ * Objective:
+ *   Detect when the snake head occupies the same cell as a fruit and handle eating:
+ *   increase score, grow snake, respawn fruit and apply the speed-up rule.
+ *
+ * Approach:
+ *   Iterate over fruits; if head equals fruit.position, move the fruit to a new
+ *   valid location, mark snake to grow, increment score and optionally speed up.
+ *   A fruit that finds no free cell becomes inactive until the next round.
+ */
+void Simulation::CheckCollisionWithFood(TickEvents &events)
+{
+    PROFILE_SCOPE(ProfileFoodCheck);
+    for (auto &f : fruits)
+    {
+        if (f.active && snake.body[0] == f.position) // head equals fruit
+        {
+            f.Respawn(snake, rng); // respawn fruit
+            snake.addSegment = true; // cause growth on next update
+            score++; // increase score
+            speed = SpeedAfterFruit(speed); // slightly increase speed by reducing interval
+            events.fruitsEaten++;
+        }
+    }
+}
+
+/**
+ * Simulation::CheckCollisionWithEdges
+ * ============================
+ * Objective:
+ *   Detect when the snake head moves beyond the grid.
+ *
+ * Approach:
+ *   Compare head x/y against grid bounds [0, boardSize-1]. The head moves one cell
+ *   per tick, so it can only be one step past an edge; one unsigned compare per axis
+ *   catches both sides.
+ */
+template <typename B>
+void Simulation::CheckCollisionWithEdges(TickEvents &events, B board)
+{
+    PROFILE_SCOPE(ProfileEdgeCheck);
+    if (!board.InBounds(snake.body[0])) // beyond the right/left or the bottom/top edge
+        events.hitEdge = true;
+}
+
+/**
+ * Simulation::CheckCollisionsWithTail
+ * ============================
+ * Objective:
+ *   Detect self-collision when the head overlaps any other body segment.
+ *
+ * Approach:
+ *   Snake::Update already looked the new head up in the occupancy grid before
+ *   marking it, so the result is a single flag read instead of a scan over the body.
+ */
+void Simulation::CheckCollisionsWithTail(TickEvents &events)
+{
+    PROFILE_SCOPE(ProfileTailCheck);
+    if (snake.hitTail)
+        events.hitTail = true;
+}
+
+/**
+ * Simulation::CheckBoardFull
+ * ============================
+ * Objective:
+ *   End the round as a win once the snake covers every cell of the board.
+ *
+ * Approach:
+ *   The occupancy grid tracks the free-cell count, so the check is O(1).
+ */
+void Simulation::CheckBoardFull(TickEvents &events)
+{
+    if (snake.occupancy.FreeCount() == 0)
+        events.boardFull = true;
+}
+
+/**
+ * Simulation::GameOver
+ * ============================
+ * Objective:
+ *   Perform end-of-round tasks: record the score, reset snake, fruits and speed.
+ *
+ * Side Effects:
+ *   - Mutates every member except the generator; reuses all storage.
+ *
+ * Approach:
+ *   Fruits are respawned in place, drawing from the generator in the same order
+ *   as construction, so replays recorded before this change still match.
+ */
+void Simulation::GameOver()
+{
+    lastScore = score;
+    score = 0; // reset current score
+    speed = startSpeed; // restore initial speed
+    snake.Reset(); // reset snake to starting position
+    for (Food &f : fruits)
+        f.Respawn(snake, rng); // respawn fruits at safe positions
+}
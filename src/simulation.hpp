@@ -0,0 +1,621 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "board.hpp"
+#include "rng.hpp"
+
+/**
+ * =============================
+ * Simulation Core Overview
+ * =============================
+ * Everything the game needs to advance a round, with no window, audio or GPU
+ * dependency: grid cells, the snake body, the occupancy grid, food placement,
+ * score/speed rules and the random number generator. The raylib front end in
+ * main.cpp owns a Simulation and only draws it and plays sounds for the events
+ * a tick reports. The headless `snake_bench` target links this file alone.
+ *
+ * =============================
+ * Types
+ * =============================
+ * - **Cell**          : 4-byte integer grid coordinate, compared exactly.
+ * - **InlineVector**  : fixed-capacity vector stored inside its owner (the fruits).
+ * - **SnakeBody**     : fixed-capacity ring buffer of cells, head first.
+ * - **OccupancyGrid** : bitset plus free-cell index for O(1) lookups and spawns.
+ * - **Snake**         : body, direction and occupancy for one snake.
+ * - **Food**          : one fruit: position, visual index and active flag.
+ * - **TickEvents**    : what happened during one tick (food eaten, deaths, win).
+ * - **Simulation**    : the full round state with a Step(direction) API.
+ *
+ * =============================
+ * Simulation (public API)
+ * =============================
+ * **Simulation(int boardSize, uint64_t seed)**
+ *   - Objective: build a board of boardSize x boardSize cells and start a round.
+ *                The same seed and the same Step() directions always reproduce
+ *                the same game, which is what replays rely on.
+ *   - Side Effects: allocates all grid and body storage once; ticks never allocate.
+ *
+ * **Simulation(int boardSize, uint64_t seed, std::pmr::memory_resource *memory)**
+ *   - Objective: same, with the grid and body storage taken from `memory`, e.g. a
+ *                GameArena (game_arena.hpp) when many short games are built and
+ *                thrown away; the memory must outlive the Simulation.
+ *
+ * **TickEvents Step(Cell direction)**
+ *   - Objective: set the snake's direction and advance one tick.
+ *   - Return: the events of the tick. When RoundOver() is true the board has
+ *             already been reset for a new round and lastScore holds the score.
+ *
+ * **TickEvents Update()**
+ *   - Objective: advance one tick keeping the current direction. On a board of
+ *                SNAKE_FIXED_BOARD cells the tick runs code compiled for that size
+ *                (board.hpp); any other size runs the same code with the size read
+ *                at run time.
+ *
+ * **void GameOver()**
+ *   - Objective: end the round: store lastScore, reset snake, fruits and speed.
+ *
+ * **static double SpeedAfterFruit(double interval)**
+ *   - Return: the tick interval after one more fruit (the speed-up rule), for code
+ *             that rebuilds a round without stepping it, such as broadcast playback.
+ */
+
+typedef Rng SimRandom; ///< Seedable generator owned by each Simulation (no global state).
+
+/*
+ * RandomInt
+ * Objective: uniform integer in [lo, hi] drawn from a simulation's generator.
+ * Side effects: advances the generator
+ */
+inline int RandomInt(SimRandom &rng, int lo, int hi)
+{
+    return rng.Range(lo, hi);
+}
+
+uint64_t RandomSeed(); ///< Fresh seed from std::random_device, for interactive sessions.
+
+/*
+ * Cell struct
+ * Objective: integer grid coordinate used for every snake/food position.
+ *            Comparisons are exact, and 16-bit fields keep a body segment at 4 bytes.
+ * Member variables:
+ *  - x, y : column and row on the grid; the head may briefly sit at -1 or the board
+ *           size before the edge check ends the round.
+ * Related functions:
+ *  - operator== / operator!= : exact comparison of two cells
+ *  - operator+               : step a cell by a direction
+ */
+struct Cell
+{
+    int16_t x;
+    int16_t y;
+};
+
+inline bool operator==(Cell a, Cell b) { return a.x == b.x && a.y == b.y; }
+inline bool operator!=(Cell a, Cell b) { return !(a == b); }
+inline Cell operator+(Cell a, Cell b) { return Cell{(int16_t)(a.x + b.x), (int16_t)(a.y + b.y)}; }
+
+/*
+ * InlineVector class
+ * Objective: vector of at most N elements stored inline, so an object owning one
+ *            needs no heap block for it and clear() / push_back() are plain stores.
+ * Member variables:
+ *  - items : the N slots; only the first count hold live elements.
+ *  - count : number of elements.
+ * Member functions:
+ *  - push_back() : append; the caller guarantees size() < N.
+ *  - clear(), size(), empty(), operator[], begin()/end(), data() : as std::vector.
+ */
+template <typename T, size_t N>
+class InlineVector
+{
+public:
+    static constexpr size_t capacity = N;
+
+    void push_back(const T &item) { items[count++] = item; }
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    T &operator[](size_t i) { return items[i]; }
+    const T &operator[](size_t i) const { return items[i]; }
+    T *data() { return items; }
+    const T *data() const { return items; }
+    T *begin() { return items; }
+    T *end() { return items + count; }
+    const T *begin() const { return items; }
+    const T *end() const { return items + count; }
+
+private:
+    T items[N] = {};
+    size_t count = 0;
+};
+
+/*
+ * ElementInDeque
+ * Objective: Check whether a given cell exists within a sequence of cells (the snake's
+ *            ring-buffer body or a std::deque<Cell>).
+ *            Linear reference scan; the game itself uses Snake's occupancy grid.
+ * Input: Cell element - the cell to search for
+ *        const Container &cells - the container to search in (borrowed, never copied);
+ *                                 needs size() and operator[]
+ *        bool skipHead - when true the first element is ignored, e.g. to test the head
+ *                        against the rest of the body without building a headless copy
+ * Output: none
+ * Return value: bool - true if the element exists in the container, false otherwise
+ * Side effects: none (pure query)
+ *
+ * Approach:
+ * Iterate through all elements of the container and compare each with the target
+ * using the exact integer comparison. Early return on match.
+ *
+ * Variable definition and use:
+ * i - index used for iteration, starting at 1 when skipHead is set.
+ */
+template <typename Container>
+bool ElementInDeque(Cell element, const Container &cells, bool skipHead = false)
+{
+    // loop through each element in the supplied container
+    for (unsigned int i = skipHead ? 1 : 0; i < cells.size(); i++)
+    {
+        if (cells[i] == element)
+        {
+            return true; // found the element
+        }
+    }
+    return false; // not found after checking all entries
+}
+
+/*
+ * SnakeBody class
+ * Objective: fixed-capacity ring buffer of cells, ordered head (index 0) to tail.
+ *            Storage is allocated once for the whole board, so push_front/pop_back
+ *            in Snake::Update never touch the heap. The ring comes from the memory
+ *            resource given at construction (the default heap unless an arena is used).
+ * Member variables:
+ *  - cells : ring storage; its size is a power of two so wrapping is a bit mask.
+ *  - mask  : cells.size() - 1.
+ *  - first : ring index of the head.
+ *  - count : number of segments currently stored.
+ * Member functions:
+ *  - Reserve()    : allocate room for at least the given number of segments and clear.
+ *  - clear()      : drop every segment without releasing storage.
+ *  - size()       : number of segments.
+ *  - capacity()   : segments that fit before the ring must grow.
+ *  - Grow()       : double the ring, keeping the segments (arena snakes start small).
+ *  - operator[]   : i-th segment counted from the head.
+ *  - front/back() : head and tail segments.
+ *  - push_front() : add a new head.
+ *  - pop_back()   : remove the tail.
+ */
+class SnakeBody
+{
+public:
+    std::pmr::vector<Cell> cells; // ring storage, power-of-two sized
+    unsigned int mask = 0;        // index wrap mask (cells.size() - 1)
+    unsigned int first = 0;       // ring position of the head segment
+    unsigned int count = 0;       // number of stored segments
+
+    explicit SnakeBody(std::pmr::memory_resource *memory = std::pmr::get_default_resource())
+        : cells(memory)
+    {
+    }
+
+    /*
+     * Reserve
+     * Objective: allocate ring storage for at least `capacity` segments and empty the body.
+     * Input: unsigned int capacity - largest length the snake can reach
+     * Side effects: reallocates storage (only called on construction)
+     *
+     * Approach: round the capacity up to a power of two so indexing can use a mask
+     *           instead of a modulo.
+     */
+    void Reserve(unsigned int capacity)
+    {
+        unsigned int ringSize = 1;
+        while (ringSize < capacity)
+            ringSize <<= 1; // next power of two
+        cells.assign(ringSize, Cell{0, 0});
+        mask = ringSize - 1;
+        clear();
+    }
+
+    void clear()
+    {
+        first = 0;
+        count = 0;
+    }
+
+    unsigned int size() const { return count; }
+    unsigned int capacity() const { return cells.size(); }
+
+    /*
+     * Grow
+     * Objective: double the ring storage, keeping every segment in order.
+     * Side effects: reallocates; the head moves to ring index 0
+     *
+     * Approach: copy the segments head first into a ring twice the size. Growing by
+     *           doubling keeps the cost amortised O(1) per segment ever added.
+     */
+    void Grow()
+    {
+        std::pmr::vector<Cell> grown(cells.empty() ? 1 : 2 * cells.size(), Cell{0, 0}, cells.get_allocator());
+        for (unsigned int i = 0; i < count; i++)
+            grown[i] = (*this)[i];
+        cells.swap(grown);
+        mask = cells.size() - 1;
+        first = 0;
+    }
+
+    Cell &operator[](unsigned int i) { return cells[(first + i) & mask]; }
+    const Cell &operator[](unsigned int i) const { return cells[(first + i) & mask]; }
+
+    Cell &front() { return (*this)[0]; }
+    const Cell &front() const { return (*this)[0]; }
+    Cell &back() { return (*this)[count - 1]; }
+    const Cell &back() const { return (*this)[count - 1]; }
+
+    /*
+     * push_front
+     * Objective: insert a new head in front of the current one.
+     * Side effects: mutates first/count; the caller guarantees count < capacity
+     */
+    void push_front(Cell cell)
+    {
+        first = (first - 1) & mask; // step the head backwards around the ring
+        cells[first] = cell;
+        count++;
+    }
+
+    /*
+     * pop_back
+     * Objective: drop the tail segment.
+     * Side effects: mutates count; the caller guarantees the body is not empty
+     */
+    void pop_back()
+    {
+        count--;
+    }
+};
+
+/*
+ * OccupancyGrid class
+ * Objective: constant-time answer to "is this cell covered by the snake?" and
+ *            constant-time choice of a random free cell at any fill level.
+ *            Replaces the linear ElementInDeque scans and rejection sampling.
+ * Member variables:
+ *  - size      : number of cells per row/column the grid was built for.
+ *  - cells     : one bit per board cell (size*size), true when a snake segment is on it.
+ *  - freeCells : dense array holding the index (y * size + x) of every free cell.
+ *  - freeSlot  : for each free cell, its position inside freeCells (unused while occupied).
+ *  - chunkVersion : per chunk of chunkCells x chunkCells cells, a counter bumped on every
+ *                   change, so a renderer rebuilds only the chunks that changed.
+ *  Storage is one bit plus two ints per cell and one int per chunk, about 8 MB for a
+ *  1000x1000 board; nothing is allocated per cell object.
+ * Member functions:
+ *  - Resize()    : (re)allocate the storage for a board of the given size and clear it.
+ *  - Clear()     : mark every cell as free.
+ *  - InBounds()  : whether a cell lies inside the board.
+ *  - IsOccupied(): O(1) lookup; cells outside the board are reported as free.
+ *  - Set()       : mark a cell occupied or free (ignored outside the board).
+ *  IsOccupied(), Set() and ChunkOf() also come in a form taking the board geometry
+ *  (board.hpp), which the tick uses so a Board<N> build has no size loads in them.
+ *  - FreeCount() : number of free cells left; 0 means the snake covers the board.
+ *  - FreeCell()  : the i-th free cell, for uniform random picks in O(1).
+ *  - ChunkOf()   : chunk index of a cell inside the board.
+ */
+class OccupancyGrid
+{
+public:
+    int size = 0;                     // cells per row/column
+    std::pmr::vector<bool> cells;     // bitset of size*size flags, row-major (index = y * size + x)
+    std::pmr::vector<int> freeCells;  // dense list of free cell indices, order is arbitrary
+    std::pmr::vector<int> freeSlot;   // freeSlot[index] = position of index inside freeCells
+    static constexpr int chunkShift = 6;               // chunks are 64x64 cells
+    static constexpr int chunkCells = 1 << chunkShift; // cells per chunk row/column
+    int chunksPerRow = 0;                     // ceil(size / chunkCells)
+    std::pmr::vector<uint32_t> chunkVersion; // incremented whenever a cell of the chunk changes, row-major
+
+    explicit OccupancyGrid(std::pmr::memory_resource *memory = std::pmr::get_default_resource())
+        : cells(memory), freeCells(memory), freeSlot(memory), chunkVersion(memory)
+    {
+    }
+
+    /*
+     * Resize
+     * Objective: allocate storage for a size x size board and clear every cell.
+     * Input: int boardSize - number of cells per row/column
+     * Side effects: reallocates the bitset and free-cell index (only called on construction)
+     */
+    void Resize(int boardSize)
+    {
+        size = boardSize;
+        cells.resize(size * size);
+        freeCells.resize(size * size);
+        freeSlot.resize(size * size);
+        chunksPerRow = (size + chunkCells - 1) >> chunkShift;
+        chunkVersion.assign(chunksPerRow * chunksPerRow, 0);
+        Clear();
+    }
+
+    /*
+     * Clear
+     * Objective: mark every cell free without reallocating.
+     * Approach: reset the bitset and refill the free list with every index in order.
+     */
+    void Clear()
+    {
+        cells.assign(cells.size(), false);
+        freeCells.resize(size * size); // within capacity, so no reallocation
+        for (int i = 0; i < size * size; i++)
+        {
+            freeCells[i] = i; // every cell is free...
+            freeSlot[i] = i;  // ...and sits at its own position in the dense list
+        }
+        for (uint32_t &version : chunkVersion)
+            version++; // every chunk may have lost cells
+    }
+
+    /*
+     * InBounds
+     * Objective: check that a grid cell lies inside [0, size-1] on both axes.
+     * Return value: bool - true when the cell can be indexed
+     */
+    bool InBounds(Cell cell) const
+    {
+        return cell.x >= 0 && cell.y >= 0 && cell.x < size && cell.y < size;
+    }
+
+    /*
+     * IsOccupied
+     * Objective: O(1) occupancy lookup for a grid cell.
+     * Return value: bool - true if a snake segment covers the cell; false for free
+     *               cells and for cells outside the board
+     */
+    bool IsOccupied(Cell cell) const
+    {
+        return IsOccupied(cell, DynamicBoard(size));
+    }
+
+    /*
+     * IsOccupied (board geometry given)
+     * Objective: same lookup with bounds and index computed from `board`, which must
+     *            describe this grid; Board<N> turns them into constant arithmetic.
+     */
+    template <typename B>
+    bool IsOccupied(Cell cell, B board) const
+    {
+        if (!board.InBounds(cell))
+            return false; // the head may sit one cell outside the board before the edge check
+        return cells[board.Index(cell)];
+    }
+
+    /*
+     * Set
+     * Objective: mark a cell as covered (value = true) or free (value = false).
+     * Side effects: mutates the bitset, the free-cell index and the chunk version; cells outside the board
+     *               and calls that do not change the cell's state are ignored
+     *
+     * Approach:
+     * Occupying swap-removes the cell from freeCells (the last free cell takes its slot);
+     * freeing appends it at the end. Both are O(1).
+     *
+     * Variable definition and use:
+     * index - row-major cell index; last - free cell moved into the vacated slot
+     */
+    void Set(Cell cell, bool value)
+    {
+        Set(cell, value, DynamicBoard(size));
+    }
+
+    /*
+     * Set (board geometry given)
+     * Objective: same update with bounds, index and chunk computed from `board`, which
+     *            must describe this grid.
+     */
+    template <typename B>
+    void Set(Cell cell, bool value, B board)
+    {
+        if (!board.InBounds(cell))
+            return;
+        int index = board.Index(cell);
+        if (cells[index] == value)
+            return; // already in the requested state (e.g. head overlapping the body)
+        cells[index] = value;
+        chunkVersion[ChunkOf(cell, board)]++;
+
+        if (value)
+        {
+            int last = freeCells.back();        // swap-remove: move the last free cell...
+            freeCells[freeSlot[index]] = last;  // ...into the slot of the cell being occupied
+            freeSlot[last] = freeSlot[index];
+            freeCells.pop_back();
+        }
+        else
+        {
+            freeSlot[index] = freeCells.size(); // append the newly freed cell
+            freeCells.push_back(index);         // capacity is size*size, never reallocates
+        }
+    }
+
+    /*
+     * ChunkOf
+     * Objective: index into chunkVersion of the chunk holding an in-bounds cell.
+     */
+    int ChunkOf(Cell cell) const
+    {
+        return (cell.y >> chunkShift) * chunksPerRow + (cell.x >> chunkShift);
+    }
+
+    template <typename B>
+    int ChunkOf(Cell cell, B board) const
+    {
+        int perRow = (board.Size() + chunkCells - 1) >> chunkShift; // chunksPerRow, a constant for Board<N>
+        return (cell.y >> chunkShift) * perRow + (cell.x >> chunkShift);
+    }
+
+    /*
+     * FreeCount
+     * Return value: int - number of cells no segment covers
+     */
+    int FreeCount() const
+    {
+        return freeCells.size();
+    }
+
+    /*
+     * FreeCell
+     * Objective: return the i-th entry of the free list as a grid cell.
+     * Input: int i - position in [0, FreeCount()-1]
+     * Return value: Cell coordinates
+     */
+    Cell FreeCell(int i) const
+    {
+        int index = freeCells[i];
+        return Cell{(int16_t)(index % size), (int16_t)(index / size)};
+    }
+};
+
+/*
+ * Snake class
+ * Objective: encapsulates the snake's state and movement rules (update, reset).
+ * Member variables:
+ *  - addSegment : when true, the snake will grow by one segment on next update.
+ *  - body       : ring buffer of the grid cells occupied by the snake, head first.
+ *  - direction  : unit Cell step indicating the current movement direction (e.g., {1,0}).
+ *  - occupancy  : bitset of the cells covered by body, kept in sync by Update()/Reset().
+ *  - hitTail    : set by Update() when the new head lands on a cell the body still covers.
+ *  - previousTail, tailMoved : the cell the last Update() popped, if it popped one. With
+ *                  body[1] as the previous head, this is all that differs from the state
+ *                  before that tick, so a renderer can interpolate without a copy.
+ * Member functions:
+ *  - Update()   : advances the snake by one cell in the current direction. Update(board)
+ *                 does the same with the grid geometry given; it is instantiated for
+ *                 DynamicBoard and FixedBoard in simulation.cpp.
+ *  - Reset()    : restores initial position and direction.
+ *  - IsOccupied(): O(1) check whether any segment covers a cell.
+ */
+class Snake
+{
+public:
+    bool addSegment = false;    // when true, do not pop back on next Update() so snake grows
+    SnakeBody body;             // segments head first; filled by Reset()
+    Cell direction = {1, 0};    // initial movement direction = right
+    OccupancyGrid occupancy;    // which cells body covers; updated incrementally
+    bool hitTail = false;       // true when the last Update() moved the head onto the body
+    Cell previousTail = {0, 0}; // tail cell before the last Update() (valid when tailMoved)
+    bool tailMoved = false;     // the last Update() popped the tail (false after growth or Reset())
+
+    explicit Snake(int boardSize, std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+    void Update();
+    template <typename B>
+    void Update(B board);
+    void Reset();
+
+    /*
+     * IsOccupied
+     * Objective: O(1) check whether any segment of the snake covers the given cell.
+     * Return value: bool - true when the cell is covered
+     */
+    bool IsOccupied(Cell cell) const
+    {
+        return occupancy.IsOccupied(cell);
+    }
+};
+
+/*
+ * Food class
+ * Objective: represent a food item that the snake can eat and place it on free cells.
+ *            Only state lives here; the front end maps textureIndex to a texture.
+ * Instance members:
+ *  - position     : grid cell where this food is located
+ *  - textureIndex : which of the food visuals (0..textureCount-1) to draw
+ *  - active       : false when no free cell was left to place this food on
+ */
+class Food
+{
+public:
+    static constexpr int textureCount = 4; // number of food visuals the front end provides
+    Cell position = {0, 0};       // current grid cell for this fruit
+    int textureIndex = 0;         // index of the visual to draw
+    bool active = true;           // inactive food is neither drawn nor eaten (board full)
+
+    Food() = default; // placed by its owner (the arena)
+    Food(const Snake &snake, SimRandom &rng);
+    bool GenerateRandomPos(const Snake &snake, SimRandom &rng, Cell &pos) const;
+    void Respawn(const Snake &snake, SimRandom &rng);
+};
+
+/*
+ * TickEvents struct
+ * Objective: report what one simulation tick did, so the front end can play sounds and
+ *            switch screens without the core knowing about either.
+ * Member variables:
+ *  - fruitsEaten : number of fruits the head landed on this tick.
+ *  - hitEdge     : the head left the board.
+ *  - hitTail     : the head ran into the body.
+ *  - boardFull   : the snake covers every cell (the round is won).
+ */
+struct TickEvents
+{
+    int fruitsEaten = 0;
+    bool hitEdge = false;
+    bool hitTail = false;
+    bool boardFull = false;
+
+    bool Died() const { return hitEdge || hitTail; }
+    bool RoundOver() const { return hitEdge || hitTail || boardFull; }
+};
+
+/*
+ * Simulation class
+ * Objective: headless game state and rules for one board: snake, fruits, score, speed
+ *            and random generator.
+ * Member variables:
+ *  - boardSize : cells per row/column.
+ *  - score     : running score for the current round.
+ *  - lastScore : score of the most recently finished round.
+ *  - speed     : interval (in seconds) between ticks; read by the front end's timestep.
+ *  - snake     : the player's snake.
+ *  - fruits    : fruits currently on the board (fruitCount of them), stored inline.
+ *  - seed      : seed the generator was created with (stored in replays).
+ *  - rng       : generator for food placement and visuals.
+ * Member functions: see the overview at the top of this file.
+ */
+class Simulation
+{
+public:
+    static constexpr int fruitCount = 3;      // number of fruits to maintain concurrently
+    static constexpr double startSpeed = 0.2; // tick interval at the start of a round
+    static constexpr double minSpeed = 0.07;  // the speed-up rule stops below this interval
+
+    int boardSize;
+    uint64_t seed;
+    int score = 0;
+    int lastScore = 0;
+    double speed = startSpeed;
+    Snake snake;
+    InlineVector<Food, fruitCount> fruits;
+    SimRandom rng;
+
+    Simulation(int size, uint64_t rngSeed, std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+    TickEvents Step(Cell direction);
+    TickEvents Update();
+    void GameOver();
+
+    static double SpeedAfterFruit(double interval)
+    {
+        return interval >= minSpeed ? interval * 0.98 : interval;
+    }
+
+private:
+    template <typename B>
+    TickEvents UpdateOn(B board);
+    void CheckCollisionWithFood(TickEvents &events);
+    template <typename B>
+    void CheckCollisionWithEdges(TickEvents &events, B board);
+    void CheckCollisionsWithTail(TickEvents &events);
+    void CheckBoardFull(TickEvents &events);
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+/**
+ * =============================
+ * Class Overview
+ * =============================
+ * **SpscRing<T, Capacity>** is a fixed-size, lock-free queue for exactly one
+ * producer thread and one consumer thread. Neither side ever blocks or
+ * allocates, so it is safe to use from real-time code such as the audio
+ * callback.
+ *
+ * The read and write counters only ever increase and are masked into the
+ * storage, so Capacity must be a power of two. Each counter sits on its own
+ * cache line, so the two threads do not false-share.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **bool TryPush(const T &value)**  (producer only)
+ *   - Return: false when the ring is full; the value is dropped.
+ *
+ * **bool TryPop(T &out)**  (consumer only)
+ *   - Return: false when the ring is empty.
+ */
+template <typename T, size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    bool TryPush(const T &value)
+    {
+        size_t write = writeIndex.load(std::memory_order_relaxed);
+        if (write - readIndex.load(std::memory_order_acquire) == Capacity)
+            return false;
+        items[write & (Capacity - 1)] = value;
+        writeIndex.store(write + 1, std::memory_order_release); // publishes the item
+        return true;
+    }
+
+    bool TryPop(T &out)
+    {
+        size_t read = readIndex.load(std::memory_order_relaxed);
+        if (read == writeIndex.load(std::memory_order_acquire))
+            return false;
+        out = items[read & (Capacity - 1)];
+        readIndex.store(read + 1, std::memory_order_release); // hands the slot back
+        return true;
+    }
+
+private:
+    alignas(64) std::atomic<size_t> writeIndex{0}; ///< items pushed so far (producer)
+    alignas(64) std::atomic<size_t> readIndex{0};  ///< items popped so far (consumer)
+    T items[Capacity];
+};
@@ -0,0 +1,117 @@
+#include "telemetry.hpp"
+
+/**
+ * Telemetry::Start
+ * ============================
+ * Objective:
+ *   Open the stream and launch the writer.
+ *
+ * Return Value:
+ *   - bool → false when the file cannot be opened; Emit() then does nothing.
+ */
+bool Telemetry::Start(const char *path)
+{
+    if (file)
+        return true;
+    file = fopen(path, "ab");
+    if (!file)
+        return false;
+    fseek(file, 0, SEEK_END);
+    if (ftell(file) == 0)
+    {
+        const uint8_t header[5] = {'S', 'N', 'K', 'T', 1};
+        fwrite(header, 1, sizeof(header), file);
+    }
+    started = std::chrono::steady_clock::now();
+    stop.store(false);
+    batch.reserve(blockEvents);
+    writer = std::thread(&Telemetry::Work, this);
+    return true;
+}
+
+void Telemetry::Stop()
+{
+    if (!file)
+        return;
+    stop.store(true, std::memory_order_release);
+    writer.join(); // drains the ring before it returns
+    fclose(file);
+    file = nullptr;
+}
+
+/**
+ * Telemetry::Work
+ * ============================
+ * Objective:
+ *   Writer thread body: move events from the ring into blocks.
+ *
+ * Approach:
+ *   The ring never blocks its producer, so the writer polls: it drains whatever
+ *   is queued, writes a block once blockEvents are collected or flushMilliseconds
+ *   have passed since the last write, and sleeps a little in between. At 4096
+ *   slots and a 20 ms nap, the game would have to emit 200000 events a second
+ *   before anything is dropped. On stop it drains once more, after the final
+ *   Emit() calls have become visible through the ring's release store.
+ */
+void Telemetry::Work()
+{
+    auto lastWrite = std::chrono::steady_clock::now();
+    for (;;)
+    {
+        bool stopping = stop.load(std::memory_order_acquire);
+        TelemetryEvent event;
+        while (ring.TryPop(event))
+        {
+            batch.push_back(event);
+            if (batch.size() == blockEvents)
+                WriteBlock();
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (!batch.empty() && (stopping || now - lastWrite >= std::chrono::milliseconds(flushMilliseconds)))
+        {
+            WriteBlock();
+            lastWrite = now;
+        }
+        if (stopping)
+            return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+/**
+ * Telemetry::WriteBlock
+ * ============================
+ * Objective:
+ *   Encode the batch as one columnar block and append it to the file.
+ *
+ * Approach:
+ *   One column after another, so a reader can load e.g. every `kind` of a block
+ *   with a single read; fflush keeps the file current for readers while the game
+ *   is still running.
+ */
+void Telemetry::WriteBlock()
+{
+    const size_t count = batch.size();
+    block.clear();
+    auto put = [this](const void *data, size_t size)
+    {
+        const uint8_t *bytes = (const uint8_t *)data;
+        block.insert(block.end(), bytes, bytes + size); // host order; every supported target is little endian
+    };
+    uint32_t header = (uint32_t)count;
+    put(&header, 4);
+    for (const TelemetryEvent &e : batch)
+        put(&e.tick, 4);
+    for (const TelemetryEvent &e : batch)
+        put(&e.milliseconds, 4);
+    for (const TelemetryEvent &e : batch)
+        put(&e.kind, 1);
+    for (const TelemetryEvent &e : batch)
+        put(&e.value, 4);
+    for (const TelemetryEvent &e : batch)
+        put(&e.speed, 4);
+    fwrite(block.data(), 1, block.size(), file);
+    fflush(file);
+    batch.clear();
+}
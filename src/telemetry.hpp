@@ -0,0 +1,121 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "spsc_ring.hpp"
+
+/**
+ * =============================
+ * Telemetry Overview
+ * =============================
+ * Gameplay event stream for offline analysis: fruit eaten, speed-ups, deaths by
+ * cause, round and session boundaries. The game thread only builds a 20-byte
+ * event and pushes it into a lock-free SpscRing; a background thread drains the
+ * ring, batches the events and appends them to a file as columnar blocks. An
+ * event costs a clock read and a ring push, and only ticks where something
+ * happened emit one, so an ordinary tick pays a single branch.
+ *
+ * Nothing is started unless Start() succeeds (the game's --telemetry FILE), so a
+ * disabled stream costs Emit() one predictable branch. When the writer falls more
+ * than ringCapacity events behind, new events are dropped and counted rather than
+ * ever blocking the frame.
+ *
+ * =============================
+ * File format (little endian)
+ * =============================
+ *   header : magic "SNKT", version u8 (1); written when the file is empty
+ *   block  : event count u32 (n), then the columns, each n values long:
+ *            tick u32, milliseconds u32, kind u8, value i32, speed f32
+ *
+ * A file may hold several sessions; each starts with a SessionStart event.
+ * `tick` counts the session's simulation ticks, `milliseconds` the wall time since
+ * Start(), `speed` is the tick interval (seconds) when the event happened and
+ * `value` depends on the kind (see TelemetryKind).
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **bool Start(const char *path)**
+ *   - Objective: open `path` for appending and launch the writer thread.
+ *
+ * **void Emit(TelemetryKind kind, uint32_t tick, int32_t value, float speed)**
+ *   - Objective: record one event (game thread only).
+ *
+ * **void Stop()** / **~Telemetry()**
+ *   - Objective: write everything still queued, close the file and join the writer.
+ *
+ * **uint32_t Dropped() const**
+ *   - Return: events lost because the ring was full.
+ */
+
+enum class TelemetryKind : uint8_t
+{
+    SessionStart = 0, // value: board size
+    FruitEaten = 1,   // value: score after eating
+    SpeedChange = 2,  // value: score; speed: the new interval
+    DeathEdge = 3,    // value: score of the round
+    DeathTail = 4,    // value: score of the round (own body, or another snake in arena modes)
+    BoardFull = 5,    // value: score of the round
+    RoundEnd = 6,     // value: score of the round
+    SessionEnd = 7,   // value: rounds played
+};
+
+struct TelemetryEvent
+{
+    uint32_t tick;
+    uint32_t milliseconds;
+    int32_t value;
+    float speed;
+    TelemetryKind kind;
+};
+
+class Telemetry
+{
+public:
+    static constexpr size_t ringCapacity = 4096;   // events in flight between the threads
+    static constexpr size_t blockEvents = 1024;    // events per written block, at most
+    static constexpr int flushMilliseconds = 1000; // a partial block is written after this long
+
+    Telemetry() = default;
+    ~Telemetry() { Stop(); }
+    Telemetry(const Telemetry &) = delete; // owns a thread
+    Telemetry &operator=(const Telemetry &) = delete;
+
+    bool Start(const char *path);
+    void Stop();
+
+    void Emit(TelemetryKind kind, uint32_t tick, int32_t value, float speed)
+    {
+        if (!file)
+            return;
+        TelemetryEvent event;
+        event.tick = tick;
+        event.milliseconds = (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::steady_clock::now() - started)
+                                 .count();
+        event.value = value;
+        event.speed = speed;
+        event.kind = kind;
+        if (!ring.TryPush(event))
+            dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint32_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    void Work();
+    void WriteBlock();
+
+    SpscRing<TelemetryEvent, ringCapacity> ring; // game thread -> writer
+    FILE *file = nullptr;                        // open between Start() and Stop()
+    std::chrono::steady_clock::time_point started;
+    std::atomic<bool> stop{false};
+    std::atomic<uint32_t> dropped{0};
+    std::vector<TelemetryEvent> batch;           // writer thread only
+    std::vector<uint8_t> block;                  // encoded columns, reused
+    std::thread writer;
+};
@@ -0,0 +1,182 @@
+#include "thread_pool.hpp"
+
+/**
+ * ThreadPool::ThreadPool
+ * ============================
+ * Objective:
+ *   Create one chunk queue per worker and start the helper threads.
+ *
+ * Input:
+ *   - unsigned int workers → total workers including the caller; 0 picks
+ *     std::thread::hardware_concurrency().
+ */
+ThreadPool::ThreadPool(unsigned int workers)
+{
+    if (workers == 0)
+        workers = std::thread::hardware_concurrency();
+    if (workers == 0)
+        workers = 1; // hardware_concurrency may be unknown
+    workerCount = workers;
+
+    for (unsigned int i = 0; i < workerCount; i++)
+        queues.push_back(std::unique_ptr<ChunkQueue>(new ChunkQueue()));
+    for (unsigned int i = 1; i < workerCount; i++)
+        threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+
+/**
+ * ThreadPool::~ThreadPool
+ * ============================
+ * Objective:
+ *   Ask the helper threads to exit and join them.
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &t : threads)
+        t.join();
+}
+
+/**
+ * ThreadPool::ParallelFor
+ * ============================
+ * Objective:
+ *   Run job over [0, count) in chunks of `grain` on all workers.
+ *
+ * Approach:
+ *   Deal the chunks out in contiguous runs, one run per worker queue (neighbouring
+ *   chunks stay on one core for locality), publish the job under the state lock and
+ *   wake the helpers. The caller works as worker 0, then waits until every chunk is
+ *   done and every helper has left the loop, so the job can never be used after
+ *   this function returns.
+ */
+void ThreadPool::ParallelFor(size_t count, size_t grain, const Job &job)
+{
+    if (count == 0)
+        return;
+    if (grain == 0)
+        grain = 1;
+    size_t chunkCount = (count + grain - 1) / grain;
+
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        for (unsigned int w = 0; w < workerCount; w++)
+        {
+            ChunkQueue &queue = *queues[w];
+            std::lock_guard<std::mutex> queueGuard(queue.lock);
+            queue.chunks.clear();
+            queue.front = 0;
+            size_t first = chunkCount * w / workerCount;
+            size_t last = chunkCount * (w + 1) / workerCount;
+            for (size_t c = last; c > first; c--)
+                queue.chunks.push_back(c - 1); // owner pops from the back, so lowest chunk first
+        }
+        currentJob = &job;
+        jobCount = count;
+        jobGrain = grain;
+        remainingChunks.store(chunkCount);
+        activeWorkers = workerCount; // includes the caller
+        generation++;
+    }
+    wake.notify_all();
+
+    RunChunks(0, job);
+
+    std::unique_lock<std::mutex> guard(stateLock);
+    activeWorkers--;
+    finished.wait(guard, [this] { return activeWorkers == 0; });
+    currentJob = nullptr;
+}
+
+/**
+ * ThreadPool::WorkerLoop
+ * ============================
+ * Objective:
+ *   Helper thread body: sleep until a new loop is published, run chunks until none
+ *   are left anywhere, report back, repeat until the pool is destroyed.
+ */
+void ThreadPool::WorkerLoop(unsigned int worker)
+{
+    unsigned long long seen = 0;
+    while (true)
+    {
+        const Job *job;
+        {
+            std::unique_lock<std::mutex> guard(stateLock);
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            job = currentJob;
+        }
+
+        RunChunks(worker, *job);
+
+        {
+            std::lock_guard<std::mutex> guard(stateLock);
+            activeWorkers--;
+        }
+        finished.notify_one();
+    }
+}
+
+/**
+ * ThreadPool::RunChunks
+ * ============================
+ * Objective:
+ *   Execute chunks (own first, then stolen) until every queue is empty.
+ */
+void ThreadPool::RunChunks(unsigned int worker, const Job &job)
+{
+    size_t chunk;
+    while (remainingChunks.load(std::memory_order_acquire) > 0 && TakeChunk(worker, chunk))
+    {
+        size_t begin = chunk * jobGrain;
+        size_t end = begin + jobGrain < jobCount ? begin + jobGrain : jobCount;
+        job(begin, end, worker);
+        remainingChunks.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+/**
+ * ThreadPool::TakeChunk
+ * ============================
+ * Objective:
+ *   Pop a chunk from the worker's own queue, or steal one from another queue.
+ *
+ * Return Value:
+ *   - bool → false when every queue is empty.
+ *
+ * Approach:
+ *   Own queue from the back (most recently dealt, cache-warm neighbours); victims
+ *   are visited round-robin starting after the caller and robbed from the front.
+ */
+bool ThreadPool::TakeChunk(unsigned int worker, size_t &chunk)
+{
+    {
+        ChunkQueue &own = *queues[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (own.chunks.size() > own.front)
+        {
+            chunk = own.chunks.back();
+            own.chunks.pop_back();
+            return true;
+        }
+    }
+
+    for (unsigned int i = 1; i < workerCount; i++)
+    {
+        ChunkQueue &victim = *queues[(worker + i) % workerCount];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (victim.chunks.size() > victim.front)
+        {
+            chunk = victim.chunks[victim.front++];
+            return true;
+        }
+    }
+    return false;
+}
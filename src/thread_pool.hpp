@@ -0,0 +1,115 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * =============================
+ * Class Overview
+ * =============================
+ * The **ThreadPool** class runs data-parallel loops over a fixed set of worker
+ * threads with work stealing. A ParallelFor splits [0, count) into chunks of
+ * `grain` items; each worker starts with a contiguous share of the chunks in its
+ * own queue and takes from the back of it, and a worker that runs dry steals from
+ * the front of another worker's queue. Uneven chunks (e.g. batches of games that
+ * die at different ticks) therefore keep every core busy until the loop ends.
+ *
+ * The calling thread takes part as worker 0, so a pool of N workers starts N-1
+ * threads. Chunk queues keep their storage between loops, and a Job only refers to
+ * the caller's callable instead of copying it, so after the first ParallelFor no
+ * further allocations happen.
+ *
+ * =============================
+ * Member Functions (public)
+ * =============================
+ * **ThreadPool(unsigned int workers)**
+ *   - Objective: start workers-1 threads (0 = one per hardware thread).
+ *
+ * **~ThreadPool()**
+ *   - Objective: stop and join the threads.
+ *
+ * **unsigned int Size()**
+ *   - Return: number of workers including the calling thread.
+ *
+ * **void ParallelFor(size_t count, size_t grain, const Job &job)**
+ *   - Objective: call job(begin, end, worker) for every chunk of [0, count) and
+ *                return once all chunks are done.
+ *   - Input: worker → index in [0, Size()) of the thread running the chunk, for
+ *            per-thread scratch data.
+ *   - Note: job is any callable with that signature, usually a lambda written at
+ *           the call. Job keeps only its address, which is safe because the call
+ *           does not return before every chunk has run.
+ */
+class ThreadPool
+{
+public:
+    /*
+     * Job
+     * Objective: non-owning reference to a callable(begin, end, worker). Unlike
+     *            std::function it never copies the callable, so a lambda with a large
+     *            capture costs no heap allocation per loop.
+     */
+    class Job
+    {
+    public:
+        template <typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Job>::value>::type>
+        Job(const F &callable) : context(&callable), call(&Invoke<F>) {}
+
+        void operator()(size_t begin, size_t end, unsigned int worker) const { call(context, begin, end, worker); }
+
+    private:
+        template <typename F>
+        static void Invoke(const void *callable, size_t begin, size_t end, unsigned int worker)
+        {
+            (*static_cast<const F *>(callable))(begin, end, worker);
+        }
+
+        const void *context; // the caller's callable, alive for the whole ParallelFor
+        void (*call)(const void *, size_t, size_t, unsigned int);
+    };
+
+    explicit ThreadPool(unsigned int workers = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    unsigned int Size() const { return workerCount; }
+    void ParallelFor(size_t count, size_t grain, const Job &job);
+
+private:
+    /*
+     * ChunkQueue
+     * Objective: one worker's chunk indices. The owner pops from the back, thieves
+     *            take from the front; a mutex per queue keeps contention local.
+     */
+    struct ChunkQueue
+    {
+        std::mutex lock;
+        std::vector<size_t> chunks; // chunk indices, live range is [front, chunks.size())
+        size_t front = 0;
+    };
+
+    void WorkerLoop(unsigned int worker);
+    void RunChunks(unsigned int worker, const Job &job);
+    bool TakeChunk(unsigned int worker, size_t &chunk);
+
+    unsigned int workerCount;
+    std::vector<std::unique_ptr<ChunkQueue>> queues; // one per worker
+    std::vector<std::thread> threads;
+
+    std::mutex stateLock;                   // guards everything below
+    std::condition_variable wake;           // new loop available or shutting down
+    std::condition_variable finished;       // a worker left the current loop
+    const Job *currentJob = nullptr;
+    size_t jobCount = 0;
+    size_t jobGrain = 1;
+    unsigned long long generation = 0;      // bumped once per ParallelFor
+    unsigned int activeWorkers = 0;         // workers still inside the current loop
+    bool stopping = false;
+    std::atomic<size_t> remainingChunks{0};
+};
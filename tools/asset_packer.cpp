@@ -0,0 +1,187 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include <raylib.h>
+
+#include "asset_bundle.hpp"
+#include "assets.hpp"
+#include "simulation.hpp" // Food::textureCount
+
+/**
+ * =============================
+ * asset_packer Overview
+ * =============================
+ * Build-time tool that writes assets.pak (format in asset_bundle.hpp). It runs as
+ * a prebuild step of the game: every image in packedImages is decoded, resized to
+ * its draw scale and converted to RGBA8, the food images are packed into the
+ * atlas, and every sound in packedSounds is decoded to PCM in the mixer format.
+ * Only raylib's CPU image/audio code is used, so no window or audio device is
+ * opened.
+ *
+ * Usage:
+ *   asset_packer ROOT OUTPUT
+ *
+ * ROOT is the directory holding graphics/ and sounds/; OUTPUT is the pack to
+ * write. When OUTPUT is newer than every source (and this tool) the step is a
+ * no-op, so incremental builds do not pay for it.
+ */
+
+namespace fs = std::filesystem;
+
+struct PendingEntry
+{
+    PackEntry entry;             // offset filled in when the file is laid out
+    std::vector<unsigned char> data;
+};
+
+/*
+ * AddEntry
+ * Objective: queue one blob with its header fields.
+ */
+static void AddEntry(std::vector<PendingEntry> &pending, const char *name, PackKind kind,
+                     const uint32_t fields[4], const void *data, size_t size)
+{
+    PendingEntry item = {};
+    snprintf(item.entry.name, sizeof(item.entry.name), "%s", name);
+    item.entry.kind = kind;
+    memcpy(item.entry.fields, fields, sizeof(item.entry.fields));
+    item.entry.size = size;
+    item.data.assign((const unsigned char *)data, (const unsigned char *)data + size);
+    pending.push_back(std::move(item));
+}
+
+/*
+ * AddImage
+ * Objective: queue an RGBA8 image; returns false if it failed to decode.
+ */
+static bool AddImage(std::vector<PendingEntry> &pending, const char *name, Image image)
+{
+    if (!image.data)
+        return false;
+    uint32_t fields[4] = {(uint32_t)image.width, (uint32_t)image.height, (uint32_t)image.format, (uint32_t)image.mipmaps};
+    AddEntry(pending, name, PackImage, fields, image.data, GetPixelDataSize(image.width, image.height, image.format));
+    UnloadImage(image);
+    return true;
+}
+
+/*
+ * UpToDate
+ * Objective: whether output exists and is newer than every input and the packer itself.
+ */
+static bool UpToDate(const fs::path &output, const std::vector<fs::path> &inputs)
+{
+    std::error_code error;
+    fs::file_time_type written = fs::last_write_time(output, error);
+    if (error)
+        return false;
+    for (const fs::path &input : inputs)
+    {
+        fs::file_time_type modified = fs::last_write_time(input, error);
+        if (error || modified > written)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s ROOT OUTPUT\n", argv[0]);
+        return 1;
+    }
+    fs::path output = fs::absolute(argv[2]);
+    std::error_code error;
+    fs::current_path(argv[1], error); // asset paths in assets.hpp are relative to the root
+    if (error)
+    {
+        fprintf(stderr, "asset_packer: cannot enter %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<fs::path> inputs = {fs::absolute(argv[0])};
+    for (const ImageAssetSpec &spec : packedImages)
+        inputs.push_back(spec.path);
+    for (const char *path : packedSounds)
+        inputs.push_back(path);
+    for (int i = 0; i < Food::textureCount; i++)
+        inputs.push_back(TextFormat("graphics/food%i.png", i + 1));
+    if (UpToDate(output, inputs))
+    {
+        printf("asset_packer: %s is up to date\n", output.string().c_str());
+        return 0;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    std::vector<PendingEntry> pending;
+    bool ok = true;
+    for (const ImageAssetSpec &spec : packedImages)
+    {
+        char key[packNameLength];
+        AssetKey(key, sizeof(key), spec.path, spec.scale);
+        ok = AddImage(pending, key, LoadScaledImage(spec.path, spec.scale)) && ok;
+    }
+    ok = AddImage(pending, foodAtlasName, BuildFoodAtlas()) && ok;
+    for (const char *path : packedSounds)
+    {
+        Wave wave = LoadMixerWave(path); // stored in the format AudioMixer plays
+        if (!wave.data)
+        {
+            ok = false;
+            continue;
+        }
+        uint32_t fields[4] = {wave.frameCount, wave.sampleRate, wave.sampleSize, wave.channels};
+        AddEntry(pending, path, PackWave, fields, wave.data, (size_t)wave.frameCount * wave.channels * (wave.sampleSize / 8));
+        UnloadWave(wave);
+    }
+    if (!ok)
+    {
+        fprintf(stderr, "asset_packer: failed to decode an asset\n");
+        return 1;
+    }
+
+    // lay the file out: header, entry table, then each blob on an aligned offset
+    PackHeader header = {{'S', 'N', 'K', 'A'}, packVersion, (uint32_t)pending.size(), 0};
+    uint64_t offset = sizeof(PackHeader) + pending.size() * sizeof(PackEntry);
+    for (PendingEntry &item : pending)
+    {
+        offset = (offset + packAlignment - 1) / packAlignment * packAlignment;
+        item.entry.offset = offset;
+        offset += item.entry.size;
+    }
+
+    fs::path temporary = output;
+    temporary += ".tmp";
+    FILE *file = fopen(temporary.string().c_str(), "wb");
+    if (!file)
+    {
+        fprintf(stderr, "asset_packer: cannot write %s\n", temporary.string().c_str());
+        return 1;
+    }
+    fwrite(&header, sizeof(header), 1, file);
+    for (const PendingEntry &item : pending)
+        fwrite(&item.entry, sizeof(item.entry), 1, file);
+    static const unsigned char padding[packAlignment] = {};
+    uint64_t position = sizeof(PackHeader) + pending.size() * sizeof(PackEntry);
+    for (const PendingEntry &item : pending)
+    {
+        fwrite(padding, 1, (size_t)(item.entry.offset - position), file);
+        fwrite(item.data.data(), 1, item.data.size(), file);
+        position = item.entry.offset + item.entry.size;
+    }
+    bool written = !ferror(file);
+    written = fclose(file) == 0 && written;
+    if (written)
+        fs::rename(temporary, output, error); // readers never see a half-written pack
+    if (!written || error)
+    {
+        fprintf(stderr, "asset_packer: cannot write %s\n", output.string().c_str());
+        return 1;
+    }
+
+    printf("asset_packer: wrote %zu assets (%llu bytes) to %s\n", pending.size(),
+           (unsigned long long)position, output.string().c_str());
+    return 0;
+}
@@ -0,0 +1,461 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "arena.hpp"
+#include "net_protocol.hpp"
+#include "net_socket.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * =============================
+ * snake_server Overview
+ * =============================
+ * Dedicated headless server for multiplayer arenas; protocol in net_protocol.hpp.
+ * Each room is one Arena stepped at a fixed tick. Snakes whose slot has a client
+ * follow that client's heading, every other slot is a bot (Arena::BotDirection),
+ * so a room always has the same number of snakes and players drop in and out of
+ * bot slots. A client joining a full room spectates.
+ *
+ * One tick of the process:
+ *   1. the main thread drains the socket until the tick is due: joins, leaves,
+ *      headings and acknowledgements only update client records;
+ *   2. every room steps on the thread pool (one room per chunk, so rooms spread
+ *      over the cores), encodes its tick record once, and sends each of its clients
+ *      the records it has not acknowledged, or a keyframe when it is too far behind.
+ * The phases never overlap, so rooms read client records without locks, and each
+ * room touches only its own clients.
+ *
+ * Usage:
+ *   snake_server [--port N] [--board N] [--snakes N] [--rooms N] [--max-rooms N]
+ *                [--tick-ms N] [--threads N] [--seconds N] [--seed N]
+ *
+ * --rooms starts that many bot-only rooms up front (for load tests); further rooms
+ * are created when a client joins them, up to --max-rooms. --seconds stops the
+ * server after that long (0, the default, runs until killed). Every five seconds
+ * it prints rooms, clients, the mean cost of a tick and bytes sent per client.
+ */
+
+/*
+ * RemoteClient struct
+ * Objective: one connected player.
+ * Member variables:
+ *  - address      : where its packets come from and ours go.
+ *  - room, slot   : its room index and snake index (-1: spectator).
+ *  - sequence     : newest Input sequence applied; older packets are ignored.
+ *  - direction    : heading it asked for; hasDirection until its first Input.
+ *  - ack          : newest tick record it holds in order (0 = needs a keyframe).
+ *  - keyframeTick : room tick of the last keyframe sent, to rate-limit resends.
+ *  - lastHeard    : server time of its last packet, for the timeout.
+ */
+struct RemoteClient
+{
+    NetAddress address;
+    int room = -1;
+    int slot = -1;
+    uint32_t sequence = 0;
+    Cell direction = {1, 0};
+    bool hasDirection = false;
+    uint32_t ack = 0;
+    uint32_t keyframeTick = 0;
+    double lastHeard = 0;
+    bool active = false;
+};
+
+struct ServerOptions
+{
+    int board = 64;
+    int snakes = 16;
+    int tickMilliseconds = 100;
+    uint64_t seed = 1;
+};
+
+static constexpr uint32_t keyframeRetryTicks = 5; // ticks between keyframes to a client that has not acknowledged one
+static constexpr size_t deltaBudget = 1200;       // bytes of records per packet, beyond the first record
+
+/*
+ * Room class
+ * Objective: one arena plus what its clients need: the last historyTicks tick
+ *            records and the client index of every slot.
+ */
+class Room
+{
+public:
+    Arena arena;
+    SimRandom botRng;
+    uint32_t tick = 1; // 0 is reserved for "no keyframe yet" in client acks
+    int tickMilliseconds;
+    std::vector<int> slotClient; // per snake, the client driving it or -1 for a bot
+    std::vector<int> spectators; // clients watching a full room
+    size_t bytesSent = 0;
+
+    Room(const ServerOptions &options, uint64_t roomSeed)
+        : arena(options.board, options.snakes, options.snakes, roomSeed), botRng(roomSeed ^ 0x9e3779b9u),
+          tickMilliseconds(options.tickMilliseconds), slotClient(options.snakes, -1)
+    {
+        moves.resize(options.snakes);
+    }
+
+    void Tick(std::vector<RemoteClient> &clients, UdpSocket &socket);
+
+private:
+    void SendUpdate(RemoteClient &client, int slot, UdpSocket &socket);
+
+    std::vector<Cell> moves;
+    TickRecorder recorder;
+    std::vector<uint8_t> history[historyTicks]; // record of tick t at t % historyTicks
+    std::vector<uint8_t> packet;
+};
+
+/**
+ * Room::Tick
+ * ============================
+ * Objective:
+ *   Step the arena once and bring every client of the room up to date.
+ *
+ * Approach:
+ *   Client slots take the client's heading (the snake's own until its first
+ *   Input); bots pick theirs. The tick record is encoded once into the history
+ *   ring and shared by every client's packet.
+ */
+void Room::Tick(std::vector<RemoteClient> &clients, UdpSocket &socket)
+{
+    for (size_t i = 0; i < moves.size(); i++)
+    {
+        int c = slotClient[i];
+        if (c >= 0 && clients[c].hasDirection)
+            moves[i] = clients[c].direction;
+        else if (c >= 0)
+            moves[i] = arena.snakes[i].direction;
+        else
+            moves[i] = arena.BotDirection((int)i, botRng);
+    }
+    recorder.Capture(arena);
+    arena.Step(moves.data());
+    tick++;
+    recorder.Encode(tick, arena, moves.data(), history[tick % historyTicks]);
+
+    for (size_t i = 0; i < slotClient.size(); i++)
+        if (slotClient[i] >= 0)
+            SendUpdate(clients[slotClient[i]], (int)i, socket);
+    for (int c : spectators)
+        SendUpdate(clients[c], -1, socket);
+}
+
+/**
+ * Room::SendUpdate
+ * ============================
+ * Objective:
+ *   Send one client everything after its acknowledged tick.
+ *
+ * Approach:
+ *   Records (ack, tick] are still in the history while tick - ack < historyTicks;
+ *   they go out oldest first, as many as fit deltaBudget (always at least one).
+ *   Resending until acknowledged makes a lost packet cost nothing but the bytes.
+ *   Otherwise the client gets a keyframe, at most every keyframeRetryTicks.
+ */
+void Room::SendUpdate(RemoteClient &client, int slot, UdpSocket &socket)
+{
+    bool inHistory = client.ack > 0 && client.ack <= tick && tick - client.ack < historyTicks;
+    if (!inHistory)
+    {
+        if (client.keyframeTick != 0 && tick - client.keyframeTick < keyframeRetryTicks)
+            return;
+        EncodeKeyframe(arena, tick, tickMilliseconds, slot >= 0 ? (uint16_t)slot : netSpectator, packet);
+        client.keyframeTick = tick;
+    }
+    else
+    {
+        if (client.ack == tick)
+            return; // up to date
+        packet.clear();
+        PacketWriter out(packet);
+        out.Header(NetMessage::Delta);
+        out.U8(0);
+        int records = 0;
+        for (uint32_t t = client.ack + 1; t <= tick && records < 255; t++)
+        {
+            const std::vector<uint8_t> &record = history[t % historyTicks];
+            if (records > 0 && out.Size() + record.size() + 2 > deltaBudget)
+                break;
+            out.U16((uint16_t)record.size());
+            packet.insert(packet.end(), record.begin(), record.end());
+            records++;
+        }
+        packet[4] = (uint8_t)records;
+    }
+    socket.Send(client.address, packet.data(), packet.size());
+    bytesSent += packet.size();
+}
+
+/*
+ * Server class
+ * Objective: socket, rooms, clients and the fixed-tick loop.
+ */
+class Server
+{
+public:
+    Server(const ServerOptions &serverOptions, int maxRoomCount, unsigned int threads)
+        : options(serverOptions), maxRooms(maxRoomCount), pool(threads), buffer(UdpSocket::maxDatagram)
+    {
+    }
+
+    bool Open(uint16_t port) { return socket.Open(port); }
+    void AddRoom();
+    int Run(double seconds);
+
+private:
+    void Handle(const NetAddress &from, const uint8_t *data, size_t size, double now);
+    void Join(const NetAddress &from, int roomIndex, double now);
+    void Drop(int c);
+    static uint64_t Key(const NetAddress &address) { return ((uint64_t)address.ip << 16) | address.port; }
+
+    ServerOptions options;
+    int maxRooms;
+    ThreadPool pool;
+    UdpSocket socket;
+    std::vector<std::unique_ptr<Room>> rooms;
+    std::vector<RemoteClient> clients;           // inactive entries are reused
+    std::unordered_map<uint64_t, int> byAddress; // address key -> client index
+    std::vector<uint8_t> buffer;
+};
+
+void Server::AddRoom()
+{
+    rooms.emplace_back(new Room(options, options.seed + rooms.size()));
+}
+
+/**
+ * Server::Handle
+ * ============================
+ * Objective:
+ *   Apply one datagram to the client records.
+ */
+void Server::Handle(const NetAddress &from, const uint8_t *data, size_t size, double now)
+{
+    PacketReader reader(data, size);
+    NetMessage type;
+    if (!reader.Header(type))
+        return;
+    auto found = byAddress.find(Key(from));
+    int c = found == byAddress.end() ? -1 : found->second;
+    if (c >= 0)
+        clients[c].lastHeard = now;
+
+    if (type == NetMessage::Join)
+    {
+        int roomIndex = reader.U16();
+        if (reader.Ok() && c < 0)
+            Join(from, roomIndex, now);
+    }
+    else if (type == NetMessage::Input && c >= 0)
+    {
+        uint32_t sequence = reader.U32();
+        int code = reader.U8();
+        uint32_t ack = reader.U32();
+        if (!reader.Ok())
+            return;
+        RemoteClient &client = clients[c];
+        if (sequence > client.sequence && code < 4)
+        {
+            client.sequence = sequence;
+            client.direction = NetDirection(code);
+            client.hasDirection = true;
+        }
+        client.ack = ack; // taken as is: a client that dropped its buffer reports an older tick
+    }
+    else if (type == NetMessage::Leave && c >= 0)
+    {
+        Drop(c);
+    }
+}
+
+/**
+ * Server::Join
+ * ============================
+ * Objective:
+ *   Register a new client in `roomIndex`, creating the room if needed; it takes
+ *   the first bot slot, or spectates when every slot has a player.
+ */
+void Server::Join(const NetAddress &from, int roomIndex, double now)
+{
+    while ((int)rooms.size() <= roomIndex && (int)rooms.size() < maxRooms)
+        AddRoom();
+    if (roomIndex >= (int)rooms.size())
+        return; // beyond --max-rooms
+    Room &room = *rooms[roomIndex];
+
+    int c = 0;
+    while (c < (int)clients.size() && clients[c].active)
+        c++;
+    if (c == (int)clients.size())
+        clients.emplace_back();
+    RemoteClient &client = clients[c];
+    client = RemoteClient();
+    client.address = from;
+    client.room = roomIndex;
+    client.lastHeard = now;
+    client.active = true;
+    for (size_t i = 0; i < room.slotClient.size() && client.slot < 0; i++)
+        if (room.slotClient[i] < 0)
+            client.slot = (int)i;
+    if (client.slot >= 0)
+        room.slotClient[client.slot] = c;
+    else
+        room.spectators.push_back(c);
+    byAddress[Key(from)] = c;
+    printf("join room=%d slot=%d clients=%zu\n", roomIndex, client.slot, byAddress.size());
+}
+
+void Server::Drop(int c)
+{
+    RemoteClient &client = clients[c];
+    Room &room = *rooms[client.room];
+    if (client.slot >= 0)
+        room.slotClient[client.slot] = -1; // back to a bot
+    else
+        for (size_t i = 0; i < room.spectators.size(); i++)
+            if (room.spectators[i] == c)
+            {
+                room.spectators.erase(room.spectators.begin() + i);
+                break;
+            }
+    byAddress.erase(Key(client.address));
+    client.active = false;
+    printf("leave room=%d slot=%d clients=%zu\n", client.room, client.slot, byAddress.size());
+}
+
+/**
+ * Server::Run
+ * ============================
+ * Objective:
+ *   Fixed-tick loop; returns after `seconds` (0 = never).
+ *
+ * Approach:
+ *   Ticks are scheduled on absolute times, so a slow tick delays the next one but
+ *   the rate does not drift. Between ticks the thread sleeps in the socket wait.
+ *
+ * Variable definition and use:
+ *   next - time of the next tick; tickCost - seconds spent stepping since the last report
+ */
+int Server::Run(double seconds)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    auto elapsed = [&]() { return std::chrono::duration<double>(Clock::now() - start).count(); };
+    const double interval = options.tickMilliseconds / 1000.0;
+    const double timeout = 5.0;
+    double next = interval;
+    double nextReport = 5.0;
+    double tickCost = 0;
+    long long ticks = 0;
+    size_t bytesBefore = 0;
+
+    while (seconds <= 0 || elapsed() < seconds)
+    {
+        double now;
+        while ((now = elapsed()) < next)
+        {
+            socket.Wait((int)((next - now) * 1000) + 1);
+            NetAddress from;
+            int size;
+            while ((size = socket.Receive(from, buffer.data(), buffer.size())) >= 0)
+                Handle(from, buffer.data(), size, elapsed());
+        }
+        next += interval;
+
+        for (size_t c = 0; c < clients.size(); c++)
+            if (clients[c].active && now - clients[c].lastHeard > timeout)
+                Drop((int)c);
+
+        double before = elapsed();
+        pool.ParallelFor(rooms.size(), 1, [&](size_t begin, size_t end, unsigned int)
+        {
+            for (size_t r = begin; r < end; r++)
+                rooms[r]->Tick(clients, socket);
+        });
+        tickCost += elapsed() - before;
+        ticks++;
+
+        if (now >= nextReport)
+        {
+            size_t bytes = 0;
+            for (const std::unique_ptr<Room> &room : rooms)
+                bytes += room->bytesSent;
+            size_t clientCount = byAddress.size();
+            printf("rooms=%zu clients=%zu tick_ms=%.3f bytes_per_client_per_sec=%.0f\n", rooms.size(), clientCount,
+                   ticks ? tickCost * 1000 / ticks : 0.0,
+                   clientCount ? (double)(bytes - bytesBefore) / clientCount / 5.0 : 0.0);
+            fflush(stdout);
+            bytesBefore = bytes;
+            tickCost = 0;
+            ticks = 0;
+            nextReport += 5.0;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    ServerOptions options;
+    int port = netDefaultPort;
+    int startRooms = 0;
+    int maxRooms = 64;
+    unsigned int threads = 0;
+    double seconds = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--port") && i + 1 < argc)
+            port = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--board") && i + 1 < argc)
+            options.board = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--snakes") && i + 1 < argc)
+            options.snakes = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--rooms") && i + 1 < argc)
+            startRooms = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--max-rooms") && i + 1 < argc)
+            maxRooms = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--tick-ms") && i + 1 < argc)
+            options.tickMilliseconds = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+            threads = (unsigned int)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seconds") && i + 1 < argc)
+            seconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        else
+        {
+            fprintf(stderr, "usage: %s [--port N] [--board N] [--snakes N] [--rooms N] [--max-rooms N]\n"
+                            "       [--tick-ms N] [--threads N] [--seconds N] [--seed N]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (options.board < 5 || options.board > netMaxBoard || options.snakes < 1 || options.snakes > netMaxSnakes ||
+        options.tickMilliseconds < 1 || options.tickMilliseconds > 0xFFFF || port < 1 || port > 0xFFFF ||
+        maxRooms < 1 || maxRooms > 0xFFFF)
+    {
+        fprintf(stderr, "snake_server: option out of range (board 5..%d, snakes 1..%d)\n", netMaxBoard, netMaxSnakes);
+        return 1;
+    }
+
+    Server server(options, maxRooms, threads);
+    if (!server.Open((uint16_t)port))
+    {
+        fprintf(stderr, "snake_server: cannot bind UDP port %d\n", port);
+        return 1;
+    }
+    for (int r = 0; r < startRooms && r < maxRooms; r++)
+        server.AddRoom();
+    printf("snake_server port=%d board=%d snakes=%d tick_ms=%d\n", port, options.board, options.snakes,
+           options.tickMilliseconds);
+    fflush(stdout);
+    return server.Run(seconds);
+}